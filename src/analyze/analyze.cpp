@@ -110,6 +110,9 @@ std::shared_ptr<Query> Analyze::do_analyze(std::shared_ptr<ast::TreeNode> parse)
         if ((sm_manager_->db_).is_table(x->tab_name) == false) {
             throw TableNotFoundError(x->tab_name);
         }
+    } else if (auto x = std::dynamic_pointer_cast<ast::SetStmt>(parse)) {
+        // 设置项的值
+        query->values.push_back(convert_sv_value(x->val));
     } else {
         // do nothing
     }
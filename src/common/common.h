@@ -98,17 +98,17 @@ struct Value {
         }
     }
 
-    void load_raw(size_t len, char *data) {
+    void load_raw(size_t len, const char *data) {
         assert(raw == nullptr);
         if (type == TYPE_INT) {
             assert(len == sizeof(int));
-            int_val = *(int *)(data);
+            int_val = *(const int *)(data);
         } else if (type == TYPE_BIGINT) {
             assert(len == sizeof(int64_t));
-            bigint_val = *(int64_t *)(data);
+            bigint_val = *(const int64_t *)(data);
         } else if (type == TYPE_FLOAT) {
             assert(len == sizeof(float));
-            float_val = *(float *)(data);
+            float_val = *(const float *)(data);
         } else if (type == TYPE_DATETIME) {
             if (len < str_val.size()) {
                 throw StringOverflowError();
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 #include <string>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 
 #define BUFFER_LENGTH 8192
@@ -32,10 +33,25 @@ static constexpr int INVALID_TXN_ID = -1;                                     //
 static constexpr int INVALID_TIMESTAMP = -1;                                  // invalid transaction timestamp
 static constexpr int INVALID_LSN = -1;                                        // invalid log sequence number
 static constexpr int HEADER_PAGE_ID = 0;                                      // the header page id
-static constexpr int PAGE_SIZE = 4096;                                        // size of a data page in byte  4KB
+static constexpr int DEFAULT_PAGE_SIZE = 4096;                                // default size of a data page in byte  4KB
+static constexpr int MIN_PAGE_SIZE = 4096;
+static constexpr int MAX_PAGE_SIZE = 32768;                                   // 栈上的页面缓冲区按MAX_PAGE_SIZE分配
+// 当前数据库的页面大小，create_db时选定并保存在db.meta中，open_db时由BufferPoolManager::set_page_size设置
+inline int PAGE_SIZE = DEFAULT_PAGE_SIZE;
 static constexpr int BUFFER_POOL_SIZE = 65536;                                // size of buffer pool 256MB
 // static constexpr int BUFFER_POOL_SIZE = 1048576;                                // size of buffer pool 1GB
-static constexpr int LOG_BUFFER_SIZE = (1024 * PAGE_SIZE);                    // size of a log buffer in byte
+// 以上为默认帧数，启动时可由rmdb --buffer-pool-size指定缓冲池大小，运行时可由SET buffer_pool_size（MB）修改
+static constexpr int BUFFER_POOL_RESIZE_TIMEOUT_MS = 10000;                   // 调整缓冲池大小时等待所有页面取消固定的最长时间
+static constexpr size_t BUFFER_POOL_NUM_SHARDS = 16;                          // 缓冲池分片个数的上限
+static constexpr size_t BUFFER_POOL_MIN_SHARD_SIZE = 1024;                    // 每个分片至少拥有的帧数，帧数较少的缓冲池分片较少
+static constexpr size_t BUFFER_POOL_MAX_PINNED_PCT = 50;                       // buffer_priority为pinned的页面最多占分片帧数的百分比
+static constexpr size_t BUFFER_POOL_HUGE_PAGE_SIZE = 2 * 1024 * 1024;         // 帧内存按大页大小对齐和分配，以便使用大页
+static constexpr size_t BUFFER_RING_BULK_READ_SIZE = 256 * 1024;              // 大表顺序扫描（包括CREATE INDEX）使用的环形缓冲区大小
+static constexpr size_t BUFFER_RING_BULK_WRITE_SIZE = 16 * 1024 * 1024;       // LOAD使用的环形缓冲区大小
+static constexpr size_t BUFFER_RING_SCAN_THRESHOLD = 4;                       // 表的页面数超过缓冲池帧数的1/4时顺序扫描使用环形缓冲区
+static constexpr int READ_AHEAD_MIN_PAGES = 4;                                // 检测到顺序访问后第一次预读的页面数，之后每次翻倍
+static constexpr int READ_AHEAD_MAX_PAGES = 32;                               // 预读窗口的默认上限，运行时可由SET read_ahead_max_pages修改
+static constexpr int LOG_BUFFER_SIZE = (1024 * DEFAULT_PAGE_SIZE);            // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
 
 using frame_id_t = int32_t;  // frame id type, 帧页ID, 页在BufferPool中的存储单元称为帧,一帧对应一页
@@ -49,8 +65,36 @@ using timestamp_t = int32_t;  // timestamp type, used for transaction concurrenc
 // log file
 static const std::string LOG_FILE_NAME = "db.log";
 
-// replacer
-static const std::string REPLACER_TYPE = "LRU";
+// replacer, "CLOCK", "LRU" or "LRU-K"(也可写作"LRU-2"、"LRU-3"等指定K), 启动时可由rmdb --replacer选择
+static const std::string REPLACER_TYPE = "CLOCK";
+static constexpr uint8_t CLOCK_MAX_USAGE_COUNT = 5;                             // CLOCK-sweep中帧的使用计数上限
+static constexpr size_t LRUK_DEFAULT_K = 2;                                     // LRU-K中的K
+static constexpr uint64_t LRUK_CORRELATED_PERIOD = 16;                          // LRU-K的相关访问期，以分片内的访问次数计
+
+// 后台写回线程的默认参数，运行时可由SET bgwriter_delay = ...等语句修改
+static constexpr int BGWRITER_DELAY_MS = 200;                                   // 两轮写回之间的间隔（毫秒）
+static constexpr int BGWRITER_MAX_PAGES = 100;                                  // 每轮最多写回的页面数，为0时不写回
+static constexpr int BGWRITER_LOW_WATERMARK = 5;                                // 干净帧和空闲帧低于分片帧数的该百分比时开始写回
+static constexpr int BGWRITER_HIGH_WATERMARK = 10;                              // 写回直到干净帧和空闲帧达到分片帧数的该百分比
+
+// 缓冲池预热：close_db时以及后台写回线程每隔BUFFER_POOL_DUMP_INTERVAL_S秒将驻留页面的(文件名, 页号)列表
+// 写入数据库目录下的BUFFER_POOL_DUMP_NAME，open_db后由后台线程按(文件, 页号)顺序批量读回这些页面
+static const std::string BUFFER_POOL_DUMP_NAME = "buffer_pool.dump";
+static constexpr int BUFFER_POOL_DUMP_INTERVAL_S = 300;
+
+// io engine, "IO_URING" or "SYNC", io_uring不可用时自动回退为同步引擎
+static const std::string IO_ENGINE_TYPE = "IO_URING";
+static constexpr unsigned IO_ENGINE_QUEUE_DEPTH = 64;                           // io_uring最多同时在途的请求数
+
+// 表文件和索引文件按FILE_EXTEND_SIZE字节为单位用fallocate预分配空间，设为0则不预分配
+static constexpr size_t FILE_EXTEND_SIZE = 1024 * 1024;
+
+// 表空间模式下所有表文件和索引文件存放在段文件"tablespace.0"、"tablespace.1"...中，
+// 每个段文件最大TABLESPACE_SEGMENT_SIZE字节，按TABLESPACE_EXTENT_SIZE字节的区分配给各个文件
+static constexpr long TABLESPACE_EXTENT_SIZE = 1024 * 1024;
+static constexpr long TABLESPACE_SEGMENT_SIZE = 1024L * 1024 * 1024;
+static const std::string TABLESPACE_DIR_NAME = "tablespace.dir";
+static const std::string TABLESPACE_SEGMENT_PREFIX = "tablespace.";
 
 static const std::string DB_META_NAME = "db.meta";
 
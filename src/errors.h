@@ -98,6 +98,17 @@ class DatabaseExistsError : public RMDBError {
     DatabaseExistsError(const std::string &db_name) : RMDBError("Database already exists: " + db_name) {}
 };
 
+class InvalidPageSizeError : public RMDBError {
+   public:
+    InvalidPageSizeError(int page_size) : RMDBError("Invalid page size: " + std::to_string(page_size)) {}
+};
+
+class DatabaseModeMismatchError : public RMDBError {
+   public:
+    DatabaseModeMismatchError(const std::string &db_name, const std::string &mode)
+        : RMDBError("Database " + db_name + " was not created with " + mode) {}
+};
+
 class TableNotFoundError : public RMDBError {
    public:
     TableNotFoundError(const std::string &tab_name) : RMDBError("Table not found: " + tab_name) {}
@@ -169,4 +180,24 @@ class InvalidTypeError : public RMDBError {
    public:
     InvalidTypeError()
         : RMDBError("type not exits!") {}
+};
+class SettingNotFoundError : public RMDBError {
+   public:
+    SettingNotFoundError(const std::string &name) : RMDBError("Unrecognized setting: " + name) {}
+};
+
+class InvalidSettingValueError : public RMDBError {
+   public:
+    InvalidSettingValueError(const std::string &name, const std::string &value)
+        : RMDBError("Invalid value for setting " + name + ": " + value) {}
+};
+
+class ReadOnlySettingError : public RMDBError {
+   public:
+    ReadOnlySettingError(const std::string &name) : RMDBError("Setting is read-only: " + name) {}
+};
+
+class BufferPoolBusyError : public RMDBError {
+   public:
+    BufferPoolBusyError() : RMDBError("Buffer pool is busy: pages are still pinned, try again later") {}
 };
\ No newline at end of file
@@ -32,10 +32,14 @@ const char *help_info = "Supported SQL syntax:\n"
                    "  DROP TABLE table_name\n"
                    "  CREATE INDEX table_name (column_name)\n"
                    "  DROP INDEX table_name (column_name)\n"
+                   "  ALTER TABLE table_name SET (option = value [, option = value ...])\n"
+                   "  ALTER INDEX table_name (column_name) SET (option = value [, option = value ...])\n"
                    "  INSERT INTO table_name VALUES (value [, value ...])\n"
                    "  DELETE FROM table_name [WHERE where_clause]\n"
                    "  UPDATE table_name SET column_name = value [, column_name = value ...] [WHERE where_clause]\n"
                    "  SELECT selector FROM table_name [WHERE where_clause]\n"
+                   "  SET setting_name = value\n"
+                   "  SHOW setting_name\n"
                    "type:\n"
                    "  {INT | FLOAT | CHAR(n)}\n"
                    "where_clause:\n"
@@ -73,6 +77,12 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
                 sm_manager_->drop_index(x->tab_name_, x->tab_col_names_, context);
                 break;
             }
+            case T_AlterBufferPolicy:
+            {
+                auto alter_plan = std::dynamic_pointer_cast<AlterBufferPolicyPlan>(x);
+                sm_manager_->set_buffer_policy(x->tab_name_, x->tab_col_names_, alter_plan->options_);
+                break;
+            }
             default:
                 throw InternalError("Unexpected field type");
                 break;  
@@ -105,6 +115,17 @@ void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Co
                 sm_manager_->desc_table(x->tab_name_, context);
                 break;
             }
+            case T_SetSetting:
+            {
+                auto set_plan = std::dynamic_pointer_cast<SetSettingPlan>(x);
+                sm_manager_->set_setting(set_plan->tab_name_, set_plan->value_);
+                break;
+            }
+            case T_ShowSetting:
+            {
+                sm_manager_->show_setting(x->tab_name_, context);
+                break;
+            }
             case T_Transaction_begin:
             {
                 // 显示开启一个事务
@@ -491,6 +512,8 @@ void QlManager::load_csv(std::shared_ptr<LoadPlan> plan, Context *context) {
         throw InternalError("The CSV header mismatches table header.");
     }
 
+    // 写入的表页面只在环形缓冲区中复用，索引页面仍使用整个缓冲池
+    BufferAccessStrategy strategy(BUFFER_RING_BULK_WRITE_SIZE);
     std::string line;
     while (std::getline(csv_file, line)) {
         auto line_tok = Token(line);
@@ -512,6 +535,6 @@ void QlManager::load_csv(std::shared_ptr<LoadPlan> plan, Context *context) {
             values.push_back(std::move(val));
         }
 
-        InsertExecutor(sm_manager_, tab_name, std::move(values), context).Next();
+        InsertExecutor(sm_manager_, tab_name, std::move(values), context, &strategy).Next();
     }
 }
\ No newline at end of file
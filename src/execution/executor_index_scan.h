@@ -36,6 +36,7 @@ class IndexScanExecutor : public AbstractExecutor {
 
     Rid rid_;
     std::unique_ptr<RecScan> scan_;
+    RecordRef cur_;                     // 当前记录的只读视图，持有所在页面的pin，同一页面上的记录复用该pin
 
     SmManager *sm_manager_;
     
@@ -45,11 +46,8 @@ class IndexScanExecutor : public AbstractExecutor {
     };
 
     bool _checkConds() {
-        return executor_utils::checkConds(
-            fh_->get_record(scan_->rid(), context_),
-            conds_,
-            cols_
-        );
+        fh_->get_record_ref(scan_->rid(), context_, cur_);
+        return executor_utils::checkConds(cur_.data(), conds_, cols_);
     }
 
     // 确定初始范围
@@ -214,6 +212,7 @@ class IndexScanExecutor : public AbstractExecutor {
             }
             scan_->next();
         }
+        cur_.reset();
         
     }
 
@@ -224,10 +223,14 @@ class IndexScanExecutor : public AbstractExecutor {
             rid_ = scan_->rid();
             return;
         }
+        cur_.reset();
     }
 
     std::unique_ptr<RmRecord> Next() override {
         assert(!is_end());
+        // cur_指向rid_，记录离开算子时才复制
+        if (cur_.valid())
+            return cur_.to_record();
         return fh_->get_record(rid_,context_);
     }
 
@@ -23,10 +23,13 @@ class InsertExecutor : public AbstractExecutor {
     std::string tab_name_;          // 表名称
     Rid rid_;                       // 插入的位置，由于系统默认插入时不指定位置，因此当前rid_在插入后才赋值
     SmManager *sm_manager_;
+    BufferAccessStrategy *strategy_;    // 批量插入时使用的缓冲池访问策略，为nullptr时使用整个缓冲池
 
    public:
-    InsertExecutor(SmManager *sm_manager, const std::string &tab_name, std::vector<Value> values, Context *context) {
+    InsertExecutor(SmManager *sm_manager, const std::string &tab_name, std::vector<Value> values, Context *context,
+                   BufferAccessStrategy *strategy = nullptr) {
         sm_manager_ = sm_manager;
+        strategy_ = strategy;
         tab_ = sm_manager_->db_.get_table(tab_name);
         values_ = values;
         tab_name_ = tab_name;
@@ -70,7 +73,7 @@ class InsertExecutor : public AbstractExecutor {
         }
 
         // Insert into record file
-        rid_ = fh_->insert_record(rec.data, context_);
+        rid_ = fh_->insert_record(rec.data, context_, strategy_);
 
         // 日志落盘
         auto insert_log_record = InsertLogRecord(context_->txn_->get_transaction_id(), rec, rid_, tab_name_);
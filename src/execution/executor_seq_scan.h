@@ -28,16 +28,24 @@ class SeqScanExecutor : public AbstractExecutor {
     std::vector<Condition> fed_conds_;  // 同conds_，两个字段相同
 
     Rid rid_;
-    std::unique_ptr<RecScan> scan_;     // table_iterator
+    std::unique_ptr<RmScan> scan_;      // table_iterator，按页面批量扫描
+    size_t pos_ = 0;                    // 当前记录在scan_当前页面的slots()中的下标
 
     SmManager *sm_manager_;
 
-    bool _checkConds() {
-        return executor_utils::checkConds(
-            fh_->get_record(scan_->rid(), context_),
-            conds_,
-            cols_
-        );
+    // 从pos_起找到下一条满足条件的记录，条件直接在scan_ pin住的页面上判断，当前页面读完后再进入下一页
+    void _seekMatch() {
+        for (; !scan_->is_end(); scan_->next_page(), pos_ = 0) {
+            const auto &slots = scan_->slots();
+            for (; pos_ < slots.size(); pos_++) {
+                Rid rid{.page_no = scan_->page_no(), .slot_no = slots[pos_]};
+                context_->lock_mgr_->lock_shared_on_record(context_->txn_, rid, fh_->GetFd());
+                if (executor_utils::checkConds(scan_->get_record(rid.slot_no), conds_, cols_)) {
+                    rid_ = rid;
+                    return;
+                }
+            }
+        }
     }
 
    public:
@@ -59,26 +67,18 @@ class SeqScanExecutor : public AbstractExecutor {
     void beginTuple() override {
         
         scan_ = std::make_unique<RmScan>(fh_);
-        while (!scan_->is_end()) {
-            if (_checkConds()) {
-                rid_ = scan_->rid();
-                return;
-            }
-            scan_->next();
-        }
+        pos_ = 0;
+        _seekMatch();
     }
 
     void nextTuple() override {
-        while (scan_->next(), !scan_->is_end()) {
-            if (!_checkConds())
-                continue;
-            rid_ = scan_->rid();
-            return;
-        }
+        pos_++;
+        _seekMatch();
     }
 
     std::unique_ptr<RmRecord> Next() override {
-        return fh_->get_record(rid_, context_);
+        // rid_所在的页面仍由scan_ pin住，记录离开算子时才复制
+        return std::make_unique<RmRecord>(fh_->get_file_hdr().record_size, scan_->get_record(rid_.slot_no));
     }
 
     bool is_end() const override { return scan_->is_end(); }
@@ -8,7 +8,8 @@
 
 namespace executor_utils {
 
-inline bool checkConds(const std::unique_ptr<RmRecord> record, const std::vector<Condition> &conds, const std::vector<ColMeta> &cols) {
+// 直接在记录数据（可以是缓冲池页面中的slot）上判断条件，不复制记录
+inline bool checkConds(const char *data, const std::vector<Condition> &conds, const std::vector<ColMeta> &cols) {
     for (const auto &cond : conds) {
         const auto &lcol = *std::find_if(
             cols.begin(),
@@ -18,7 +19,7 @@ inline bool checkConds(const std::unique_ptr<RmRecord> record, const std::vector
         // 从记录中读取左值
         Value lval;
         lval.type = lcol.type;
-        lval.load_raw(lcol.len, record->data + lcol.offset);
+        lval.load_raw(lcol.len, data + lcol.offset);
         // 准备右值
         Value rval;
         if (cond.is_rhs_val) {
@@ -32,7 +33,7 @@ inline bool checkConds(const std::unique_ptr<RmRecord> record, const std::vector
                 [&] (const auto &col) { return cond.rhs_col.col_name == col.name && cond.rhs_col.tab_name == col.tab_name; }
             );
             rval.type = rcol.type;
-            rval.load_raw(rcol.len, record->data + rcol.offset);
+            rval.load_raw(rcol.len, data + rcol.offset);
         }
         // 二元检定
         if (!binop(cond.op, lval, rval))
@@ -42,4 +43,8 @@ inline bool checkConds(const std::unique_ptr<RmRecord> record, const std::vector
     return true;
 }
 
+inline bool checkConds(const std::unique_ptr<RmRecord> &record, const std::vector<Condition> &conds, const std::vector<ColMeta> &cols) {
+    return checkConds(record->data, conds, cols);
+}
+
 } // end of namespace executor_utils
\ No newline at end of file
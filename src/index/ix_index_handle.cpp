@@ -613,6 +613,7 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
         delete_set->clear();
     }
     delete leaf_node;
+    free_released_pages();
 
 
     return false;
@@ -981,11 +982,12 @@ IxNodeHandle *IxIndexHandle::fetch_node(int page_no) const {
  */
 IxNodeHandle *IxIndexHandle::create_node() {
     IxNodeHandle *node;
-    file_hdr_->num_pages_++;
 
     PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
-    // 从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
+    // 优先重用空闲页表中已释放的页面，否则从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
     Page *page = buffer_pool_manager_->new_page(&new_page_id);
+    // num_pages_是文件中页号的上界，重新打开索引时从此处继续分配，因此重用页面时不变
+    file_hdr_->num_pages_ = std::max(file_hdr_->num_pages_, new_page_id.page_no + 1);
     node = new IxNodeHandle(file_hdr_, page);
     node->page_hdr->num_key = 0;
     return node;
@@ -1034,12 +1036,38 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
 }
 
 /**
- * @brief 删除node时，更新file_hdr_.num_pages
+ * @brief 删除node时，记录其页号，待其被unpin后由free_released_pages()放入空闲页表
+ * 不再减少file_hdr_.num_pages，否则重新打开索引后新分配的页号会与仍在使用的页面重复
  *
  * @param node
  */
 void IxIndexHandle::release_node_handle(IxNodeHandle &node) {
-    file_hdr_->num_pages_--;
+    std::scoped_lock lock{released_pages_latch_};
+    released_pages_.push_back(node.get_page_no());
+}
+
+/**
+ * @brief 将release_node_handle()记录的页面从缓冲池中删除并交给DiskManager的空闲页表
+ * 仍被其他线程pin住的页面无法删除，留在待回收列表中，下次调用时再尝试
+ */
+void IxIndexHandle::free_released_pages() {
+    std::vector<page_id_t> released;
+    {
+        std::scoped_lock lock{released_pages_latch_};
+        released.swap(released_pages_);
+    }
+    std::vector<page_id_t> pinned;
+    for (page_id_t page_no : released) {
+        if (buffer_pool_manager_->delete_page(PageId{fd_, page_no})) {
+            disk_manager_->deallocate_page(fd_, page_no);
+        } else {
+            pinned.push_back(page_no);
+        }
+    }
+    if (!pinned.empty()) {
+        std::scoped_lock lock{released_pages_latch_};
+        released_pages_.insert(released_pages_.end(), pinned.begin(), pinned.end());
+    }
 }
 
 /**
@@ -175,10 +175,14 @@ class IxIndexHandle {
     int fd_;                                    // 存储B+树的文件
     IxFileHdr* file_hdr_;                       // 存了root_page，但其初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
     std::mutex mutable root_latch_;
+    std::vector<page_id_t> released_pages_;     // 已删除结点的页号，等待放入空闲页表
+    std::mutex released_pages_latch_;           // 保护released_pages_
 
    public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
 
+    const IxFileHdr *get_file_hdr() const { return file_hdr_; }
+
     // for search
     bool get_value(const char *key, std::vector<Rid> *result, Transaction *transaction);
 
@@ -241,6 +245,8 @@ class IxIndexHandle {
 
     void release_node_handle(IxNodeHandle &node);
 
+    void free_released_pages();
+
     void maintain_child(IxNodeHandle *node, int child_idx);
 
     // for index test
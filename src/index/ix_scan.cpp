@@ -21,6 +21,12 @@ void IxScan::next() {
     node->page->RLock();
     assert(node->is_leaf_page());
     assert(iid_.slot_no < node->get_size());
+    // 叶子结点的页号不连续，沿叶子链表在扫描当前叶子时异步预读下一个叶子
+    if (iid_.page_no != ih_->file_hdr_->last_leaf_ && iid_.page_no != end_.page_no &&
+        node->get_next_leaf() != prefetched_leaf_) {
+        prefetched_leaf_ = node->get_next_leaf();
+        bpm_->prefetch_pages(ih_->fd_, {prefetched_leaf_});
+    }
     // increment slot no
     iid_.slot_no++;
     if (iid_.page_no != ih_->file_hdr_->last_leaf_ && iid_.slot_no == node->get_size()) {
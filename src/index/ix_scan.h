@@ -23,6 +23,7 @@ class IxScan : public RecScan {
     Iid iid_;  // 初始为lower（用于遍历的指针）
     Iid end_;  // 初始为upper
     BufferPoolManager *bpm_;
+    page_id_t prefetched_leaf_ = INVALID_PAGE_ID;  // 最近一次预读的叶子结点
 
    public:
     IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm)
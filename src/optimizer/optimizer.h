@@ -41,6 +41,12 @@ class Optimizer {
         } else if (auto x = std::dynamic_pointer_cast<ast::ShowIndex>(query->parse)) {
             // show index;
             return std::make_shared<OtherPlan>(T_ShowIndex, x->tab_name);
+        } else if (auto x = std::dynamic_pointer_cast<ast::SetStmt>(query->parse)) {
+            // set name = value;
+            return std::make_shared<SetSettingPlan>(x->name, query->values.front());
+        } else if (auto x = std::dynamic_pointer_cast<ast::ShowSetting>(query->parse)) {
+            // show name;
+            return std::make_shared<OtherPlan>(T_ShowSetting, x->name);
         } else if (auto x = std::dynamic_pointer_cast<ast::DescTable>(query->parse)) {
             // desc table;
             return std::make_shared<OtherPlan>(T_DescTable, x->tab_name);
@@ -29,6 +29,7 @@ typedef enum PlanTag{
     T_DropTable,
     T_CreateIndex,
     T_DropIndex,
+    T_AlterBufferPolicy,
     T_Insert,
     T_Load,
     T_Update,
@@ -42,6 +43,8 @@ typedef enum PlanTag{
     T_Transaction_commit,
     T_Transaction_abort,
     T_Transaction_rollback,
+    T_SetSetting,
+    T_ShowSetting,
     T_SeqScan,
     T_IndexScan,
     T_NestLoop,
@@ -195,6 +198,20 @@ class DDLPlan : public Plan
         std::vector<ColDef> cols_;
 };
 
+// alter table/index ... set (...)语句对应的plan，tab_col_names_为空时设置表的缓冲池策略
+class AlterBufferPolicyPlan : public DDLPlan
+{
+    public:
+        AlterBufferPolicyPlan(std::string tab_name, std::vector<std::string> col_names,
+                              std::vector<std::pair<std::string, std::string>> options)
+            : DDLPlan(T_AlterBufferPolicy, std::move(tab_name), std::move(col_names), std::vector<ColDef>())
+        {
+            options_ = std::move(options);
+        }
+        ~AlterBufferPolicyPlan(){}
+        std::vector<std::pair<std::string, std::string>> options_;     // 选项名和选项值
+};
+
 // help; show tables; desc tables; begin; abort; commit; rollback语句对应的plan
 class OtherPlan : public Plan
 {
@@ -205,7 +222,19 @@ class OtherPlan : public Plan
             tab_name_ = std::move(tab_name);            
         }
         ~OtherPlan(){}
-        std::string tab_name_;
+        std::string tab_name_;      // 对于set/show设置项的语句为设置项的名称
+};
+
+// set name = value语句对应的plan
+class SetSettingPlan : public OtherPlan
+{
+    public:
+        SetSettingPlan(std::string name, Value value) : OtherPlan(T_SetSetting, std::move(name))
+        {
+            value_ = std::move(value);
+        }
+        ~SetSettingPlan(){}
+        Value value_;
 };
 
 class plannerInfo{
@@ -424,7 +424,8 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
             if (auto sv_col_def = std::dynamic_pointer_cast<ast::ColDef>(field)) {
                 ColDef col_def = {.name = sv_col_def->col_name,
                                   .type = interp_sv_type(sv_col_def->type_len->type),
-                                  .len = sv_col_def->type_len->len};
+                                  .len = sv_col_def->type_len->len,
+                                  .is_varchar = sv_col_def->type_len->is_varchar};
                 col_defs.push_back(col_def);
             } else {
                 throw InternalError("Unexpected field type");
@@ -440,6 +441,19 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
     } else if (auto x = std::dynamic_pointer_cast<ast::DropIndex>(query->parse)) {
         // drop index
         plannerRoot = std::make_shared<DDLPlan>(T_DropIndex, x->tab_name, x->col_names, std::vector<ColDef>());
+    } else if (auto x = std::dynamic_pointer_cast<ast::AlterBufferPolicy>(query->parse)) {
+        // alter table/index ... set (...);
+        std::vector<std::pair<std::string, std::string>> options;
+        for (auto &option : x->options) {
+            if (auto int_lit = std::dynamic_pointer_cast<ast::IntLit>(option->val)) {
+                options.emplace_back(option->col_name, std::to_string(int_lit->val));
+            } else if (auto str_lit = std::dynamic_pointer_cast<ast::StringLit>(option->val)) {
+                options.emplace_back(option->col_name, str_lit->val);
+            } else {
+                throw InvalidSettingValueError(option->col_name, "non-integer value");
+            }
+        }
+        plannerRoot = std::make_shared<AlterBufferPolicyPlan>(x->tab_name, x->col_names, std::move(options));
     } else if (auto x = std::dynamic_pointer_cast<ast::InsertStmt>(query->parse)) {
         // insert;
         plannerRoot = std::make_shared<DMLPlan>(T_Insert, std::shared_ptr<Plan>(),  x->tab_name,  
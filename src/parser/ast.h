@@ -65,8 +65,9 @@ struct TxnRollback : public TreeNode {
 struct TypeLen : public TreeNode {
     SvType type;
     int len;
+    bool is_varchar;    // VARCHAR(n)：与CHAR(n)类型相同，在表文件中只保存实际长度的内容
 
-    TypeLen(SvType type_, int len_) : type(type_), len(len_) {}
+    TypeLen(SvType type_, int len_, bool is_varchar_ = false) : type(type_), len(len_), is_varchar(is_varchar_) {}
 };
 
 struct Field : public TreeNode {
@@ -192,6 +193,30 @@ struct OrderBy : public TreeNode
        col(std::move(col_)), orderby_dir(orderby_dir_) {}
 };
 
+struct SetStmt : public TreeNode {
+    std::string name;
+    std::shared_ptr<Value> val;
+
+    SetStmt(std::string name_, std::shared_ptr<Value> val_) : name(std::move(name_)), val(std::move(val_)) {}
+};
+
+// ALTER TABLE tab_name SET (...)或ALTER INDEX tab_name (col_names) SET (...)，设置表或索引的缓冲池策略
+struct AlterBufferPolicy : public TreeNode {
+    std::string tab_name;
+    std::vector<std::string> col_names;     // 为空时设置表的策略
+    std::vector<std::shared_ptr<SetClause>> options;
+
+    AlterBufferPolicy(std::string tab_name_, std::vector<std::string> col_names_,
+                      std::vector<std::shared_ptr<SetClause>> options_) :
+            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)), options(std::move(options_)) {}
+};
+
+struct ShowSetting : public TreeNode {
+    std::string name;
+
+    ShowSetting(std::string name_) : name(std::move(name_)) {}
+};
+
 struct LoadStmt : public TreeNode {
     std::string path, tab_name;
 
@@ -71,6 +71,8 @@
 
 #include "ast.h"
 #include "yacc.tab.h"
+#include <strings.h>
+
 #include <iostream>
 #include <memory>
 
@@ -82,7 +84,7 @@ void yyerror(YYLTYPE *locp, const char* s) {
 
 using namespace ast;
 
-#line 86 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 88 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -164,11 +166,11 @@ enum yysymbol_kind_t
   YYSYMBOL_VALUE_FLOAT = 51,               /* VALUE_FLOAT  */
   YYSYMBOL_VALUE_DATETIME = 52,            /* VALUE_DATETIME  */
   YYSYMBOL_53_ = 53,                       /* ';'  */
-  YYSYMBOL_54_ = 54,                       /* '('  */
-  YYSYMBOL_55_ = 55,                       /* ')'  */
-  YYSYMBOL_56_ = 56,                       /* ','  */
-  YYSYMBOL_57_ = 57,                       /* '.'  */
-  YYSYMBOL_58_ = 58,                       /* '='  */
+  YYSYMBOL_54_ = 54,                       /* '='  */
+  YYSYMBOL_55_ = 55,                       /* '('  */
+  YYSYMBOL_56_ = 56,                       /* ')'  */
+  YYSYMBOL_57_ = 57,                       /* ','  */
+  YYSYMBOL_58_ = 58,                       /* '.'  */
   YYSYMBOL_59_ = 59,                       /* '<'  */
   YYSYMBOL_60_ = 60,                       /* '>'  */
   YYSYMBOL_61_ = 61,                       /* '*'  */
@@ -196,17 +198,19 @@ enum yysymbol_kind_t
   YYSYMBOL_expr = 83,                      /* expr  */
   YYSYMBOL_setClauses = 84,                /* setClauses  */
   YYSYMBOL_setClause = 85,                 /* setClause  */
-  YYSYMBOL_selector = 86,                  /* selector  */
-  YYSYMBOL_tableList = 87,                 /* tableList  */
-  YYSYMBOL_opt_order_clause = 88,          /* opt_order_clause  */
-  YYSYMBOL_opt_limit = 89,                 /* opt_limit  */
-  YYSYMBOL_order_clause_list = 90,         /* order_clause_list  */
-  YYSYMBOL_order_clause = 91,              /* order_clause  */
-  YYSYMBOL_opt_asc_desc = 92,              /* opt_asc_desc  */
-  YYSYMBOL_tbName = 93,                    /* tbName  */
-  YYSYMBOL_colName = 94,                   /* colName  */
-  YYSYMBOL_path = 95,                      /* path  */
-  YYSYMBOL_filename = 96                   /* filename  */
+  YYSYMBOL_optionList = 86,                /* optionList  */
+  YYSYMBOL_option = 87,                    /* option  */
+  YYSYMBOL_selector = 88,                  /* selector  */
+  YYSYMBOL_tableList = 89,                 /* tableList  */
+  YYSYMBOL_opt_order_clause = 90,          /* opt_order_clause  */
+  YYSYMBOL_opt_limit = 91,                 /* opt_limit  */
+  YYSYMBOL_order_clause_list = 92,         /* order_clause_list  */
+  YYSYMBOL_order_clause = 93,              /* order_clause  */
+  YYSYMBOL_opt_asc_desc = 94,              /* opt_asc_desc  */
+  YYSYMBOL_tbName = 95,                    /* tbName  */
+  YYSYMBOL_colName = 96,                   /* colName  */
+  YYSYMBOL_path = 97,                      /* path  */
+  YYSYMBOL_filename = 98                   /* filename  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -535,18 +539,18 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  50
+#define YYFINAL  56
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   162
+#define YYLAST   200
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  63
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  34
+#define YYNNTS  36
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  91
+#define YYNRULES  100
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  171
+#define YYNSTATES  203
 
 /* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   307
@@ -567,9 +571,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      54,    55,    61,     2,    56,     2,    57,    62,     2,     2,
+      55,    56,    61,     2,    57,     2,    58,    62,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,    53,
-      59,    58,    60,     2,     2,     2,     2,     2,     2,     2,
+      59,    54,    60,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -600,16 +604,17 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    63,    63,    68,    73,    78,    86,    87,    88,    89,
-      93,    97,   101,   105,   112,   116,   123,   127,   131,   135,
-     139,   146,   150,   154,   158,   162,   166,   173,   177,   181,
-     185,   192,   196,   203,   207,   214,   221,   225,   229,   233,
-     237,   244,   248,   255,   259,   263,   267,   271,   278,   285,
-     286,   293,   297,   304,   308,   315,   319,   326,   330,   334,
-     338,   342,   346,   353,   357,   364,   368,   375,   379,   386,
-     390,   394,   398,   402,   409,   413,   417,   422,   428,   432,
-     439,   446,   447,   448,   451,   452,   455,   459,   463,   467,
-     471,   477
+       0,    66,    66,    71,    76,    81,    89,    90,    91,    92,
+      96,   100,   104,   108,   115,   119,   123,   127,   134,   138,
+     142,   146,   150,   155,   163,   174,   178,   182,   186,   190,
+     194,   201,   205,   209,   213,   220,   224,   231,   235,   242,
+     249,   253,   257,   262,   270,   274,   281,   285,   292,   296,
+     300,   304,   308,   315,   322,   323,   330,   334,   341,   345,
+     352,   356,   363,   367,   371,   375,   379,   383,   390,   394,
+     401,   405,   412,   416,   423,   427,   434,   438,   445,   449,
+     453,   457,   461,   468,   472,   476,   481,   487,   491,   498,
+     505,   506,   507,   510,   511,   514,   518,   522,   526,   530,
+     536
 };
 #endif
 
@@ -632,14 +637,14 @@ static const char *const yytname[] =
   "JOIN", "EXIT", "HELP", "TXN_BEGIN", "TXN_COMMIT", "TXN_ABORT",
   "TXN_ROLLBACK", "ORDER_BY", "COUNT", "MAX", "MIN", "SUM", "AS", "LEQ",
   "NEQ", "GEQ", "T_EOF", "IDENTIFIER", "VALUE_STRING", "VALUE_INT",
-  "VALUE_BIGINT", "VALUE_FLOAT", "VALUE_DATETIME", "';'", "'('", "')'",
-  "','", "'.'", "'='", "'<'", "'>'", "'*'", "'/'", "$accept", "start",
+  "VALUE_BIGINT", "VALUE_FLOAT", "VALUE_DATETIME", "';'", "'='", "'('",
+  "')'", "','", "'.'", "'<'", "'>'", "'*'", "'/'", "$accept", "start",
   "stmt", "txnStmt", "dbStmt", "ddl", "dml", "aggregate_function",
   "fieldList", "colNameList", "field", "type", "valueList", "value",
   "condition", "optWhereClause", "whereClause", "col", "colList", "op",
-  "expr", "setClauses", "setClause", "selector", "tableList",
-  "opt_order_clause", "opt_limit", "order_clause_list", "order_clause",
-  "opt_asc_desc", "tbName", "colName", "path", "filename", YY_NULLPTR
+  "expr", "setClauses", "setClause", "optionList", "option", "selector",
+  "tableList", "opt_order_clause", "opt_limit", "order_clause_list",
+  "order_clause", "opt_asc_desc", "tbName", "colName", "path", "filename", YY_NULLPTR
 };
 
 static const char *
@@ -649,12 +654,12 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-101)
+#define YYPACT_NINF (-111)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-85)
+#define YYTABLE_NINF (-94)
 
 #define yytable_value_is_error(Yyn) \
   0
@@ -663,24 +668,27 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-      73,     4,     9,    12,   -27,    20,    13,   -28,   -27,    26,
-    -101,  -101,  -101,  -101,  -101,  -101,  -101,    38,     3,  -101,
-    -101,  -101,  -101,  -101,    36,   -27,   -27,   -27,   -27,  -101,
-    -101,   -27,   -27,  -101,   -18,    48,    -7,    39,  -101,  -101,
-    -101,  -101,     5,  -101,    23,  -101,    30,    70,    32,  -101,
-    -101,  -101,   -27,    37,    40,  -101,    45,    81,   101,    76,
-     -28,   -27,    63,   -28,    92,   -36,    93,   -27,    92,  -101,
-      92,    92,    92,    46,    93,  -101,   -28,  -101,  -101,  -101,
-    -101,  -101,    -2,  -101,    83,    87,  -101,   -14,  -101,  -101,
-      -3,  -101,    91,    14,  -101,    16,    85,  -101,   114,    53,
-    -101,    92,  -101,    74,   102,   -27,   -27,   130,  -101,    92,
-    -101,    94,  -101,  -101,  -101,  -101,  -101,    92,  -101,  -101,
-    -101,  -101,  -101,  -101,    19,  -101,    93,  -101,  -101,  -101,
-    -101,  -101,  -101,    80,  -101,  -101,    85,    92,  -101,  -101,
-     131,   128,  -101,   100,  -101,  -101,    85,  -101,  -101,  -101,
-    -101,  -101,   137,    93,   103,  -101,    96,  -101,   -27,    27,
-      97,  -101,  -101,  -101,   -14,  -101,  -101,  -101,    93,  -101,
-    -101
+      75,     1,     9,    14,   -38,    12,    36,     6,   -38,     0,
+      20,  -111,  -111,  -111,  -111,  -111,  -111,  -111,    17,    62,
+      18,  -111,  -111,  -111,  -111,  -111,    60,  -111,   -38,   -38,
+     -38,   -38,  -111,  -111,   -38,   -38,  -111,   -30,    65,    10,
+      56,    25,  -111,  -111,  -111,  -111,    30,  -111,    45,  -111,
+      47,   107,    59,  -111,   -38,   -38,  -111,  -111,   -38,    72,
+      82,  -111,    83,   124,   143,   101,     6,   -38,   117,     6,
+     118,   105,   -26,   119,   -38,   118,   146,   113,  -111,   118,
+     118,   118,   114,   119,  -111,     6,  -111,  -111,  -111,  -111,
+    -111,   -13,  -111,   116,  -111,  -111,  -111,  -111,  -111,  -111,
+     115,  -111,   -11,  -111,  -111,   120,   118,    29,  -111,    89,
+      34,  -111,    37,   105,  -111,   144,    80,  -111,   118,  -111,
+      81,   130,   -38,   -38,   159,   129,    42,  -111,   118,  -111,
+     122,  -111,  -111,  -111,   123,  -111,  -111,   118,  -111,    46,
+    -111,   119,  -111,  -111,  -111,  -111,  -111,  -111,    94,  -111,
+    -111,   105,   118,  -111,  -111,   164,   163,   128,   102,  -111,
+     162,  -111,   135,   136,  -111,  -111,   105,  -111,  -111,  -111,
+    -111,  -111,   173,   119,   138,  -111,   100,  -111,   129,   133,
+     134,   137,  -111,   -38,    26,   132,  -111,  -111,  -111,  -111,
+    -111,   129,  -111,  -111,   -11,  -111,  -111,  -111,   119,   104,
+    -111,  -111,  -111
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -689,41 +697,44 @@ static const yytype_int16 yypact[] =
 static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       4,     3,    10,    11,    12,    13,     5,     0,     0,     9,
-       6,     7,     8,    14,     0,     0,     0,     0,     0,    84,
-      18,     0,     0,    91,     0,     0,    86,     0,    27,    28,
-      29,    30,    85,    69,     0,    55,    70,     0,     0,    54,
-       1,     2,     0,     0,     0,    17,     0,     0,    49,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    15,
-       0,     0,     0,     0,     0,    22,     0,    90,    26,    87,
-      88,    85,    49,    65,     0,     0,    56,    49,    71,    53,
-       0,    31,     0,     0,    33,     0,     0,    51,    50,     0,
-      89,     0,    23,     0,     0,     0,     0,    75,    16,     0,
-      36,     0,    39,    37,    40,    35,    19,     0,    20,    46,
-      43,    44,    45,    47,     0,    41,     0,    61,    60,    62,
-      57,    58,    59,     0,    66,    67,     0,     0,    73,    72,
-       0,    77,    32,     0,    34,    21,     0,    52,    63,    64,
-      48,    68,     0,     0,     0,    24,     0,    42,     0,    83,
-      74,    78,    76,    38,    49,    82,    81,    80,     0,    25,
-      79
+       0,     4,     3,    10,    11,    12,    13,     5,     0,     0,
+       0,     9,     6,     7,     8,    14,     0,    17,     0,     0,
+       0,     0,    93,    20,     0,     0,   100,     0,     0,    95,
+       0,     0,    31,    32,    33,    34,    94,    78,     0,    60,
+      79,     0,     0,    59,     0,     0,     1,     2,     0,     0,
+       0,    19,     0,     0,    54,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    15,     0,
+       0,     0,     0,     0,    26,     0,    99,    30,    96,    97,
+      94,    54,    70,     0,    51,    48,    49,    50,    52,    16,
+       0,    61,    54,    80,    58,     0,     0,     0,    35,     0,
+       0,    37,     0,     0,    56,    55,     0,    98,     0,    27,
+       0,     0,     0,     0,    84,     0,     0,    18,     0,    40,
+       0,    44,    41,    45,     0,    39,    21,     0,    22,     0,
+      46,     0,    66,    65,    67,    62,    63,    64,     0,    71,
+      72,     0,     0,    82,    81,     0,    86,     0,     0,    74,
+       0,    36,     0,     0,    38,    25,     0,    57,    68,    69,
+      53,    73,     0,     0,     0,    28,     0,    23,     0,     0,
+       0,     0,    47,     0,    92,    83,    87,    85,    77,    76,
+      75,     0,    42,    43,    54,    91,    90,    89,     0,     0,
+      29,    88,    24
 };
 
 /* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int16 yypgoto[] =
 {
-    -101,  -101,  -101,  -101,  -101,  -101,  -101,  -101,  -101,    84,
-      49,  -101,  -101,  -100,    29,   -80,  -101,   -65,  -101,  -101,
-    -101,  -101,    56,    95,     1,  -101,  -101,  -101,    -6,  -101,
-      -4,   -58,   -29,    99
+    -111,  -111,  -111,  -111,  -111,  -111,  -111,  -111,  -111,   -67,
+      63,  -111,  -111,  -110,    51,   -89,  -111,   -72,  -111,  -111,
+    -111,  -111,    76,     4,    19,   126,    13,  -111,  -111,  -111,
+       2,  -111,    -4,   -63,   -33,   131
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] =
 {
-       0,    17,    18,    19,    20,    21,    22,    44,    90,    93,
-      91,   115,   124,   125,    97,    75,    98,    45,    46,   133,
-     150,    82,    83,    47,    87,   141,   155,   160,   161,   167,
-      48,    49,    35,    36
+       0,    19,    20,    21,    22,    23,    24,    48,   107,   110,
+     108,   135,   139,    99,   114,    84,   115,    49,    50,   148,
+     170,    91,    92,   158,   159,    51,   102,   156,   175,   185,
+     186,   197,    52,    53,    38,    39
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -731,98 +742,111 @@ static const yytype_uint8 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      30,    86,   102,   135,    37,    74,    84,   107,    23,    99,
-      89,    42,    92,    94,    94,    25,   105,    74,    27,    33,
-      29,    53,    54,    55,    56,    43,    32,    57,    58,    34,
-      31,    77,    24,   148,    80,   165,   151,    26,    50,    59,
-      28,   166,   106,    84,    60,   136,   157,   100,    69,    52,
-      62,    92,   108,   109,   101,    63,    51,    78,    61,   144,
-      64,    99,   -84,    88,    38,    39,    40,    41,   149,   116,
-     117,   118,   117,    42,   145,   146,     1,    65,     2,   152,
-       3,     4,     5,    67,   169,     6,    66,    43,   159,    68,
-       7,    70,    73,     8,    71,     9,   127,   128,   129,    72,
-      96,   138,   139,   159,    10,    11,    12,    13,    14,    15,
-      33,   130,   131,   132,   110,   111,   112,   113,   114,    16,
-      74,    81,   119,   120,   121,   122,   123,    42,   119,   120,
-     121,   122,   123,   119,   120,   121,   122,   123,    76,    81,
-      42,   103,   104,   126,   137,   140,   154,   153,   143,   156,
-     158,   163,   162,   168,    88,   147,    95,   134,   142,   164,
-      85,    79,   170
+      33,   101,   119,   140,    40,    25,    83,    93,    83,    32,
+     150,   116,   104,   124,   112,    28,   109,   111,   111,   122,
+      30,    46,    34,    54,    59,    60,    61,    62,    65,    26,
+      63,    64,    66,    86,   195,    47,    89,    29,   168,   126,
+     196,   171,    31,   111,   118,    55,   123,    41,    27,    35,
+      76,    77,   117,    36,    78,    93,   182,   151,    42,    43,
+      44,    45,    56,    87,    37,   109,   189,    46,    68,   116,
+     103,    57,    69,    58,   164,    67,   169,    70,     1,    71,
+       2,    47,     3,     4,     5,   127,   128,     6,   -93,   172,
+     136,   137,     7,   138,   137,     8,     9,    10,   160,   137,
+      72,   184,   165,   166,    73,   200,    11,    12,    13,    14,
+      15,    16,   129,   130,   131,   132,   133,    75,   153,   154,
+      74,    17,    18,   142,   143,   144,   184,    79,    90,    94,
+      95,    96,    97,    98,   145,    82,   134,    80,    81,   146,
+     147,    46,    94,    95,    96,    97,    98,   188,    94,    95,
+      96,    97,    98,    94,    95,    96,    97,    98,   177,   178,
+     202,   178,    83,    85,    36,    90,    46,   105,   106,   113,
+     120,   121,   152,   141,   155,   125,   157,   162,   163,   103,
+     173,   174,   176,   179,   180,   181,   183,   187,   191,   198,
+     192,   161,   167,   193,   149,   199,   194,   190,   100,    88,
+     201
 };
 
 static const yytype_uint8 yycheck[] =
 {
-       4,    66,    82,   103,     8,    19,    64,    87,     4,    74,
-      68,    47,    70,    71,    72,     6,    30,    19,     6,    47,
-      47,    25,    26,    27,    28,    61,    13,    31,    32,    57,
-      10,    60,    28,   133,    63,     8,   136,    28,     0,    57,
-      28,    14,    56,   101,    62,   103,   146,    76,    52,    13,
-      57,   109,    55,    56,    56,    62,    53,    61,    10,   117,
-      21,   126,    57,    67,    38,    39,    40,    41,   133,    55,
-      56,    55,    56,    47,    55,    56,     3,    54,     5,   137,
-       7,     8,     9,    13,   164,    12,    56,    61,   153,    57,
-      17,    54,    11,    20,    54,    22,    43,    44,    45,    54,
-      54,   105,   106,   168,    31,    32,    33,    34,    35,    36,
-      47,    58,    59,    60,    23,    24,    25,    26,    27,    46,
-      19,    47,    48,    49,    50,    51,    52,    47,    48,    49,
-      50,    51,    52,    48,    49,    50,    51,    52,    62,    47,
-      47,    58,    55,    29,    42,    15,    18,    16,    54,    49,
-      13,    55,    49,    56,   158,   126,    72,   101,   109,   158,
-      65,    62,   168
+       4,    73,    91,   113,     8,     4,    19,    70,    19,    47,
+     120,    83,    75,   102,    81,     6,    79,    80,    81,    30,
+       6,    47,    10,     6,    28,    29,    30,    31,    58,    28,
+      34,    35,    62,    66,     8,    61,    69,    28,   148,   106,
+      14,   151,    28,   106,    57,    28,    57,    47,    47,    13,
+      54,    55,    85,    47,    58,   118,   166,   120,    38,    39,
+      40,    41,     0,    67,    58,   128,   176,    47,    58,   141,
+      74,    53,    62,    13,   137,    10,   148,    21,     3,    54,
+       5,    61,     7,     8,     9,    56,    57,    12,    58,   152,
+      56,    57,    17,    56,    57,    20,    21,    22,    56,    57,
+      55,   173,    56,    57,    57,   194,    31,    32,    33,    34,
+      35,    36,    23,    24,    25,    26,    27,    58,   122,   123,
+      13,    46,    47,    43,    44,    45,   198,    55,    47,    48,
+      49,    50,    51,    52,    54,    11,    47,    55,    55,    59,
+      60,    47,    48,    49,    50,    51,    52,    47,    48,    49,
+      50,    51,    52,    48,    49,    50,    51,    52,    56,    57,
+      56,    57,    19,    62,    47,    47,    47,    21,    55,    55,
+      54,    56,    42,    29,    15,    55,    47,    55,    55,   183,
+      16,    18,    54,    21,    49,    49,    13,    49,    55,    57,
+      56,   128,   141,    56,   118,   191,   183,   178,    72,    68,
+     198
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
    state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
-       0,     3,     5,     7,     8,     9,    12,    17,    20,    22,
-      31,    32,    33,    34,    35,    36,    46,    64,    65,    66,
-      67,    68,    69,     4,    28,     6,    28,     6,    28,    47,
-      93,    10,    13,    47,    57,    95,    96,    93,    38,    39,
-      40,    41,    47,    61,    70,    80,    81,    86,    93,    94,
-       0,    53,    13,    93,    93,    93,    93,    93,    93,    57,
-      62,    10,    57,    62,    21,    54,    56,    13,    57,    93,
-      54,    54,    54,    11,    19,    78,    62,    95,    93,    96,
-      95,    47,    84,    85,    94,    86,    80,    87,    93,    94,
-      71,    73,    94,    72,    94,    72,    54,    77,    79,    80,
-      95,    56,    78,    58,    55,    30,    56,    78,    55,    56,
-      23,    24,    25,    26,    27,    74,    55,    56,    55,    48,
-      49,    50,    51,    52,    75,    76,    29,    43,    44,    45,
-      58,    59,    60,    82,    85,    76,    94,    42,    93,    93,
-      15,    88,    73,    54,    94,    55,    56,    77,    76,    80,
-      83,    76,    94,    16,    18,    89,    49,    76,    13,    80,
-      90,    91,    49,    55,    87,     8,    14,    92,    56,    78,
-      91
+       0,     3,     5,     7,     8,     9,    12,    17,    20,    21,
+      22,    31,    32,    33,    34,    35,    36,    46,    47,    64,
+      65,    66,    67,    68,    69,     4,    28,    47,     6,    28,
+       6,    28,    47,    95,    10,    13,    47,    58,    97,    98,
+      95,    47,    38,    39,    40,    41,    47,    61,    70,    80,
+      81,    88,    95,    96,     6,    28,     0,    53,    13,    95,
+      95,    95,    95,    95,    95,    58,    62,    10,    58,    62,
+      21,    54,    55,    57,    13,    58,    95,    95,    95,    55,
+      55,    55,    11,    19,    78,    62,    97,    95,    98,    97,
+      47,    84,    85,    96,    48,    49,    50,    51,    52,    76,
+      88,    80,    89,    95,    96,    21,    55,    71,    73,    96,
+      72,    96,    72,    55,    77,    79,    80,    97,    57,    78,
+      54,    56,    30,    57,    78,    55,    72,    56,    57,    23,
+      24,    25,    26,    27,    47,    74,    56,    57,    56,    75,
+      76,    29,    43,    44,    45,    54,    59,    60,    82,    85,
+      76,    96,    42,    95,    95,    15,    90,    47,    86,    87,
+      56,    73,    55,    55,    96,    56,    57,    77,    76,    80,
+      83,    76,    96,    16,    18,    91,    54,    56,    57,    21,
+      49,    49,    76,    13,    80,    92,    93,    49,    47,    76,
+      87,    55,    56,    56,    89,     8,    14,    94,    57,    86,
+      78,    93,    56
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    63,    64,    64,    64,    64,    65,    65,    65,    65,
-      66,    66,    66,    66,    67,    67,    68,    68,    68,    68,
-      68,    69,    69,    69,    69,    69,    69,    70,    70,    70,
-      70,    71,    71,    72,    72,    73,    74,    74,    74,    74,
-      74,    75,    75,    76,    76,    76,    76,    76,    77,    78,
-      78,    79,    79,    80,    80,    81,    81,    82,    82,    82,
-      82,    82,    82,    83,    83,    84,    84,    85,    85,    86,
-      86,    87,    87,    87,    88,    88,    89,    89,    90,    90,
-      91,    92,    92,    92,    93,    94,    95,    95,    95,    95,
-      95,    96
+      66,    66,    66,    66,    67,    67,    67,    67,    68,    68,
+      68,    68,    68,    68,    68,    69,    69,    69,    69,    69,
+      69,    70,    70,    70,    70,    71,    71,    72,    72,    73,
+      74,    74,    74,    74,    74,    74,    75,    75,    76,    76,
+      76,    76,    76,    77,    78,    78,    79,    79,    80,    80,
+      81,    81,    82,    82,    82,    82,    82,    82,    83,    83,
+      84,    84,    85,    85,    86,    86,    87,    87,    88,    88,
+      89,    89,    89,    90,    90,    91,    91,    92,    92,    93,
+      94,    94,    94,    95,    96,    97,    97,    97,    97,    97,
+      98
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     4,     6,     3,     2,     6,
-       6,     7,     4,     5,     7,    10,     4,     1,     1,     1,
-       1,     1,     3,     1,     3,     2,     1,     1,     4,     1,
-       1,     1,     3,     1,     1,     1,     1,     1,     3,     0,
-       2,     1,     3,     3,     1,     1,     3,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     3,     3,     4,     1,
-       1,     1,     3,     3,     3,     0,     2,     0,     1,     3,
-       2,     1,     1,     0,     1,     1,     1,     3,     3,     4,
-       3,     1
+       1,     1,     1,     1,     2,     4,     4,     2,     6,     3,
+       2,     6,     6,     7,    10,     7,     4,     5,     7,    10,
+       4,     1,     1,     1,     1,     1,     3,     1,     3,     2,
+       1,     1,     4,     4,     1,     1,     1,     3,     1,     1,
+       1,     1,     1,     3,     0,     2,     1,     3,     3,     1,
+       1,     3,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     3,     3,     4,     1,     3,     3,     3,     1,     1,
+       1,     3,     3,     3,     0,     2,     0,     1,     3,     2,
+       1,     1,     0,     1,     1,     1,     3,     3,     4,     3,
+       1
 };
 
 
@@ -1678,657 +1702,741 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* start: stmt ';'  */
-#line 64 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 67 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1687 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1711 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 3: /* start: HELP  */
-#line 69 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 72 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1696 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1720 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 4: /* start: EXIT  */
-#line 74 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 77 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1705 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1729 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 5: /* start: T_EOF  */
-#line 79 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 82 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1714 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1738 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 10: /* txnStmt: TXN_BEGIN  */
-#line 94 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 97 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1722 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1746 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 11: /* txnStmt: TXN_COMMIT  */
-#line 98 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 101 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1730 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1754 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 12: /* txnStmt: TXN_ABORT  */
-#line 102 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 105 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1738 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1762 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 13: /* txnStmt: TXN_ROLLBACK  */
-#line 106 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 109 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1746 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1770 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 14: /* dbStmt: SHOW TABLES  */
-#line 113 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 116 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1754 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1778 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
   case 15: /* dbStmt: SHOW INDEX FROM tbName  */
-#line 117 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 120 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowIndex>((yyvsp[0].sv_str));
     }
-#line 1762 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1786 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 16: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
+  case 16: /* dbStmt: SET IDENTIFIER '=' value  */
 #line 124 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
+        (yyval.sv_node) = std::make_shared<SetStmt>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 1770 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1794 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 17: /* ddl: DROP TABLE tbName  */
+  case 17: /* dbStmt: SHOW IDENTIFIER  */
 #line 128 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<ShowSetting>((yyvsp[0].sv_str));
+    }
+#line 1802 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 18: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
+#line 135 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
+    }
+#line 1810 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 19: /* ddl: DROP TABLE tbName  */
+#line 139 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1778 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1818 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 18: /* ddl: DESC tbName  */
-#line 132 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 20: /* ddl: DESC tbName  */
+#line 143 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1786 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1826 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 19: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
-#line 136 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 21: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
+#line 147 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1794 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1834 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 20: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
-#line 140 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 22: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 151 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1802 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1842 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 21: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
-#line 147 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 23: /* ddl: IDENTIFIER TABLE tbName SET '(' optionList ')'  */
+#line 156 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        if (strcasecmp((yyvsp[-6].sv_str).c_str(), "alter") != 0) {
+            yyerror(&(yylsp[-6]), "syntax error, unexpected IDENTIFIER");
+            YYERROR;
+        }
+        (yyval.sv_node) = std::make_shared<AlterBufferPolicy>((yyvsp[-4].sv_str), std::vector<std::string>(), (yyvsp[-1].sv_set_clauses));
+    }
+#line 1854 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 24: /* ddl: IDENTIFIER INDEX tbName '(' colNameList ')' SET '(' optionList ')'  */
+#line 164 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        if (strcasecmp((yyvsp[-9].sv_str).c_str(), "alter") != 0) {
+            yyerror(&(yylsp[-9]), "syntax error, unexpected IDENTIFIER");
+            YYERROR;
+        }
+        (yyval.sv_node) = std::make_shared<AlterBufferPolicy>((yyvsp[-7].sv_str), (yyvsp[-5].sv_strs), (yyvsp[-1].sv_set_clauses));
+    }
+#line 1866 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 25: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 175 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1810 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1874 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 22: /* dml: DELETE FROM tbName optWhereClause  */
-#line 151 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 26: /* dml: DELETE FROM tbName optWhereClause  */
+#line 179 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1818 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1882 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 23: /* dml: UPDATE tbName SET setClauses optWhereClause  */
-#line 155 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 27: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 183 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1826 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1890 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 24: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause opt_limit  */
-#line 159 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 28: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause opt_limit  */
+#line 187 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-5].sv_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds), (yyvsp[-1].sv_orderbys), (yyvsp[0].sv_int));
     }
-#line 1834 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1898 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 25: /* dml: SELECT aggregate_function '(' selector ')' AS colName FROM tableList optWhereClause  */
-#line 163 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 29: /* dml: SELECT aggregate_function '(' selector ')' AS colName FROM tableList optWhereClause  */
+#line 191 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>(ast::SelectStmt::aggregate, (yyvsp[-6].sv_cols), (yyvsp[-1].sv_strs), (yyvsp[0].sv_conds), (yyvsp[-8].sv_aggregate_type), (yyvsp[-3].sv_str));
     }
-#line 1842 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1906 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 26: /* dml: LOAD path INTO tbName  */
-#line 167 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 30: /* dml: LOAD path INTO tbName  */
+#line 195 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<LoadStmt>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 1850 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1914 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 27: /* aggregate_function: COUNT  */
-#line 174 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 31: /* aggregate_function: COUNT  */
+#line 202 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_type) = SV_COUNT;
     }
-#line 1858 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1922 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 28: /* aggregate_function: MAX  */
-#line 178 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 32: /* aggregate_function: MAX  */
+#line 206 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_type) = SV_MAX;
     }
-#line 1866 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1930 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 29: /* aggregate_function: MIN  */
-#line 182 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 33: /* aggregate_function: MIN  */
+#line 210 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_type) = SV_MIN;
     }
-#line 1874 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1938 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 30: /* aggregate_function: SUM  */
-#line 186 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 34: /* aggregate_function: SUM  */
+#line 214 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_type) = SV_SUM;
     }
-#line 1882 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1946 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 31: /* fieldList: field  */
-#line 193 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 35: /* fieldList: field  */
+#line 221 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1890 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1954 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 32: /* fieldList: fieldList ',' field  */
-#line 197 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 36: /* fieldList: fieldList ',' field  */
+#line 225 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1898 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1962 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 33: /* colNameList: colName  */
-#line 204 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 37: /* colNameList: colName  */
+#line 232 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 1906 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1970 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 34: /* colNameList: colNameList ',' colName  */
-#line 208 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 38: /* colNameList: colNameList ',' colName  */
+#line 236 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 1914 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1978 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 35: /* field: colName type  */
-#line 215 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 39: /* field: colName type  */
+#line 243 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1922 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1986 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 36: /* type: INT  */
-#line 222 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 40: /* type: INT  */
+#line 250 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1930 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 1994 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 37: /* type: BIGINT  */
-#line 226 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 41: /* type: BIGINT  */
+#line 254 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_BIGINT, sizeof(int64_t));
     }
-#line 1938 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2002 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 38: /* type: CHAR '(' VALUE_INT ')'  */
-#line 230 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 42: /* type: CHAR '(' VALUE_INT ')'  */
+#line 258 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1946 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2010 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 39: /* type: FLOAT  */
-#line 234 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 43: /* type: IDENTIFIER '(' VALUE_INT ')'  */
+#line 263 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        if (strcasecmp((yyvsp[-3].sv_str).c_str(), "varchar") != 0) {
+            yyerror(&(yylsp[-3]), "syntax error, unexpected IDENTIFIER");
+            YYERROR;
+        }
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int), true);
+    }
+#line 2022 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 44: /* type: FLOAT  */
+#line 271 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
-#line 1954 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2030 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 40: /* type: DATETIME  */
-#line 238 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 45: /* type: DATETIME  */
+#line 275 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_DATETIME, 20);
     }
-#line 1962 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2038 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 41: /* valueList: value  */
-#line 245 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 46: /* valueList: value  */
+#line 282 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1970 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2046 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 42: /* valueList: valueList ',' value  */
-#line 249 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 47: /* valueList: valueList ',' value  */
+#line 286 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 1978 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2054 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 43: /* value: VALUE_INT  */
-#line 256 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 48: /* value: VALUE_INT  */
+#line 293 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 1986 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2062 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 44: /* value: VALUE_BIGINT  */
-#line 260 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 49: /* value: VALUE_BIGINT  */
+#line 297 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<BigintLit>((yyvsp[0].sv_bigint));
     }
-#line 1994 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2070 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 45: /* value: VALUE_FLOAT  */
-#line 264 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 50: /* value: VALUE_FLOAT  */
+#line 301 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 2002 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2078 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 46: /* value: VALUE_STRING  */
-#line 268 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 51: /* value: VALUE_STRING  */
+#line 305 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 2010 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2086 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 47: /* value: VALUE_DATETIME  */
-#line 272 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 52: /* value: VALUE_DATETIME  */
+#line 309 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<DatetimeLit>((yyvsp[0].sv_datetime));
     }
-#line 2018 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2094 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 48: /* condition: col op expr  */
-#line 279 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 53: /* condition: col op expr  */
+#line 316 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 2026 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2102 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 49: /* optWhereClause: %empty  */
-#line 285 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 54: /* optWhereClause: %empty  */
+#line 322 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2032 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2108 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 50: /* optWhereClause: WHERE whereClause  */
-#line 287 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 55: /* optWhereClause: WHERE whereClause  */
+#line 324 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 2040 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2116 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 51: /* whereClause: condition  */
-#line 294 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 56: /* whereClause: condition  */
+#line 331 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 2048 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2124 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 52: /* whereClause: whereClause AND condition  */
-#line 298 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 57: /* whereClause: whereClause AND condition  */
+#line 335 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 2056 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2132 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 53: /* col: tbName '.' colName  */
-#line 305 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 58: /* col: tbName '.' colName  */
+#line 342 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 2064 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2140 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 54: /* col: colName  */
-#line 309 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 59: /* col: colName  */
+#line 346 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 2072 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2148 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 55: /* colList: col  */
-#line 316 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 60: /* colList: col  */
+#line 353 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 2080 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2156 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 56: /* colList: colList ',' col  */
-#line 320 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 61: /* colList: colList ',' col  */
+#line 357 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 2088 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2164 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 57: /* op: '='  */
-#line 327 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 62: /* op: '='  */
+#line 364 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 2096 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2172 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 58: /* op: '<'  */
-#line 331 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 63: /* op: '<'  */
+#line 368 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 2104 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2180 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 59: /* op: '>'  */
-#line 335 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 64: /* op: '>'  */
+#line 372 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 2112 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2188 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 60: /* op: NEQ  */
-#line 339 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 65: /* op: NEQ  */
+#line 376 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 2120 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2196 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 61: /* op: LEQ  */
-#line 343 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 66: /* op: LEQ  */
+#line 380 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 2128 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2204 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 62: /* op: GEQ  */
-#line 347 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 67: /* op: GEQ  */
+#line 384 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 2136 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2212 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 63: /* expr: value  */
-#line 354 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 68: /* expr: value  */
+#line 391 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 2144 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2220 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 64: /* expr: col  */
-#line 358 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 69: /* expr: col  */
+#line 395 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 2152 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2228 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 65: /* setClauses: setClause  */
-#line 365 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 70: /* setClauses: setClause  */
+#line 402 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 2160 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2236 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 66: /* setClauses: setClauses ',' setClause  */
-#line 369 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 71: /* setClauses: setClauses ',' setClause  */
+#line 406 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2168 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2244 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 67: /* setClause: colName '=' value  */
-#line 376 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 72: /* setClause: colName '=' value  */
+#line 413 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2176 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2252 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 68: /* setClause: colName '=' colName value  */
-#line 380 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 73: /* setClause: colName '=' colName value  */
+#line 417 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-3].sv_str), (yyvsp[0].sv_val), true);
     }
-#line 2184 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2260 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 74: /* optionList: option  */
+#line 424 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
+    }
+#line 2268 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 69: /* selector: '*'  */
-#line 387 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 75: /* optionList: optionList ',' option  */
+#line 428 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
+    }
+#line 2276 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 76: /* option: IDENTIFIER '=' value  */
+#line 435 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
+    }
+#line 2284 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 77: /* option: IDENTIFIER '=' IDENTIFIER  */
+#line 439 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+    {
+        (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), std::make_shared<StringLit>((yyvsp[0].sv_str)));
+    }
+#line 2292 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+    break;
+
+  case 78: /* selector: '*'  */
+#line 446 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_cols) = {};
     }
-#line 2192 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2300 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 71: /* tableList: tbName  */
-#line 395 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 80: /* tableList: tbName  */
+#line 454 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2200 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2308 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 72: /* tableList: tableList ',' tbName  */
-#line 399 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 81: /* tableList: tableList ',' tbName  */
+#line 458 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2208 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2316 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 73: /* tableList: tableList JOIN tbName  */
-#line 403 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 82: /* tableList: tableList JOIN tbName  */
+#line 462 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2216 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2324 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 74: /* opt_order_clause: ORDER BY order_clause_list  */
-#line 410 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 83: /* opt_order_clause: ORDER BY order_clause_list  */
+#line 469 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     { 
         (yyval.sv_orderbys) = (yyvsp[0].sv_orderbys); 
     }
-#line 2224 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2332 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 75: /* opt_order_clause: %empty  */
-#line 413 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 84: /* opt_order_clause: %empty  */
+#line 472 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2230 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2338 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 76: /* opt_limit: LIMIT VALUE_INT  */
-#line 418 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 85: /* opt_limit: LIMIT VALUE_INT  */
+#line 477 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_int) = (yyvsp[0].sv_int);
     }
-#line 2238 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2346 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 77: /* opt_limit: %empty  */
-#line 422 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 86: /* opt_limit: %empty  */
+#line 481 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_int) = -1;
     }
-#line 2246 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2354 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 78: /* order_clause_list: order_clause  */
-#line 429 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 87: /* order_clause_list: order_clause  */
+#line 488 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_orderbys) = std::vector<std::shared_ptr<OrderBy>>{(yyvsp[0].sv_orderby)};
     }
-#line 2254 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2362 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 79: /* order_clause_list: order_clause_list ',' order_clause  */
-#line 433 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 88: /* order_clause_list: order_clause_list ',' order_clause  */
+#line 492 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_orderbys).push_back((yyvsp[0].sv_orderby));
     }
-#line 2262 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2370 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 80: /* order_clause: col opt_asc_desc  */
-#line 440 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 89: /* order_clause: col opt_asc_desc  */
+#line 499 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = std::make_shared<OrderBy>((yyvsp[-1].sv_col), (yyvsp[0].sv_orderby_dir));
     }
-#line 2270 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2378 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 81: /* opt_asc_desc: ASC  */
-#line 446 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 90: /* opt_asc_desc: ASC  */
+#line 505 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_ASC;     }
-#line 2276 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2384 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 82: /* opt_asc_desc: DESC  */
-#line 447 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 91: /* opt_asc_desc: DESC  */
+#line 506 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_DESC;    }
-#line 2282 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2390 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 83: /* opt_asc_desc: %empty  */
-#line 448 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 92: /* opt_asc_desc: %empty  */
+#line 507 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
             { (yyval.sv_orderby_dir) = OrderBy_DEFAULT; }
-#line 2288 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2396 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 86: /* path: filename  */
-#line 456 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 95: /* path: filename  */
+#line 515 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_str) = (yyvsp[0].sv_str);
     }
-#line 2296 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2404 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 87: /* path: filename '.' filename  */
-#line 460 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 96: /* path: filename '.' filename  */
+#line 519 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_str) = (yyvsp[-2].sv_str) + '.' + (yyvsp[0].sv_str);
     }
-#line 2304 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2412 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 88: /* path: filename '/' path  */
-#line 464 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 97: /* path: filename '/' path  */
+#line 523 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_str) = (yyvsp[-2].sv_str) + '/' + (yyvsp[0].sv_str);
     }
-#line 2312 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2420 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 89: /* path: '.' '.' '/' path  */
-#line 468 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 98: /* path: '.' '.' '/' path  */
+#line 527 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_str) = "../" + (yyvsp[0].sv_str);
     }
-#line 2320 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2428 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
-  case 90: /* path: '.' '/' path  */
-#line 472 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+  case 99: /* path: '.' '/' path  */
+#line 531 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
     {
         (yyval.sv_str) = "./" + (yyvsp[0].sv_str);
     }
-#line 2328 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2436 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
     break;
 
 
-#line 2332 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
+#line 2440 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2557,5 +2665,5 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 479 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
+#line 538 "/home/titanium/code/project/db2023/db2023-runtimeterror/src/parser/yacc.y"
 
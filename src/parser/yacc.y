@@ -1,6 +1,8 @@
 %{
 #include "ast.h"
 #include "yacc.tab.h"
+#include <strings.h>
+
 #include <iostream>
 #include <memory>
 
@@ -48,7 +50,8 @@ COUNT MAX MIN SUM AS
 %type <sv_col> col
 %type <sv_cols> colList selector
 %type <sv_set_clause> setClause
-%type <sv_set_clauses> setClauses
+%type <sv_set_clauses> setClauses optionList
+%type <sv_set_clause> option
 %type <sv_cond> condition
 %type <sv_conds> whereClause optWhereClause
 %type <sv_orderby> order_clause
@@ -117,6 +120,14 @@ dbStmt:
     {
         $$ = std::make_shared<ShowIndex>($4);
     }
+    |   SET IDENTIFIER '=' value
+    {
+        $$ = std::make_shared<SetStmt>($2, $4);
+    }
+    |   SHOW IDENTIFIER
+    {
+        $$ = std::make_shared<ShowSetting>($2);
+    }
     ;
 
 ddl:
@@ -140,6 +151,23 @@ ddl:
     {
         $$ = std::make_shared<DropIndex>($3, $5);
     }
+    // ALTER不是保留字，由IDENTIFIER匹配后检查
+    |   IDENTIFIER TABLE tbName SET '(' optionList ')'
+    {
+        if (strcasecmp($1.c_str(), "alter") != 0) {
+            yyerror(&@1, "syntax error, unexpected IDENTIFIER");
+            YYERROR;
+        }
+        $$ = std::make_shared<AlterBufferPolicy>($3, std::vector<std::string>(), $6);
+    }
+    |   IDENTIFIER INDEX tbName '(' colNameList ')' SET '(' optionList ')'
+    {
+        if (strcasecmp($1.c_str(), "alter") != 0) {
+            yyerror(&@1, "syntax error, unexpected IDENTIFIER");
+            YYERROR;
+        }
+        $$ = std::make_shared<AlterBufferPolicy>($3, $5, $9);
+    }
     ;
 
 dml:
@@ -230,6 +258,15 @@ type:
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_STRING, $3);
     }
+    // VARCHAR不是保留字，由IDENTIFIER匹配后检查
+    |   IDENTIFIER '(' VALUE_INT ')'
+    {
+        if (strcasecmp($1.c_str(), "varchar") != 0) {
+            yyerror(&@1, "syntax error, unexpected IDENTIFIER");
+            YYERROR;
+        }
+        $$ = std::make_shared<TypeLen>(SV_TYPE_STRING, $3, true);
+    }
     |   FLOAT
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
@@ -382,6 +419,28 @@ setClause:
     }
     ;
 
+optionList:
+        option
+    {
+        $$ = std::vector<std::shared_ptr<SetClause>>{$1};
+    }
+    |   optionList ',' option
+    {
+        $$.push_back($3);
+    }
+    ;
+
+option:
+        IDENTIFIER '=' value
+    {
+        $$ = std::make_shared<SetClause>($1, $3);
+    }
+    |   IDENTIFIER '=' IDENTIFIER
+    {
+        $$ = std::make_shared<SetClause>($1, std::make_shared<StringLit>($3));
+    }
+    ;
+
 selector:
         '*'
     {
@@ -0,0 +1,107 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "bitmap.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BITMAP_HAS_AVX2_PATH 1
+#endif
+
+namespace {
+
+#ifdef BITMAP_HAS_AVX2_PATH
+const bool cpu_has_avx2 = __builtin_cpu_supports("avx2");
+
+/**
+ * @description: 从第byte个字节起每次检查32个字节，跳过不含目标位的块（找1时为全0块，找0时为全1块）
+ * @return {int} 第一个可能包含目标位的块的起始字节，或剩余不足32字节时的位置
+ */
+__attribute__((target("avx2"))) int skip_blocks_avx2(bool bit, const char *bm, int byte, int num_bytes) {
+    const __m256i ones = _mm256_set1_epi8(-1);
+    for (; byte + 32 <= num_bytes; byte += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bm + byte));
+        bool skip = bit ? _mm256_testz_si256(block, block) : _mm256_testc_si256(block, ones);
+        if (!skip) {
+            break;
+        }
+    }
+    return byte;
+}
+#endif
+
+}  // namespace
+
+/**
+ * @description: 大的bitmap先用AVX2成块跳过不含目标位的部分
+ * @return {int} 之后按字查找的起始字节
+ */
+int Bitmap::skip_words(bool bit, const char *bm, int byte, int num_bytes) {
+#ifdef BITMAP_HAS_AVX2_PATH
+    if (cpu_has_avx2 && num_bytes >= BITMAP_AVX2_MIN_BYTES) {
+        return skip_blocks_avx2(bit, bm, byte, num_bytes);
+    }
+#endif
+    return byte;
+}
+
+int Bitmap::next_bit(bool bit, const char *bm, int max_n, int curr) {
+    int pos = curr + 1;
+    if (pos >= max_n) {
+        return max_n;
+    }
+    const int n_bytes = num_bytes(max_n);
+    // 找0时将字取反，统一为找1；补齐的0取反后落在max_n之后，由最后的比较排除
+    const uint64_t flip = bit ? 0 : ~0ULL;
+    int byte = pos / BITMAP_WIDTH;
+    uint64_t word = (load_word(bm, byte, n_bytes) ^ flip) & (~0ULL >> (pos % BITMAP_WIDTH));
+    while (word == 0) {
+        byte += 8;
+        if (byte >= n_bytes) {
+            return max_n;
+        }
+        byte = skip_words(bit, bm, byte, n_bytes);
+        word = load_word(bm, byte, n_bytes) ^ flip;
+    }
+    int found = byte * BITMAP_WIDTH + __builtin_clzll(word);
+    return found < max_n ? found : max_n;
+}
+
+int Bitmap::count(const char *bm, int max_n) {
+    const int n_bytes = num_bytes(max_n);
+    int cnt = 0;
+    for (int byte = 0; byte < n_bytes; byte += 8) {
+        uint64_t word = load_word(bm, byte, n_bytes);
+        if (byte + 8 >= n_bytes) {
+            // 最后一个字只统计max_n之前的位
+            int valid = max_n - byte * BITMAP_WIDTH;
+            word &= valid >= 64 ? ~0ULL : ~(~0ULL >> valid);
+        }
+        cnt += __builtin_popcountll(word);
+    }
+    return cnt;
+}
+
+void Bitmap::set_positions(const char *bm, int max_n, std::vector<int> &out) {
+    out.reserve(out.size() + count(bm, max_n));
+    const int n_bytes = num_bytes(max_n);
+    for (int byte = skip_words(true, bm, 0, n_bytes); byte < n_bytes; byte = skip_words(true, bm, byte + 8, n_bytes)) {
+        uint64_t word = load_word(bm, byte, n_bytes);
+        while (word != 0) {
+            int i = __builtin_clzll(word);
+            int pos = byte * BITMAP_WIDTH + i;
+            if (pos >= max_n) {
+                return;
+            }
+            out.push_back(pos);
+            word &= ~(1ULL << 63 >> i);
+        }
+    }
+}
@@ -12,9 +12,14 @@ See the Mulan PSL v2 for more details. */
 
 #include <cinttypes>
 #include <cstring>
+#include <vector>
 
 static constexpr int BITMAP_WIDTH = 8;
 static constexpr unsigned BITMAP_HIGHEST_BIT = 0x80u;  // 128 (2^7)
+static constexpr int BITMAP_AVX2_MIN_BYTES = 64;       // bitmap不少于该字节数时，查找先用AVX2每次跳过32字节
+
+/* 位序为每个字节从最高位开始（pos 0为第0个字节的0x80），与磁盘上已有的页面格式一致
+ * 查找按64位字进行：按大端序读入8个字节后，pos的先后顺序即为字中从高位到低位的顺序，用clz定位，用popcount计数 */
 
 class Bitmap {
    public:
@@ -38,14 +43,16 @@ class Bitmap {
      * @param curr 要找的从起始地址开始的偏移为[curr+1,max_n)
      * @return 找到了就返回偏移位置，没找到就返回max_n
      */
-    static int next_bit(bool bit, const char *bm, int max_n, int curr) {
-        for (int i = curr + 1; i < max_n; i++) {
-            if (is_set(bm, i) == bit) {
-                return i;
-            }
-        }
-        return max_n;
-    }
+    static int next_bit(bool bit, const char *bm, int max_n, int curr);
+
+    // [0,max_n)中为1的位的个数
+    static int count(const char *bm, int max_n);
+
+    // 将[0,max_n)中所有为1的位按递增顺序追加到out中
+    static void set_positions(const char *bm, int max_n, std::vector<int> &out);
+
+    // 存放max_n位需要的字节数
+    static int num_bytes(int max_n) { return (max_n + BITMAP_WIDTH - 1) / BITMAP_WIDTH; }
 
     // 找第一个为0 or 1的位
     static int first_bit(bool bit, const char *bm, int max_n) { return next_bit(bit, bm, max_n, -1); }
@@ -58,4 +65,17 @@ class Bitmap {
     static int get_bucket(int pos) { return pos / BITMAP_WIDTH; }
 
     static char get_bit(int pos) { return BITMAP_HIGHEST_BIT >> static_cast<char>(pos % BITMAP_WIDTH); }
+
+    // 从第byte个字节起按大端序读入一个64位字，超出num_bytes的部分补0
+    static uint64_t load_word(const char *bm, int byte, int num_bytes) {
+        uint64_t word = 0;
+        int len = num_bytes - byte < 8 ? num_bytes - byte : 8;
+        memcpy(&word, bm + byte, len);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        return word;
+    }
+
+    static int skip_words(bool bit, const char *bm, int byte, int num_bytes);
 };
@@ -14,11 +14,13 @@ See the Mulan PSL v2 for more details. */
 #include "storage/buffer_pool_manager.h"
 
 #include <algorithm>
+#include <vector>
 
 constexpr int RM_NO_PAGE = -1;
 constexpr int RM_FILE_HDR_PAGE = 0;
 constexpr int RM_FIRST_RECORD_PAGE = 1;
 constexpr int RM_MAX_RECORD_SIZE = 512;
+constexpr int RM_MAX_VAR_COLS = 32;
 
 /* 文件头，记录表数据文件的元信息，写入磁盘中文件的第0号页面 */
 struct RmFileHdr {
@@ -29,11 +31,51 @@ struct RmFileHdr {
     int bitmap_size;            // 每个页面bitmap大小
 };
 
+/* 变长字段（VARCHAR）在内存中定长记录里的位置，记录文件中只保存其实际长度的内容 */
+struct RmVarCol {
+    int offset;
+    int len;
+};
+
+/* 变长字段表，紧跟RmFileHdr写在文件第0号页面中；num_var_cols为0（包括旧版本的表文件）时使用定长格式，
+ * 否则使用slotted page格式：页头之后为slot目录，记录从页面末尾向前存放在堆中 */
+struct RmVarColHdr {
+    int num_var_cols;
+    RmVarCol var_cols[RM_MAX_VAR_COLS];
+};
+
 /* 表数据文件中每个页面的页头，记录每个页面的元信息 */
 struct RmPageHdr {
     int next_free_page_no;  // 当前页面满了之后，下一个包含空闲空间的页面号（初始化为-1）
-    int num_records;        // 当前页面中当前已经存储的记录个数（初始化为0）
+    uint16_t num_records;   // 当前页面中当前已经存储的记录个数（初始化为0）
+    uint16_t free_slot_hint;  // 该slot之前的slot都已被占用，插入时从这里开始查找空闲slot（初始化为0）
 };
+// 每条记录至少1字节，每页记录数小于MAX_PAGE_SIZE，num_records放得进16位；原先的int num_records在小端序下高16位为0，
+// 因此旧页面读出的free_slot_hint为0，仍是合法的提示
+static_assert(MAX_PAGE_SIZE <= UINT16_MAX, "num_records must fit in uint16_t");
+static_assert(sizeof(RmPageHdr) == 2 * sizeof(int), "RmPageHdr layout must not change");
+
+/* slotted page格式的页头，next_free_page_no和num_records与RmPageHdr位置相同，空闲页面链表的维护方式通用 */
+struct RmSlottedPageHdr {
+    int next_free_page_no;  // 下一个包含空闲空间的页面号
+    uint16_t num_records;   // 在用的slot个数，包括转发桩和迁入的记录
+    uint16_t num_slots;     // slot目录的项数
+    uint16_t heap_begin;    // 堆的起始偏移（相对页面数据的开头），堆从页面末尾向前增长
+    uint16_t garbage;       // 堆中已释放、整理页面后才能重用的字节数
+    uint8_t on_free_list;   // 页面是否在空闲页面链表中
+    uint8_t reserved[3];
+};
+
+/* slot目录项，offset为0表示空闲 */
+struct RmSlot {
+    uint16_t offset;
+    uint16_t len;
+    uint16_t flags;
+};
+
+// 记录更新后在原页面放不下时迁移到其他页面，原slot改为保存新位置Rid的转发桩，rid保持不变
+static constexpr uint16_t RM_SLOT_FORWARD = 0x1;    // 该slot是转发桩
+static constexpr uint16_t RM_SLOT_MOVED = 0x2;      // 该slot是迁入的记录，只能经由转发桩访问，扫描时跳过
 
 /* 表中的记录 */
 struct RmRecord {
@@ -64,7 +106,7 @@ struct RmRecord {
         allocated_ = true;
     }
 
-    RmRecord(int size_, char* data_) {
+    RmRecord(int size_, const char* data_) {
         size = size_;
         data = new char[size_];
         memcpy(data, data_, size_);
@@ -92,3 +134,79 @@ struct RmRecord {
         data = nullptr;
     }
 };
+
+/* 表中记录的只读视图，持有记录所在页面的pin，data直接指向缓冲池页面中的slot，析构时unpin页面
+ * 扫描和谓词判断直接在页面上进行，只有记录需要离开算子时才通过to_record()复制 */
+class RecordRef {
+   public:
+    RecordRef() = default;
+
+    RecordRef(BufferPoolManager *bpm, Page *page, const char *data, int size)
+        : bpm_(bpm), page_(page), data_(data), size_(size) {}
+
+    RecordRef(const RecordRef &) = delete;
+    RecordRef &operator=(const RecordRef &) = delete;
+
+    RecordRef(RecordRef &&other) noexcept
+        : bpm_(other.bpm_), page_(other.page_), data_(other.data_), size_(other.size_), buf_(std::move(other.buf_)) {
+        other.page_ = nullptr;
+        other.data_ = nullptr;
+    }
+
+    RecordRef &operator=(RecordRef &&other) noexcept {
+        if (this != &other) {
+            reset();
+            bpm_ = other.bpm_;
+            page_ = other.page_;
+            data_ = other.data_;
+            size_ = other.size_;
+            buf_ = std::move(other.buf_);
+            other.page_ = nullptr;
+            other.data_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~RecordRef() { reset(); }
+
+    /* 释放持有的页面 */
+    void reset() {
+        if (page_ != nullptr) {
+            bpm_->unpin_page(page_, false);
+            page_ = nullptr;
+        }
+        data_ = nullptr;
+    }
+
+    bool valid() const { return data_ != nullptr; }
+
+    const char *data() const { return data_; }
+
+    int size() const { return size_; }
+
+    Page *page() const { return page_; }
+
+    /* 在同一页面内重新指向另一条记录，不重新fetch页面 */
+    void rebind(const char *data) { data_ = data; }
+
+    /* 不持有页面，由调用者把记录解码到自身的缓冲区中（slotted page格式的表），返回缓冲区 */
+    char *materialize(int size) {
+        reset();
+        buf_.resize(size);
+        data_ = buf_.data();
+        size_ = size;
+        return buf_.data();
+    }
+
+    /* 复制出一条独立的记录 */
+    std::unique_ptr<RmRecord> to_record() const {
+        return std::make_unique<RmRecord>(size_, data_);
+    }
+
+   private:
+    BufferPoolManager *bpm_ = nullptr;
+    Page *page_ = nullptr;
+    const char *data_ = nullptr;
+    int size_ = 0;
+    std::vector<char> buf_;
+};
@@ -24,6 +24,11 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid& rid, Context* cont
     // 2. 初始化一个指向RmRecord的指针（赋值其内部的data和size）
 
     context->lock_mgr_->lock_shared_on_record(context->txn_, rid, fd_);
+    if (is_slotted()) {
+        auto ret = std::make_unique<RmRecord>(file_hdr_.record_size);
+        read_slotted_record(rid, ret->data);
+        return ret;
+    }
     // 获取指定记录所在的 page handle
     const auto &target_page_handle = fetch_page_handle(rid.page_no);
 
@@ -33,19 +38,47 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid& rid, Context* cont
         target_page_handle.get_slot(rid.slot_no)
     );
 
-    // unpin 分配的页面
-    buffer_pool_manager_->unpin_page(PageId {fd_, rid.page_no}, true);
+    // unpin 分配的页面，只读访问不会弄脏页面
+    buffer_pool_manager_->unpin_page(target_page_handle.page, false);
 
     return ret;
 }
 
+/**
+ * @description: 获取当前表中记录号为rid的记录的只读视图，不复制记录
+ * @param {Rid&} rid 记录号，指定记录的位置
+ * @param {Context*} context
+ * @param {RecordRef&} ref 输出的记录视图；若ref已经持有rid所在的页面则直接复用，否则释放原页面并fetch新页面
+ */
+void RmFileHandle::get_record_ref(const Rid& rid, Context* context, RecordRef& ref) const {
+    context->lock_mgr_->lock_shared_on_record(context->txn_, rid, fd_);
+    if (is_slotted()) {
+        // 页面中的记录是编码后的格式，解码到ref自身的缓冲区中
+        read_slotted_record(rid, ref.materialize(file_hdr_.record_size));
+        return;
+    }
+
+    Page *page = ref.page();
+    if (page != nullptr && page->get_page_id().fd == fd_ && page->get_page_id().page_no == rid.page_no) {
+        // 同一页面上的下一条记录，沿用已有的pin
+        RmPageHandle page_handle(&file_hdr_, page);
+        ref.rebind(page_handle.get_slot(rid.slot_no));
+        return;
+    }
+
+    ref.reset();
+    auto page_handle = fetch_page_handle(rid.page_no);
+    ref = RecordRef(buffer_pool_manager_, page_handle.page, page_handle.get_slot(rid.slot_no), file_hdr_.record_size);
+}
+
 /**
  * @description: 在当前表中插入一条记录，不指定插入位置
  * @param {char*} buf 要插入的记录的数据
  * @param {Context*} context
+ * @param {BufferAccessStrategy*} strategy 批量插入（LOAD）时使用的缓冲池访问策略
  * @return {Rid} 插入的记录的记录号（位置）
  */
-Rid RmFileHandle::insert_record(char* buf, Context* context) {
+Rid RmFileHandle::insert_record(char* buf, Context* context, BufferAccessStrategy *strategy) {
     // Todo:
     // 1. 获取当前未满的page handle
     // 2. 在page handle中找到空闲slot位置
@@ -55,17 +88,23 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
 
     // Caution: 页面插满后自动顺序（或链表序）扩充下一个页面 未检查是否符合file_hdr
 
+    if (is_slotted()) {
+        char data[RM_MAX_RECORD_SIZE + RM_MAX_VAR_COLS * sizeof(uint16_t)];
+        int len = encode_record(buf, data);
+        return insert_slotted(data, len, 0, context, strategy);
+    }
+
     // 获取当前未满的 page handle
-    auto available_page_handle = create_page_handle();
+    auto available_page_handle = create_page_handle(strategy);
     // 获得未满的 page handle 的 page header
     auto &available_page_hdr = *available_page_handle.page_hdr;
 
-    // 获取空闲 slot 的位置
+    // 获取空闲 slot 的位置，free_slot_hint之前的slot均已占用，从提示处开始查找
     const auto available_slot_no = Bitmap::next_bit(
         false,
         available_page_handle.bitmap,
         file_hdr_.num_records_per_page,
-        -1
+        available_page_hdr.free_slot_hint - 1
     );
 
     auto rid = Rid{.page_no = available_page_handle.page->get_page_id().page_no, .slot_no = available_slot_no};
@@ -78,6 +117,7 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
     Bitmap::set(available_page_handle.bitmap, available_slot_no);
     // 更新 page hdr
     available_page_hdr.num_records += 1;
+    available_page_hdr.free_slot_hint = available_slot_no + 1;
 
     // 注意考虑插入一条记录后页面已满的情况，需要更新file_hdr_.first_free_page_no
     if (available_page_hdr.num_records == file_hdr_.num_records_per_page) {
@@ -96,7 +136,7 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
     }
 
     // unpin 分配的页面
-    buffer_pool_manager_->unpin_page(PageId {fd_, new_rid.page_no}, true);
+    buffer_pool_manager_->unpin_page(available_page_handle.page, true);
 
     return new_rid;
 }
@@ -107,10 +147,14 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
  * @param {char*} buf 要插入记录的数据
  */
 void RmFileHandle::insert_record(const Rid& rid, char* buf) {
+    if (is_slotted()) {
+        insert_record_slotted(rid, buf);
+        return;
+    }
     // 获得待插入的页面
     auto target_page_handle = fetch_page_handle(rid.page_no);
     // 该位置是否已经有记录，如果无，更新page hdr与bitmap
-    if (!is_record(rid)) {
+    if (!Bitmap::is_set(target_page_handle.bitmap, rid.slot_no)) {
         Bitmap::set(target_page_handle.bitmap, rid.slot_no);
         target_page_handle.page_hdr->num_records += 1;
     }
@@ -118,7 +162,7 @@ void RmFileHandle::insert_record(const Rid& rid, char* buf) {
     std::copy_n(buf, file_hdr_.record_size, target_page_handle.get_slot(rid.slot_no));
 
     // unpin 分配的页面
-    buffer_pool_manager_->unpin_page(PageId {fd_, rid.page_no}, true);
+    buffer_pool_manager_->unpin_page(target_page_handle.page, true);
 }
 
 /**
@@ -132,6 +176,10 @@ void RmFileHandle::delete_record(const Rid& rid, Context* context) {
     // 2. 更新page_handle.page_hdr中的数据结构
     // 注意考虑删除一条记录后页面未满的情况，需要调用release_page_handle()
 
+    if (is_slotted()) {
+        delete_record_slotted(rid, context);
+        return;
+    }
     context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
 
     // 获取指定记录所在的page handle
@@ -143,12 +191,15 @@ void RmFileHandle::delete_record(const Rid& rid, Context* context) {
     // 更新 page_handle.page_hdr中的数据结构
     target_page_handle.page_hdr->num_records -= 1;
     Bitmap::reset(target_page_handle.bitmap, rid.slot_no);
+    if (rid.slot_no < target_page_handle.page_hdr->free_slot_hint) {
+        target_page_handle.page_hdr->free_slot_hint = rid.slot_no;
+    }
     // 完成后记录lsn
     if (context != nullptr) {
         target_page_handle.page->set_page_lsn(context->txn_->get_prev_lsn());
     }
-    // unpin 分配的页面
-    buffer_pool_manager_->unpin_page(target_page_handle.page->get_page_id(), true);
+    // unpin 分配的页面，页面变空时交还给空闲页表
+    unpin_deleted_page(target_page_handle.page);
 }
 
 /**
@@ -162,6 +213,10 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
     // 1. 获取指定记录所在的page handle
     // 2. 更新记录
 
+    if (is_slotted()) {
+        update_record_slotted(rid, buf, context);
+        return;
+    }
     context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
 
     // 获取指定记录所在的 page handle
@@ -169,7 +224,7 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
     // 更新记录
     std::copy_n(buf, file_hdr_.record_size, target_page_handle.get_slot(rid.slot_no));
     // unpin 分配的页面
-    buffer_pool_manager_->unpin_page(PageId {fd_, rid.page_no}, true);
+    buffer_pool_manager_->unpin_page(target_page_handle.page, true);
     // 完成后记录lsn
     if (context != nullptr) {
         target_page_handle.page->set_page_lsn(context->txn_->get_prev_lsn());
@@ -182,9 +237,10 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
 /**
  * @description: 获取指定页面的页面句柄
  * @param {int} page_no 页面号
+ * @param {BufferAccessStrategy*} strategy 缺页时使用的缓冲池访问策略
  * @return {RmPageHandle} 指定页面的句柄
  */
-RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
+RmPageHandle RmFileHandle::fetch_page_handle(int page_no, BufferAccessStrategy *strategy) const {
     // Todo:
     // 使用缓冲池获取指定页面，并生成page_handle返回给上层
     // if page_no is invalid, throw PageNotExistError exception
@@ -195,16 +251,17 @@ RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
     }
     // 从缓冲池获得指定页面
     auto target_page =
-        buffer_pool_manager_->fetch_page(PageId {fd_, page_no});
+        buffer_pool_manager_->fetch_page(PageId {fd_, page_no}, strategy);
 
     return RmPageHandle(&file_hdr_, target_page);
 }
 
 /**
  * @description: 创建一个新的page handle
+ * @param {BufferAccessStrategy*} strategy 使用的缓冲池访问策略
  * @return {RmPageHandle} 新的PageHandle
  */
-RmPageHandle RmFileHandle::create_new_page_handle() {
+RmPageHandle RmFileHandle::create_new_page_handle(BufferAccessStrategy *strategy) {
     // Todo:
     // 1.使用缓冲池来创建一个新page
     // 2.更新page handle中的相关信息
@@ -212,26 +269,31 @@ RmPageHandle RmFileHandle::create_new_page_handle() {
 
     // 使用缓冲池来创建一个新page
     PageId new_page_id{.fd = fd_, .page_no = INVALID_PAGE_ID};
-    auto new_page = buffer_pool_manager_->new_page(&new_page_id);
+    auto new_page = buffer_pool_manager_->new_page(&new_page_id, strategy);
     if (new_page == nullptr) {
         throw InternalError("Create new page handle failed.");
     }
     // 更新新页面中相关信息
     auto new_page_handle = RmPageHandle(&file_hdr_, new_page);
-    *new_page_handle.page_hdr = RmPageHdr {
-        .next_free_page_no = RM_NO_PAGE,
-        .num_records = 0,
-    };
-    // 更新新页面的bit map
-    Bitmap::init(
-        new_page_handle.bitmap,
-        new_page_handle.file_hdr->bitmap_size
-    );
+    if (is_slotted()) {
+        RmSlottedPageHandle slotted_page_handle(new_page);
+        slotted_page_handle.init();
+        slotted_page_handle.page_hdr->on_free_list = 1;
+    } else {
+        *new_page_handle.page_hdr = RmPageHdr {
+            .next_free_page_no = RM_NO_PAGE,
+            .num_records = 0,
+            .free_slot_hint = 0,
+        };
+        // 更新新页面的bit map
+        Bitmap::init(
+            new_page_handle.bitmap,
+            new_page_handle.file_hdr->bitmap_size
+        );
+    }
 
-    // 将新页面写入磁盘 防呆
-    buffer_pool_manager_->flush_page(new_page_id);
-    // 更新file_hdr_
-    file_hdr_.num_pages += 1;
+    // 更新file_hdr_，新页面可能是空闲页表中重用的页面，此时文件的页面个数不变
+    file_hdr_.num_pages = std::max(file_hdr_.num_pages, new_page_id.page_no + 1);
     file_hdr_.first_free_page_no = new_page_id.page_no;
     disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(RmFileHdr));
 
@@ -241,10 +303,11 @@ RmPageHandle RmFileHandle::create_new_page_handle() {
 /**
  * @brief 创建或获取一个空闲的page handle
  *
+ * @param strategy 使用的缓冲池访问策略
  * @return RmPageHandle 返回生成的空闲page handle
  * @note pin the page, remember to unpin it outside!
  */
-RmPageHandle RmFileHandle::create_page_handle() {
+RmPageHandle RmFileHandle::create_page_handle(BufferAccessStrategy *strategy) {
     // Todo:
     // 1. 判断file_hdr_中是否还有空闲页
     //     1.1 没有空闲页：使用缓冲池来创建一个新page；可直接调用create_new_page_handle()
@@ -253,9 +316,9 @@ RmPageHandle RmFileHandle::create_page_handle() {
 
     // Question: 使用以下条件判定是否还有空闲页，即：空闲页即free page
     if (file_hdr_.first_free_page_no == RM_NO_PAGE) {
-        return create_new_page_handle();
+        return create_new_page_handle(strategy);
     }
-    return fetch_page_handle(file_hdr_.first_free_page_no);
+    return fetch_page_handle(file_hdr_.first_free_page_no, strategy);
 }
 
 /**
@@ -273,12 +336,265 @@ void RmFileHandle::release_page_handle(RmPageHandle &page_handle) {
     disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(RmFileHdr));
 }
 
+/**
+ * @description: 删除记录后unpin页面。页面中已没有记录且位于空闲页面链表头部时，将其从链表中摘下、
+ *               从缓冲池中删除并交给DiskManager的空闲页表，文件之后分配新页面时会重用该页面。
+ *               仍被其他线程pin住的页面无法删除，重新放回链表头部
+ * @param {Page*} page 删除记录的页面，两种页面格式的next_free_page_no和num_records位置相同
+ */
+void RmFileHandle::unpin_deleted_page(Page *page) {
+    auto page_hdr = reinterpret_cast<RmPageHdr *>(page->get_data() + page->OFFSET_PAGE_HDR);
+    PageId page_id = page->get_page_id();
+    if (page_hdr->num_records != 0 || file_hdr_.first_free_page_no != page_id.page_no) {
+        buffer_pool_manager_->unpin_page(page, true);
+        return;
+    }
+    // 先将页面从链表中摘下并写入文件头，再放入空闲页表，页面不会同时出现在两处。
+    // 空闲页表在关闭文件时才写入磁盘，写入前文件已fsync，崩溃后磁盘上的文件头也不会再引用该页面
+    file_hdr_.first_free_page_no = page_hdr->next_free_page_no;
+    disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(RmFileHdr));
+    buffer_pool_manager_->unpin_page(page, true);
+    // delete_page写回页面，之后扫描读到的是一个空页面
+    if (buffer_pool_manager_->delete_page(page_id)) {
+        disk_manager_->deallocate_page(fd_, page_id.page_no);
+    } else {
+        file_hdr_.first_free_page_no = page_id.page_no;
+        disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(RmFileHdr));
+    }
+}
+
 lsn_t RmFileHandle::get_page_lsn(page_id_t page_no) {
     auto target_page = fetch_page_handle(page_no);
 
     auto page_lsn = target_page.page->get_page_lsn();
 
-    buffer_pool_manager_->unpin_page(PageId {fd_, page_no}, false);
+    buffer_pool_manager_->unpin_page(target_page.page, false);
 
     return page_lsn;
+}
+
+/**
+ * @description: 将内存中的定长记录编码为slotted page中保存的格式：定长字段原样保存，
+ *               变长字段保存为2字节的长度加去掉末尾填充0之后的内容
+ * @param {char*} buf 定长格式的记录
+ * @param {char*} out 编码结果，至少max_encoded_size_字节
+ * @return {int} 编码后的长度
+ */
+int RmFileHandle::encode_record(const char *buf, char *out) const {
+    int pos = 0;
+    int len = 0;
+    for (int i = 0; i < var_col_hdr_.num_var_cols; i++) {
+        const RmVarCol &col = var_col_hdr_.var_cols[i];
+        memcpy(out + len, buf + pos, col.offset - pos);
+        len += col.offset - pos;
+        uint16_t n = col.len;
+        while (n > 0 && buf[col.offset + n - 1] == 0) {
+            n--;
+        }
+        memcpy(out + len, &n, sizeof(n));
+        len += sizeof(n);
+        memcpy(out + len, buf + col.offset, n);
+        len += n;
+        pos = col.offset + col.len;
+    }
+    memcpy(out + len, buf + pos, file_hdr_.record_size - pos);
+    return len + file_hdr_.record_size - pos;
+}
+
+/**
+ * @description: 将slotted page中保存的记录解码为内存中的定长记录，变长字段补0到定义的长度
+ */
+void RmFileHandle::decode_record(const char *data, char *out) const {
+    int pos = 0;
+    for (int i = 0; i < var_col_hdr_.num_var_cols; i++) {
+        const RmVarCol &col = var_col_hdr_.var_cols[i];
+        memcpy(out + pos, data, col.offset - pos);
+        data += col.offset - pos;
+        uint16_t n;
+        memcpy(&n, data, sizeof(n));
+        data += sizeof(n);
+        memcpy(out + col.offset, data, n);
+        memset(out + col.offset + n, 0, col.len - n);
+        data += n;
+        pos = col.offset + col.len;
+    }
+    memcpy(out + pos, data, file_hdr_.record_size - pos);
+}
+
+/**
+ * @description: 读取slotted page格式的表中记录号为rid的记录，记录已迁移时经由转发桩读取
+ * @param {Rid&} rid 记录号
+ * @param {char*} out 解码后的定长记录
+ */
+void RmFileHandle::read_slotted_record(const Rid &rid, char *out) const {
+    RmSlottedPageHandle page_handle(fetch_page_handle(rid.page_no).page);
+    if (!page_handle.is_used(rid.slot_no) || (page_handle.slots[rid.slot_no].flags & RM_SLOT_MOVED)) {
+        buffer_pool_manager_->unpin_page(page_handle.page, false);
+        throw RecordNotFoundError(rid.page_no, rid.slot_no);
+    }
+    if (page_handle.slots[rid.slot_no].flags & RM_SLOT_FORWARD) {
+        Rid target;
+        memcpy(&target, page_handle.get_record(rid.slot_no), sizeof(Rid));
+        buffer_pool_manager_->unpin_page(page_handle.page, false);
+        RmSlottedPageHandle target_handle(fetch_page_handle(target.page_no).page);
+        decode_record(target_handle.get_record(target.slot_no), out);
+        buffer_pool_manager_->unpin_page(target_handle.page, false);
+        return;
+    }
+    decode_record(page_handle.get_record(rid.slot_no), out);
+    buffer_pool_manager_->unpin_page(page_handle.page, false);
+}
+
+/**
+ * @description: 在空闲页面链表的第一个页面中插入一条编码后的记录
+ * @param {char*} data 编码后的记录
+ * @param {int} len 编码后的长度
+ * @param {uint16_t} flags 为RM_SLOT_MOVED时插入的是迁移的记录，不加锁也不设置页面lsn
+ * @return {Rid} 插入的位置
+ */
+Rid RmFileHandle::insert_slotted(const char *data, int len, uint16_t flags, Context *context,
+                                 BufferAccessStrategy *strategy) {
+    while (true) {
+        RmSlottedPageHandle page_handle(create_page_handle(strategy).page);
+        page_id_t page_no = page_handle.page->get_page_id().page_no;
+        if (!has_room(page_handle)) {
+            // 页面中的记录原地变长后不再有足够的空间，但仍在空闲页面链表中，将其摘下
+            file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
+            page_handle.page_hdr->on_free_list = 0;
+            disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(RmFileHdr));
+            buffer_pool_manager_->unpin_page(page_handle.page, true);
+            continue;
+        }
+        Rid rid{.page_no = page_no, .slot_no = page_handle.next_slot()};
+        if (context != nullptr && flags == 0) {
+            try {
+                context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
+            } catch (...) {
+                buffer_pool_manager_->unpin_page(page_handle.page, false);
+                throw;
+            }
+        }
+        page_handle.insert(data, len, flags);
+        // 插入后放不下最长的记录时，将页面从空闲页面链表中摘下
+        if (!has_room(page_handle)) {
+            file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
+            page_handle.page_hdr->on_free_list = 0;
+            disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(RmFileHdr));
+        }
+        if (context != nullptr && flags == 0) {
+            page_handle.page->set_page_lsn(context->txn_->get_prev_lsn());
+        }
+        buffer_pool_manager_->unpin_page(page_handle.page, true);
+        return rid;
+    }
+}
+
+/**
+ * @description: 有了足够的空闲空间且不在空闲页面链表中的页面重新加入链表
+ */
+void RmFileHandle::release_slotted_page(RmSlottedPageHandle &page_handle) {
+    if (page_handle.page_hdr->on_free_list || !has_room(page_handle)) {
+        return;
+    }
+    page_handle.page_hdr->on_free_list = 1;
+    page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
+    file_hdr_.first_free_page_no = page_handle.page->get_page_id().page_no;
+    disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(RmFileHdr));
+}
+
+void RmFileHandle::erase_slotted(RmSlottedPageHandle &page_handle, int slot_no) {
+    page_handle.erase(slot_no);
+    release_slotted_page(page_handle);
+}
+
+/**
+ * @description: slotted page格式的表中在指定位置插入一条记录（事务回滚和故障恢复），
+ *               位置上已有记录时改为更新；原页面放不下时记录迁移到其他页面，原位置保存转发桩
+ */
+void RmFileHandle::insert_record_slotted(const Rid &rid, const char *buf) {
+    RmSlottedPageHandle page_handle(fetch_page_handle(rid.page_no).page);
+    if (page_handle.is_used(rid.slot_no)) {
+        buffer_pool_manager_->unpin_page(page_handle.page, false);
+        update_record_slotted(rid, buf, nullptr);
+        return;
+    }
+    char data[RM_MAX_RECORD_SIZE + RM_MAX_VAR_COLS * sizeof(uint16_t)];
+    int len = encode_record(buf, data);
+    if (!page_handle.insert_at(rid.slot_no, data, len, 0)) {
+        Rid target = insert_slotted(data, len, RM_SLOT_MOVED, nullptr, nullptr);
+        if (!page_handle.insert_at(rid.slot_no, reinterpret_cast<const char *>(&target), sizeof(Rid), RM_SLOT_FORWARD)) {
+            buffer_pool_manager_->unpin_page(page_handle.page, false);
+            throw InternalError("RmFileHandle::insert_record: no space for record " + std::to_string(rid.page_no) +
+                                "," + std::to_string(rid.slot_no));
+        }
+    }
+    buffer_pool_manager_->unpin_page(page_handle.page, true);
+}
+
+/**
+ * @description: 更新slotted page格式的表中的记录，rid保持不变：
+ *               新记录在所在页面放不下时迁移到其他页面，原位置改为转发桩
+ */
+void RmFileHandle::update_record_slotted(const Rid &rid, const char *buf, Context *context) {
+    if (context != nullptr) {
+        context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
+    }
+    char data[RM_MAX_RECORD_SIZE + RM_MAX_VAR_COLS * sizeof(uint16_t)];
+    int len = encode_record(buf, data);
+
+    RmSlottedPageHandle page_handle(fetch_page_handle(rid.page_no).page);
+    if (!page_handle.is_used(rid.slot_no)) {
+        buffer_pool_manager_->unpin_page(page_handle.page, false);
+        throw RecordNotFoundError(rid.page_no, rid.slot_no);
+    }
+    if (page_handle.slots[rid.slot_no].flags & RM_SLOT_FORWARD) {
+        Rid target;
+        memcpy(&target, page_handle.get_record(rid.slot_no), sizeof(Rid));
+        RmSlottedPageHandle target_handle(fetch_page_handle(target.page_no).page);
+        if (target_handle.replace(target.slot_no, data, len, RM_SLOT_MOVED)) {
+            release_slotted_page(target_handle);
+            buffer_pool_manager_->unpin_page(target_handle.page, true);
+        } else {
+            erase_slotted(target_handle, target.slot_no);
+            buffer_pool_manager_->unpin_page(target_handle.page, true);
+            target = insert_slotted(data, len, RM_SLOT_MOVED, nullptr, nullptr);
+            page_handle.replace(rid.slot_no, reinterpret_cast<const char *>(&target), sizeof(Rid), RM_SLOT_FORWARD);
+        }
+    } else if (page_handle.replace(rid.slot_no, data, len, 0)) {
+        release_slotted_page(page_handle);
+    } else {
+        // 转发桩不超过记录的最小占用空间，总能原地写入
+        Rid target = insert_slotted(data, len, RM_SLOT_MOVED, nullptr, nullptr);
+        page_handle.replace(rid.slot_no, reinterpret_cast<const char *>(&target), sizeof(Rid), RM_SLOT_FORWARD);
+    }
+    if (context != nullptr) {
+        page_handle.page->set_page_lsn(context->txn_->get_prev_lsn());
+    }
+    buffer_pool_manager_->unpin_page(page_handle.page, true);
+}
+
+/**
+ * @description: 删除slotted page格式的表中的记录，已迁移的记录连同转发桩一起删除
+ */
+void RmFileHandle::delete_record_slotted(const Rid &rid, Context *context) {
+    if (context != nullptr) {
+        context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
+    }
+    RmSlottedPageHandle page_handle(fetch_page_handle(rid.page_no).page);
+    if (!page_handle.is_used(rid.slot_no)) {
+        buffer_pool_manager_->unpin_page(page_handle.page, false);
+        throw RecordNotFoundError(rid.page_no, rid.slot_no);
+    }
+    if (page_handle.slots[rid.slot_no].flags & RM_SLOT_FORWARD) {
+        Rid target;
+        memcpy(&target, page_handle.get_record(rid.slot_no), sizeof(Rid));
+        RmSlottedPageHandle target_handle(fetch_page_handle(target.page_no).page);
+        erase_slotted(target_handle, target.slot_no);
+        unpin_deleted_page(target_handle.page);
+    }
+    erase_slotted(page_handle, rid.slot_no);
+    if (context != nullptr) {
+        page_handle.page->set_page_lsn(context->txn_->get_prev_lsn());
+    }
+    unpin_deleted_page(page_handle.page);
 }
\ No newline at end of file
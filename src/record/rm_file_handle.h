@@ -19,6 +19,7 @@ See the Mulan PSL v2 for more details. */
 #include "bitmap.h"
 #include "common/context.h"
 #include "rm_defs.h"
+#include "rm_slotted_page.h"
 
 class RmManager;
 
@@ -52,6 +53,8 @@ class RmFileHandle {
     BufferPoolManager *buffer_pool_manager_;
     int fd_;        // 打开文件后产生的文件句柄
     RmFileHdr file_hdr_;    // 文件头，维护当前表文件的元数据
+    RmVarColHdr var_col_hdr_{};  // 变长字段表，不为空时文件使用slotted page格式
+    int max_encoded_size_ = 0;   // slotted page格式下一条记录编码后的最大长度
 
    public:
     RmFileHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
@@ -60,6 +63,14 @@ class RmFileHandle {
         // 这里实际就是初始化file_hdr，只不过是从磁盘中读出进行初始化
         // init file_hdr_
         disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
+        // 定长格式的bitmap_size至少为1，为0表示slotted page格式，此时文件头之后还有变长字段表
+        if (file_hdr_.bitmap_size == 0) {
+            char buf[sizeof(RmFileHdr) + sizeof(RmVarColHdr)];
+            disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, buf, sizeof(buf));
+            memcpy(&var_col_hdr_, buf + sizeof(RmFileHdr), sizeof(RmVarColHdr));
+            max_encoded_size_ = RmSlottedPageHandle::alloc_size(file_hdr_.record_size +
+                                                                var_col_hdr_.num_var_cols * (int)sizeof(uint16_t));
+        }
         // disk_manager管理的fd对应的文件中，设置从file_hdr_.num_pages开始分配page_no
         disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
     }
@@ -67,15 +78,28 @@ class RmFileHandle {
     RmFileHdr get_file_hdr() { return file_hdr_; }
     int GetFd() { return fd_; }
 
+    /* 文件是否使用slotted page格式保存变长记录 */
+    bool is_slotted() const { return var_col_hdr_.num_var_cols > 0; }
+
     /* 判断指定位置上是否已经存在一条记录，通过Bitmap来判断 */
     bool is_record(const Rid &rid) const {
+        if (is_slotted()) {
+            RmSlottedPageHandle page_handle(fetch_page_handle(rid.page_no).page);
+            bool ret = page_handle.is_used(rid.slot_no) && !(page_handle.slots[rid.slot_no].flags & RM_SLOT_MOVED);
+            buffer_pool_manager_->unpin_page(page_handle.page, false);
+            return ret;
+        }
         RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-        return Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        bool ret = Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        buffer_pool_manager_->unpin_page(page_handle.page, false);
+        return ret;
     }
 
     std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context) const;
 
-    Rid insert_record(char *buf, Context *context);
+    void get_record_ref(const Rid &rid, Context *context, RecordRef &ref) const;
+
+    Rid insert_record(char *buf, Context *context, BufferAccessStrategy *strategy = nullptr);
 
     void insert_record(const Rid &rid, char *buf);
 
@@ -85,14 +109,39 @@ class RmFileHandle {
 
     void close_all_page() { assert(true == buffer_pool_manager_->delete_all_page(fd_)); }
 
-    RmPageHandle create_new_page_handle();
+    RmPageHandle create_new_page_handle(BufferAccessStrategy *strategy = nullptr);
 
-    RmPageHandle fetch_page_handle(int page_no) const;
+    RmPageHandle fetch_page_handle(int page_no, BufferAccessStrategy *strategy = nullptr) const;
 
     lsn_t get_page_lsn(page_id_t page_id);
 
    private:
-    RmPageHandle create_page_handle();
+    RmPageHandle create_page_handle(BufferAccessStrategy *strategy);
 
     void release_page_handle(RmPageHandle &page_handle);
+
+    void unpin_deleted_page(Page *page);
+
+    // slotted page格式：记录在内存中仍为定长格式，写入页面时变长字段只保存实际内容
+    int encode_record(const char *buf, char *out) const;
+
+    void decode_record(const char *data, char *out) const;
+
+    void read_slotted_record(const Rid &rid, char *out) const;
+
+    bool has_room(const RmSlottedPageHandle &page_handle) const {
+        return page_handle.free_space() >= max_encoded_size_ + (int)sizeof(RmSlot);
+    }
+
+    Rid insert_slotted(const char *data, int len, uint16_t flags, Context *context, BufferAccessStrategy *strategy);
+
+    void erase_slotted(RmSlottedPageHandle &page_handle, int slot_no);
+
+    void release_slotted_page(RmSlottedPageHandle &page_handle);
+
+    void insert_record_slotted(const Rid &rid, const char *buf);
+
+    void update_record_slotted(const Rid &rid, const char *buf, Context *context);
+
+    void delete_record_slotted(const Rid &rid, Context *context);
 };
\ No newline at end of file
@@ -33,11 +33,15 @@ class RmManager {
      * @description: 创建表的数据文件并初始化相关信息
      * @param {string&} filename 要创建的文件名称
      * @param {int} record_size 表中记录的大小
+     * @param {vector<RmVarCol>&} var_cols 变长字段在记录中的位置，按offset递增；不为空时文件使用slotted page格式
      */ 
-    void create_file(const std::string& filename, int record_size) {
+    void create_file(const std::string& filename, int record_size, const std::vector<RmVarCol> &var_cols = {}) {
         if (record_size < 1 || record_size > RM_MAX_RECORD_SIZE) {
             throw InvalidRecordSizeError(record_size);
         }
+        if (var_cols.size() > RM_MAX_VAR_COLS) {
+            throw InternalError("Too many VARCHAR columns (at most " + std::to_string(RM_MAX_VAR_COLS) + ")");
+        }
         disk_manager_->create_file(filename);
         int fd = disk_manager_->open_file(filename);
 
@@ -51,9 +55,23 @@ class RmManager {
             (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int)sizeof(RmFileHdr)) + 1) / (1 + record_size * BITMAP_WIDTH);
         file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
 
+        // slotted page格式没有bitmap，num_records_per_page为slot目录项数的上限，变长字段表紧跟文件头
+        RmVarColHdr var_col_hdr{};
+        if (!var_cols.empty()) {
+            file_hdr.bitmap_size = 0;
+            file_hdr.num_records_per_page =
+                (PAGE_SIZE - (int)Page::OFFSET_PAGE_HDR - (int)sizeof(RmSlottedPageHdr)) /
+                ((int)sizeof(RmSlot) + RmSlottedPageHandle::RM_SLOT_MIN_SIZE);
+            var_col_hdr.num_var_cols = var_cols.size();
+            std::copy(var_cols.begin(), var_cols.end(), var_col_hdr.var_cols);
+        }
+        char buf[sizeof(RmFileHdr) + sizeof(RmVarColHdr)];
+        memcpy(buf, &file_hdr, sizeof(file_hdr));
+        memcpy(buf + sizeof(file_hdr), &var_col_hdr, sizeof(var_col_hdr));
+
         // 将file header写入磁盘文件（名为file name，文件描述符为fd）中的第0页
         // head page直接写入磁盘，没有经过缓冲区的NewPage，那么也就不需要FlushPage
-        disk_manager_->write_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr, sizeof(file_hdr));
+        disk_manager_->write_page(fd, RM_FILE_HDR_PAGE, buf, var_cols.empty() ? sizeof(file_hdr) : sizeof(buf));
         disk_manager_->close_file(fd);
     }
 
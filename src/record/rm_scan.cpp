@@ -19,8 +19,30 @@ RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
     // Todo:
     // 初始化file_handle和rid（指向第一个存放了记录的位置）
 
-    rid_ = Rid {.page_no = RM_FIRST_RECORD_PAGE, .slot_no = -1};
-    next();
+    rid_ = Rid {.page_no = RM_FILE_HDR_PAGE, .slot_no = -1};
+    // 大表的顺序扫描使用环形缓冲区，避免把缓冲池中的热点页面逐出
+    auto bpm = file_handle_->buffer_pool_manager_;
+    if (static_cast<size_t>(file_handle_->file_hdr_.num_pages) > bpm->get_pool_size() / BUFFER_RING_SCAN_THRESHOLD) {
+        strategy_ = std::make_unique<BufferAccessStrategy>(BUFFER_RING_BULK_READ_SIZE);
+    }
+    next_page();
+}
+
+RmScan::~RmScan() {
+    release_page();
+}
+
+/**
+ * @brief unpin当前页面
+ */
+void RmScan::release_page() {
+    if (page_ != nullptr) {
+        file_handle_->buffer_pool_manager_->unpin_page(page_, false);
+        page_ = nullptr;
+        page_slots_ = nullptr;
+    }
+    slots_.clear();
+    pos_ = 0;
 }
 
 /**
@@ -30,25 +52,95 @@ void RmScan::next() {
     // Todo:
     // 找到文件中下一个存放了记录的非空闲位置，用rid_来指向这个位置
 
-    while (rid_.page_no < file_handle_->file_hdr_.num_pages) {
-        // 当前指向的页面的handle
-        auto page_handle = file_handle_->fetch_page_handle(rid_.page_no);
-        // 当前页的第一个record
-        rid_.slot_no = Bitmap::next_bit(
-            true,
-            page_handle.bitmap,
-            file_handle_->file_hdr_.num_records_per_page,
-            rid_.slot_no
-        );
-        // unpin 当前的页面
-        file_handle_->buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
-        // 若在当前页面搜索到记录 返回
-        if (rid_.slot_no < file_handle_->file_hdr_.num_records_per_page)
-            return;
-        // 进入下一页
-        rid_ = {rid_.page_no + 1, -1};
+    if (is_end())
+        return;
+    // 当前页面中还有记录，不需要访问缓冲池
+    if (++pos_ < slots_.size()) {
+        rid_.slot_no = slots_[pos_];
+        return;
+    }
+    next_page();
+}
+
+/**
+ * @brief 进入文件中下一个存放了记录的页面：unpin当前页面，pin住下一个页面并一次取出其上所有记录的slot号
+ * @return 到达文件末尾时返回false
+ */
+bool RmScan::next_page() {
+    release_page();
+    if (rid_.page_no == RM_NO_PAGE)
+        return false;
+
+    const int num_records_per_page = file_handle_->file_hdr_.num_records_per_page;
+    for (int page_no = rid_.page_no + 1; page_no < file_handle_->file_hdr_.num_pages; page_no++) {
+        // 进入新的页面时检测顺序访问，异步预读之后的页面
+        file_handle_->buffer_pool_manager_->read_ahead(file_handle_->fd_, page_no, strategy_.get());
+        auto page_handle = file_handle_->fetch_page_handle(page_no, strategy_.get());
+        if (file_handle_->is_slotted()) {
+            if (load_slotted_page(page_handle)) {
+                rid_ = {.page_no = page_no, .slot_no = slots_[0]};
+                return true;
+            }
+            continue;
+        }
+        Bitmap::set_positions(page_handle.bitmap, num_records_per_page, slots_);
+        // 空页面直接unpin，进入下一页
+        if (slots_.empty()) {
+            file_handle_->buffer_pool_manager_->unpin_page(page_handle.page, false);
+            continue;
+        }
+        page_ = page_handle.page;
+        page_slots_ = page_handle.slots;
+        rid_ = {.page_no = page_no, .slot_no = slots_[0]};
+        return true;
     }
     rid_ = {.page_no = RM_NO_PAGE, .slot_no = -1};
+    return false;
+}
+
+/**
+ * @brief 一次解码slotted page上的所有记录，已迁移的记录经由转发桩读取，迁入的记录跳过；解码后unpin页面
+ * @return 页面上是否有记录
+ */
+bool RmScan::load_slotted_page(RmPageHandle &page_handle) {
+    RmSlottedPageHandle slotted_page_handle(page_handle.page);
+    const int num_slots = slotted_page_handle.page_hdr->num_slots;
+    for (int slot_no = 0; slot_no < num_slots; slot_no++) {
+        if (slotted_page_handle.is_used(slot_no) && !(slotted_page_handle.slots[slot_no].flags & RM_SLOT_MOVED)) {
+            slots_.push_back(slot_no);
+        }
+    }
+    const int record_size = file_handle_->file_hdr_.record_size;
+    decoded_.resize(slots_.size() * record_size);
+    slot_pos_.assign(num_slots, -1);
+    for (size_t i = 0; i < slots_.size(); i++) {
+        int slot_no = slots_[i];
+        slot_pos_[slot_no] = i;
+        char *out = decoded_.data() + i * record_size;
+        if (slotted_page_handle.slots[slot_no].flags & RM_SLOT_FORWARD) {
+            Rid target;
+            memcpy(&target, slotted_page_handle.get_record(slot_no), sizeof(Rid));
+            RmSlottedPageHandle target_handle(file_handle_->fetch_page_handle(target.page_no, strategy_.get()).page);
+            file_handle_->decode_record(target_handle.get_record(target.slot_no), out);
+            file_handle_->buffer_pool_manager_->unpin_page(target_handle.page, false);
+        } else {
+            file_handle_->decode_record(slotted_page_handle.get_record(slot_no), out);
+        }
+    }
+    file_handle_->buffer_pool_manager_->unpin_page(page_handle.page, false);
+    page_slots_ = decoded_.data();
+    return !slots_.empty();
+}
+
+/**
+ * @brief 当前页面上slot_no处记录的数据
+ */
+const char *RmScan::get_record(int slot_no) const {
+    const int record_size = file_handle_->file_hdr_.record_size;
+    if (file_handle_->is_slotted()) {
+        return page_slots_ + slot_pos_[slot_no] * record_size;
+    }
+    return page_slots_ + slot_no * record_size;
 }
 
 /**
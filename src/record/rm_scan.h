@@ -10,21 +10,52 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "rm_defs.h"
 
 class RmFileHandle;
+struct RmPageHandle;
 
 class RmScan : public RecScan {
     static constexpr int RM_FIRST_PAGE = 1;
     const RmFileHandle *file_handle_;
     Rid rid_;
     int num_records_per_page_;
+    // 表的页面数超过缓冲池帧数的1/BUFFER_RING_SCAN_THRESHOLD时，扫描读入的页面只在这一环形缓冲区中复用
+    std::unique_ptr<BufferAccessStrategy> strategy_;
+    // 扫描按页面进行：当前页面在扫描期间保持pin，slots_为页面上所有存放了记录的slot号，pos_为逐条迭代的位置
+    Page *page_ = nullptr;
+    const char *page_slots_ = nullptr;  // 当前页面中slot区域的首地址
+    std::vector<int> slots_;
+    size_t pos_ = 0;
+    // slotted page格式的表：页面中的记录解码到decoded_中后即unpin页面，slot_pos_[slot_no]为记录在decoded_中的序号
+    std::vector<char> decoded_;
+    std::vector<int> slot_pos_;
+
+    bool load_slotted_page(RmPageHandle &page_handle);
+
+    void release_page();
 public:
     RmScan(const RmFileHandle *file_handle);
 
+    ~RmScan() override;
+
     void next() override;
 
     bool is_end() const override;
 
     Rid rid() const override;
+
+    bool next_page();
+
+    int page_no() const { return rid_.page_no; }
+
+    // 当前页面上所有存放了记录的slot号，按slot号递增
+    const std::vector<int> &slots() const { return slots_; }
+
+    // 当前页面上slot_no处记录的数据，在调用next_page()之前有效
+    // 定长格式的表直接指向扫描pin住的页面，slotted page格式的表指向解码后的副本
+    const char *get_record(int slot_no) const;
 };
@@ -0,0 +1,144 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#include "rm_slotted_page.h"
+
+/**
+ * @description: 初始化一个空的slotted page
+ */
+void RmSlottedPageHandle::init() {
+    *page_hdr = RmSlottedPageHdr{
+        .next_free_page_no = RM_NO_PAGE,
+        .num_records = 0,
+        .num_slots = 0,
+        .heap_begin = static_cast<uint16_t>(PAGE_SIZE),
+        .garbage = 0,
+        .on_free_list = 0,
+        .reserved = {},
+    };
+}
+
+/**
+ * @description: 在堆中分配空间，连续空间不够但整理后足够时先整理页面
+ * @param {int} len 记录长度
+ * @param {int} extra_dir_bytes 同时需要为slot目录增加的字节数
+ * @return {int} 分配到的偏移，空间不足时返回0
+ */
+int RmSlottedPageHandle::alloc(int len, int extra_dir_bytes) {
+    int need = alloc_size(len);
+    if (page_hdr->heap_begin - dir_end() - extra_dir_bytes < need) {
+        if (free_space() - extra_dir_bytes < need) {
+            return 0;
+        }
+        compact();
+    }
+    page_hdr->heap_begin -= need;
+    return page_hdr->heap_begin;
+}
+
+/**
+ * @description: 将所有记录紧密排列到页面末尾，回收已释放的空间
+ */
+void RmSlottedPageHandle::compact() {
+    char buf[MAX_PAGE_SIZE];
+    int heap_begin = PAGE_SIZE;
+    for (int i = 0; i < page_hdr->num_slots; i++) {
+        if (slots[i].offset == 0) {
+            continue;
+        }
+        int size = alloc_size(slots[i].len);
+        heap_begin -= size;
+        memcpy(buf + heap_begin, data + slots[i].offset, size);
+        slots[i].offset = heap_begin;
+    }
+    memcpy(data + heap_begin, buf + heap_begin, PAGE_SIZE - heap_begin);
+    page_hdr->heap_begin = heap_begin;
+    page_hdr->garbage = 0;
+}
+
+/**
+ * @description: 插入一条记录，优先复用空闲的slot目录项
+ * @return {int} 记录的slot号，空间不足时返回-1
+ */
+int RmSlottedPageHandle::insert(const char *buf, int len, uint16_t flags) {
+    int slot_no = next_slot();
+    int offset = alloc(len, slot_no == page_hdr->num_slots ? sizeof(RmSlot) : 0);
+    if (offset == 0) {
+        return -1;
+    }
+    if (slot_no == page_hdr->num_slots) {
+        page_hdr->num_slots++;
+    }
+    slots[slot_no] = RmSlot{.offset = static_cast<uint16_t>(offset), .len = static_cast<uint16_t>(len), .flags = flags};
+    memcpy(data + offset, buf, len);
+    page_hdr->num_records++;
+    return slot_no;
+}
+
+/**
+ * @description: 在指定的空闲slot上插入一条记录，slot号超出目录时扩展目录
+ * @return {bool} 空间不足时返回false
+ */
+bool RmSlottedPageHandle::insert_at(int slot_no, const char *buf, int len, uint16_t flags) {
+    int extra_slots = slot_no >= page_hdr->num_slots ? slot_no + 1 - page_hdr->num_slots : 0;
+    int offset = alloc(len, extra_slots * sizeof(RmSlot));
+    if (offset == 0) {
+        return false;
+    }
+    while (page_hdr->num_slots <= slot_no) {
+        slots[page_hdr->num_slots++] = RmSlot{.offset = 0, .len = 0, .flags = 0};
+    }
+    slots[slot_no] = RmSlot{.offset = static_cast<uint16_t>(offset), .len = static_cast<uint16_t>(len), .flags = flags};
+    memcpy(data + offset, buf, len);
+    page_hdr->num_records++;
+    return true;
+}
+
+/**
+ * @description: 替换slot上的记录，新记录不比原来的大时原地改写，否则在本页面的堆中重新分配
+ * @return {bool} 本页面放不下新记录时返回false，原记录保持不变
+ */
+bool RmSlottedPageHandle::replace(int slot_no, const char *buf, int len, uint16_t flags) {
+    RmSlot &slot = slots[slot_no];
+    int old_size = alloc_size(slot.len);
+    if (alloc_size(len) <= old_size) {
+        page_hdr->garbage += old_size - alloc_size(len);
+        slot.len = len;
+        slot.flags = flags;
+        memcpy(data + slot.offset, buf, len);
+        return true;
+    }
+    // 先释放原记录再分配，整理页面时原记录不会被保留；alloc只在能分配成功时才整理页面，失败时可以直接恢复
+    uint16_t old_offset = slot.offset;
+    slot.offset = 0;
+    page_hdr->garbage += old_size;
+    int offset = alloc(len, 0);
+    if (offset == 0) {
+        slot.offset = old_offset;
+        page_hdr->garbage -= old_size;
+        return false;
+    }
+    slot = RmSlot{.offset = static_cast<uint16_t>(offset), .len = static_cast<uint16_t>(len), .flags = flags};
+    memcpy(data + offset, buf, len);
+    return true;
+}
+
+/**
+ * @description: 删除slot上的记录，目录末尾的空闲项一并收回
+ */
+void RmSlottedPageHandle::erase(int slot_no) {
+    page_hdr->garbage += alloc_size(slots[slot_no].len);
+    slots[slot_no] = RmSlot{.offset = 0, .len = 0, .flags = 0};
+    page_hdr->num_records--;
+    while (page_hdr->num_slots > 0 && slots[page_hdr->num_slots - 1].offset == 0) {
+        page_hdr->num_slots--;
+    }
+}
@@ -0,0 +1,68 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#pragma once
+
+#include "rm_defs.h"
+
+/* 对slotted page格式的页面进行封装：页头之后为slot目录，记录从页面末尾向前存放
+ * 每条记录至少占用RM_SLOT_MIN_SIZE字节，使记录总能原地改写为转发桩 */
+struct RmSlottedPageHandle {
+    static constexpr int RM_SLOT_MIN_SIZE = sizeof(Rid);
+
+    Page *page;
+    char *data;                   // 页面数据的首地址，slot中的offset相对于这里
+    RmSlottedPageHdr *page_hdr;
+    RmSlot *slots;                // slot目录的首地址
+
+    explicit RmSlottedPageHandle(Page *page_) : page(page_) {
+        data = page->get_data();
+        page_hdr = reinterpret_cast<RmSlottedPageHdr *>(data + page->OFFSET_PAGE_HDR);
+        slots = reinterpret_cast<RmSlot *>(data + page->OFFSET_PAGE_HDR + sizeof(RmSlottedPageHdr));
+    }
+
+    void init();
+
+    bool is_used(int slot_no) const {
+        return slot_no >= 0 && slot_no < page_hdr->num_slots && slots[slot_no].offset != 0;
+    }
+
+    const char *get_record(int slot_no) const { return data + slots[slot_no].offset; }
+
+    // 下一次insert使用的slot号
+    int next_slot() const {
+        int slot_no = 0;
+        while (slot_no < page_hdr->num_slots && slots[slot_no].offset != 0) {
+            slot_no++;
+        }
+        return slot_no;
+    }
+
+    // 整理页面后可以分配给记录的字节数，不包括新增slot目录项占用的空间
+    int free_space() const { return page_hdr->heap_begin - dir_end() + page_hdr->garbage; }
+
+    int insert(const char *buf, int len, uint16_t flags);
+
+    bool insert_at(int slot_no, const char *buf, int len, uint16_t flags);
+
+    bool replace(int slot_no, const char *buf, int len, uint16_t flags);
+
+    void erase(int slot_no);
+
+    static int alloc_size(int len) { return len < RM_SLOT_MIN_SIZE ? RM_SLOT_MIN_SIZE : len; }
+
+   private:
+    int dir_end() const { return (int)(reinterpret_cast<char *>(slots + page_hdr->num_slots) - data); }
+
+    int alloc(int len, int extra_dir_bytes);
+
+    void compact();
+};
@@ -50,3 +50,20 @@ void LogManager::flush_log_to_disk() {
     log_buffer_.offset_ = 0;
     persist_lsn_ = global_lsn_ - 1;
 }
+
+/**
+ * @description: 保证lsn及之前的日志已经落盘，缓冲池写回页面之前调用。已经落盘或缓冲区为空时直接返回
+ * @param {lsn_t} lsn 将要写回的页面中最大的页面lsn
+ */
+void LogManager::flush_log_to_disk(lsn_t lsn) {
+    if (lsn <= persist_lsn_) {
+        return;
+    }
+    std::scoped_lock lock{latch_};
+    if (log_buffer_.offset_ == 0) {
+        return;
+    }
+    disk_manager_->write_log(log_buffer_.buffer_, log_buffer_.offset_);
+    log_buffer_.offset_ = 0;
+    persist_lsn_ = global_lsn_ - 1;
+}
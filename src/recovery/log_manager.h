@@ -337,6 +337,7 @@ public:
 
     lsn_t add_log_to_buffer(LogRecord* log_record);
     void flush_log_to_disk();
+    void flush_log_to_disk(lsn_t lsn);
 
     LogBuffer* get_log_buffer() { return &log_buffer_; }
 
@@ -344,6 +345,6 @@ private:
     std::atomic<lsn_t> global_lsn_{0};  // 全局lsn，递增，用于为每条记录分发lsn
     std::mutex latch_;                  // 用于对log_buffer_的互斥访问
     LogBuffer log_buffer_;              // 日志缓冲区
-    lsn_t persist_lsn_;                 // 记录已经持久化到磁盘中的最后一条日志的日志号
+    std::atomic<lsn_t> persist_lsn_{INVALID_LSN};  // 记录已经持久化到磁盘中的最后一条日志的日志号
     DiskManager* disk_manager_;
 }; 
@@ -0,0 +1,109 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "clock_replacer.h"
+
+#include <algorithm>
+
+ClockReplacer::ClockReplacer(size_t num_pages, frame_id_t first_frame_id)
+    : num_pages_(num_pages), first_frame_id_(first_frame_id), states_(new std::atomic<uint8_t>[num_pages]) {
+    for (size_t i = 0; i < num_pages_; i++) {
+        states_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+ClockReplacer::~ClockReplacer() = default;
+
+/**
+ * @description: 使用CLOCK-sweep策略淘汰一个frame，并返回该frame的id
+ * 每个可淘汰帧最多被扫过MAX_USAGE_COUNT + 2次就会被淘汰，扫过一整圈都没有可淘汰帧时返回false
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool ClockReplacer::victim(frame_id_t *frame_id) {
+    if (num_pages_ == 0) {
+        return false;
+    }
+    size_t num_evictable = 0;   // 当前这一圈中遇到的可淘汰帧数
+    size_t swept = 0;           // 当前这一圈中已经扫过的帧数
+    while (true) {
+        size_t index = hand_.fetch_add(1, std::memory_order_relaxed) % num_pages_;
+        auto &state = states_[index];
+        uint8_t cur = state.load(std::memory_order_relaxed);
+        while (cur & EVICTABLE) {
+            uint8_t next;
+            if (cur & REFERENCED) {
+                // 被访问过的帧再得到一次机会，访问记入使用计数
+                uint8_t usage = std::min<uint8_t>((cur & USAGE_MASK) + 1, MAX_USAGE_COUNT);
+                next = EVICTABLE | usage;
+            } else if (cur & USAGE_MASK) {
+                next = cur - 1;
+            } else {
+                next = 0;   // 淘汰，之后该帧处于固定状态
+            }
+            if (state.compare_exchange_weak(cur, next, std::memory_order_acq_rel)) {
+                if (next == 0) {
+                    *frame_id = first_frame_id_ + static_cast<frame_id_t>(index);
+                    return true;
+                }
+                num_evictable++;
+                break;
+            }
+        }
+        if (++swept == num_pages_) {
+            if (num_evictable == 0) {
+                return false;
+            }
+            num_evictable = 0;
+            swept = 0;
+        }
+    }
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰，只清除帧的可淘汰标志
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void ClockReplacer::pin(frame_id_t frame_id) {
+    get_state(frame_id).fetch_and(static_cast<uint8_t>(~EVICTABLE), std::memory_order_acq_rel);
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰，同时置位引用位，由时钟指针将其记入使用计数
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void ClockReplacer::unpin(frame_id_t frame_id) {
+    get_state(frame_id).fetch_or(EVICTABLE | REFERENCED, std::memory_order_acq_rel);
+}
+
+/**
+ * @description: 取消固定一个frame，不置引用位且使用计数清零，时钟指针下一次经过时即被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void ClockReplacer::unpin_cold(frame_id_t frame_id) { get_state(frame_id).store(EVICTABLE, std::memory_order_release); }
+
+/**
+ * @description: 帧中的页面被删除，清除可淘汰标志、引用位和使用计数
+ * @param {frame_id_t} frame_id 目标帧的id
+ */
+void ClockReplacer::remove(frame_id_t frame_id) { get_state(frame_id).store(0, std::memory_order_release); }
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t ClockReplacer::Size() {
+    size_t size = 0;
+    for (size_t i = 0; i < num_pages_; i++) {
+        if (states_[i].load(std::memory_order_relaxed) & EVICTABLE) {
+            size++;
+        }
+    }
+    return size;
+}
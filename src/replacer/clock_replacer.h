@@ -0,0 +1,61 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+ClockReplacer实现了CLOCK-sweep替换策略
+每个帧有一个原子状态字，包含可淘汰标志、引用位和使用计数。pin和unpin各是一次原子操作，不需要加锁；
+victim时时钟指针扫过各个帧：引用位被置位的帧清除引用位并增加使用计数，使用计数大于0的帧减少使用计数，
+遇到可淘汰、引用位为0且使用计数为0的帧时将其淘汰
+*/
+class ClockReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的ClockReplacer
+     * @param {size_t} num_pages ClockReplacer管理的帧的数量
+     * @param {frame_id_t} first_frame_id 管理的第一个帧的id，管理的帧为[first_frame_id, first_frame_id + num_pages)
+     */
+    explicit ClockReplacer(size_t num_pages, frame_id_t first_frame_id = 0);
+
+    ~ClockReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void unpin_cold(frame_id_t frame_id);
+
+    void remove(frame_id_t frame_id);
+
+    size_t Size();
+
+    static constexpr uint8_t MAX_USAGE_COUNT = CLOCK_MAX_USAGE_COUNT;
+
+   private:
+    static constexpr uint8_t EVICTABLE = 0x80;      // 帧未被固定，可以被淘汰
+    static constexpr uint8_t REFERENCED = 0x40;     // 帧在时钟指针上次经过之后被访问过
+    static constexpr uint8_t USAGE_MASK = 0x3f;     // 使用计数
+
+    std::atomic<uint8_t> &get_state(frame_id_t frame_id) { return states_[frame_id - first_frame_id_]; }
+
+    size_t num_pages_;
+    frame_id_t first_frame_id_;
+    std::unique_ptr<std::atomic<uint8_t>[]> states_;    // 每个帧的状态字
+    std::atomic<size_t> hand_{0};                       // 时钟指针，单调递增，对num_pages_取模得到帧的下标
+};
@@ -0,0 +1,124 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "lru_k_replacer.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, frame_id_t first_frame_id, size_t k, uint64_t correlated_period)
+    : first_frame_id_(first_frame_id), k_(k), correlated_period_(correlated_period), frames_(num_pages) {}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+LRUKReplacer::EvictKey LRUKReplacer::get_key(frame_id_t frame_id) const {
+    const auto &info = frames_[frame_id - first_frame_id_];
+    if (info.history.size() < k_) {
+        return {false, info.history.empty() ? 0 : info.history.back(), frame_id};
+    }
+    return {true, info.history[k_ - 1], frame_id};
+}
+
+/**
+ * @description: 使用LRU-K策略淘汰一个frame，并清空其访问历史
+ * 优先选择不在相关访问期内的帧，所有可淘汰帧都在相关访问期内时按排序键淘汰
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool LRUKReplacer::victim(frame_id_t *frame_id) {
+    std::scoped_lock lock{latch_};
+    if (evictable_.empty()) {
+        return false;
+    }
+    auto target = evictable_.begin();
+    for (auto it = evictable_.begin(); it != evictable_.end(); ++it) {
+        if (current_time_ - get_info(std::get<2>(*it)).last_access > correlated_period_) {
+            target = it;
+            break;
+        }
+    }
+    *frame_id = std::get<2>(*target);
+    evictable_.erase(target);
+    auto &info = get_info(*frame_id);
+    info.history.clear();
+    info.evictable = false;
+    return true;
+}
+
+/**
+ * @description: 固定指定的frame，并记录一次访问
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void LRUKReplacer::pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto &info = get_info(frame_id);
+    if (info.evictable) {
+        evictable_.erase(get_key(frame_id));
+        info.evictable = false;
+    }
+    uint64_t now = ++current_time_;
+    // 相关访问只更新最近访问时间，不计入访问历史
+    if (info.history.empty() || now - info.last_access > correlated_period_) {
+        info.history.insert(info.history.begin(), now);
+        if (info.history.size() > k_) {
+            info.history.pop_back();
+        }
+    }
+    info.last_access = now;
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void LRUKReplacer::unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto &info = get_info(frame_id);
+    if (!info.evictable) {
+        info.evictable = true;
+        evictable_.insert(get_key(frame_id));
+    }
+}
+
+/**
+ * @description: 取消固定一个frame并丢弃其访问历史，使其K-distance为无穷大且最早一次访问的时间为0，
+ * 不在相关访问期内，下一次victim时最先被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void LRUKReplacer::unpin_cold(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto &info = get_info(frame_id);
+    if (info.evictable) {
+        evictable_.erase(get_key(frame_id));
+    }
+    info.history.clear();
+    info.last_access = 0;
+    info.evictable = true;
+    evictable_.insert(get_key(frame_id));
+}
+
+/**
+ * @description: 帧中的页面被删除，帧不可被淘汰并清空其访问历史
+ * @param {frame_id_t} frame_id 目标帧的id
+ */
+void LRUKReplacer::remove(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto &info = get_info(frame_id);
+    if (info.evictable) {
+        evictable_.erase(get_key(frame_id));
+        info.evictable = false;
+    }
+    info.history.clear();
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t LRUKReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return evictable_.size();
+}
@@ -0,0 +1,76 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+LRUKReplacer实现了LRU-K替换策略
+每次pin记为对帧的一次访问，淘汰倒数第K次访问最早（backward K-distance最大）的帧；
+访问不足K次的帧的K-distance为无穷大，优先淘汰，其中最早被访问的先淘汰。
+一次全表扫描中每个页面只被访问一次，因此扫描的页面先于被多次访问的热点页面（如索引内部结点）被淘汰。
+与上一次访问间隔不超过correlated_period的访问视为相关访问（如扫描逐条记录地访问同一页面），不计入访问历史，
+且在这一期间内帧尽量不被淘汰
+*/
+class LRUKReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的LRUKReplacer
+     * @param {size_t} num_pages LRUKReplacer管理的帧的数量
+     * @param {frame_id_t} first_frame_id 管理的第一个帧的id，管理的帧为[first_frame_id, first_frame_id + num_pages)
+     * @param {size_t} k 计算K-distance时使用的访问次数
+     * @param {uint64_t} correlated_period 相关访问期，以该replacer上的访问次数计
+     */
+    LRUKReplacer(size_t num_pages, frame_id_t first_frame_id = 0, size_t k = LRUK_DEFAULT_K,
+                 uint64_t correlated_period = LRUK_CORRELATED_PERIOD);
+
+    ~LRUKReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void unpin_cold(frame_id_t frame_id);
+
+    void remove(frame_id_t frame_id);
+
+    size_t Size();
+
+   private:
+    struct FrameInfo {
+        std::vector<uint64_t> history;  // 最近K次非相关访问的时间，最近的在前
+        uint64_t last_access = 0;       // 最近一次访问（包括相关访问）的时间
+        bool evictable = false;
+    };
+
+    // 可淘汰帧的排序键：访问不足K次的帧在前，按最早一次访问排序；其余按倒数第K次访问排序
+    using EvictKey = std::tuple<bool, uint64_t, frame_id_t>;
+
+    EvictKey get_key(frame_id_t frame_id) const;
+
+    FrameInfo &get_info(frame_id_t frame_id) { return frames_[frame_id - first_frame_id_]; }
+
+    std::mutex latch_;                  // 互斥锁
+    frame_id_t first_frame_id_;
+    size_t k_;
+    uint64_t correlated_period_;
+    uint64_t current_time_ = 0;         // 逻辑时钟，每次访问加1
+    std::vector<FrameInfo> frames_;     // 每个帧的访问历史
+    std::set<EvictKey> evictable_;      // 按淘汰顺序排列的可淘汰帧
+};
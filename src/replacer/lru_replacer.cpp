@@ -89,6 +89,20 @@ void LRUReplacer::unpin(frame_id_t frame_id) {
     }
 }
 
+/**
+ * @description: 取消固定一个frame并将其放在链表尾部，下一次victim时最先被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void LRUReplacer::unpin_cold(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    auto it = LRUhash_.find(frame_id);
+    if (it != LRUhash_.end()) {
+        LRUlist_.erase(it->second);
+    }
+    LRUlist_.push_back(frame_id);
+    LRUhash_[frame_id] = std::prev(LRUlist_.end());
+}
+
 /**
  * @description: 获取当前replacer中可以被淘汰的页面数量
  */
@@ -39,6 +39,20 @@ class Replacer {
      */
     virtual void unpin(frame_id_t frame_id) = 0;
 
+    /**
+     * Unpins a frame as the coldest frame in the replacer, so that it is victimized before frames unpinned
+     * normally. Used for the pages of low-priority files.
+     * @param frame_id the id of the frame to unpin
+     */
+    virtual void unpin_cold(frame_id_t frame_id) { unpin(frame_id); }
+
+    /**
+     * Removes a frame whose page has been deleted from the buffer pool, the frame is not evictable afterwards
+     * and any access history kept for it is discarded.
+     * @param frame_id the id of the frame to remove
+     */
+    virtual void remove(frame_id_t frame_id) { pin(frame_id); }
+
     /** @return the number of elements in the replacer that can be victimized */
     virtual size_t Size() = 0;
 };
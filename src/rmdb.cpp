@@ -57,6 +57,7 @@ static jmp_buf jmpbuf;
 void sigint_handler(int signo) {
     should_exit = true;
     log_manager->flush_log_to_disk();
+    buffer_pool_manager->stop_bg_writer();
 	sm_manager->close_db();
     std::cout << "The Server receive Crtl+C, will been closed\n";
     longjmp(jmpbuf, 1);
@@ -294,19 +295,95 @@ void start_server() {
     int ret = shutdown(sockfd_server, SHUT_WR);  // shut down the all or part of a full-duplex connection.
     if(ret == -1) { printf("%s\n", strerror(errno)); }
 //    assert(ret != -1);
+    buffer_pool_manager->stop_bg_writer();
     sm_manager->close_db();
     std::cout << " DB has been closed.\n";
     std::cout << "Server shuts down." << std::endl;
 }
 
+static void print_usage(const char *prog) {
+    std::cerr << "Usage: " << prog << " [options] <database>\n"
+              << "Options:\n"
+              << "    --direct-io    open table and index files of a newly created database with O_DIRECT to bypass\n"
+              << "                   the OS page cache; an existing database keeps the I/O mode it was created with\n"
+              << "    --tablespace   store all table and index files of a newly created database in shared segment\n"
+              << "                   files; an existing database keeps the storage mode it was created with\n"
+              << "    --page-size <bytes>\n"
+              << "                   page size of a newly created database: 4096, 8192, 16384 or 32768\n"
+              << "                   (default 4096); an existing database keeps the page size it was created with\n"
+              << "    --replacer <CLOCK|LRU|LRU-K|LRU-<K>>\n"
+              << "                   buffer pool replacement policy (default " << REPLACER_TYPE << ")\n"
+              << "    --buffer-pool-size <bytes>[K|M|G]\n"
+              << "                   buffer pool memory (default " << (BUFFER_POOL_SIZE * DEFAULT_PAGE_SIZE >> 20)
+              << "M); can be changed online with SET buffer_pool_size = <MB>"
+              << std::endl;
+}
+
+// 解析带K、M、G后缀的字节数，格式错误时返回0
+static size_t parse_size(const std::string &arg) {
+    char *end = nullptr;
+    unsigned long long size = strtoull(arg.c_str(), &end, 10);
+    std::string suffix = end;
+    if (end == arg.c_str() || suffix.size() > 1) {
+        return 0;
+    }
+    if (suffix == "K" || suffix == "k") {
+        size <<= 10;
+    } else if (suffix == "M" || suffix == "m") {
+        size <<= 20;
+    } else if (suffix == "G" || suffix == "g") {
+        size <<= 30;
+    } else if (!suffix.empty()) {
+        return 0;
+    }
+    return size;
+}
+
 int main(int argc, char **argv) {
-    if (argc != 2) {
+    // 解析命令行参数，最后一个非选项参数为数据库名称
+    std::string db_name;
+    int page_size = DEFAULT_PAGE_SIZE;
+    size_t buffer_pool_bytes = 0;
+    bool tablespace = false;
+    bool direct_io = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--direct-io") {
+            direct_io = true;
+        } else if (arg == "--tablespace") {
+            tablespace = true;
+        } else if (arg == "--page-size" && i + 1 < argc) {
+            page_size = atoi(argv[++i]);
+        } else if (arg == "--replacer" && i + 1 < argc) {
+            try {
+                buffer_pool_manager->set_replacer_type(argv[++i]);
+            } catch (RMDBError &e) {
+                std::cerr << e.what() << std::endl;
+                print_usage(argv[0]);
+                exit(1);
+            }
+        } else if (arg == "--buffer-pool-size" && i + 1 < argc) {
+            buffer_pool_bytes = parse_size(argv[++i]);
+            if (buffer_pool_bytes == 0) {
+                print_usage(argv[0]);
+                exit(1);
+            }
+        } else if (arg.rfind("--", 0) == 0 || !db_name.empty()) {
+            print_usage(argv[0]);
+            exit(1);
+        } else {
+            db_name = arg;
+        }
+    }
+    if (db_name.empty()) {
         // 需要指定数据库名称
-        std::cerr << "Usage: " << argv[0] << " <database>" << std::endl;
+        print_usage(argv[0]);
         exit(1);
     }
 
     signal(SIGINT, sigint_handler);
+    // 缓冲池写回页面前先将日志刷新到页面的lsn
+    buffer_pool_manager->set_log_flusher([](lsn_t lsn) { log_manager->flush_log_to_disk(lsn); });
     try {
         std::cout << "\n"
                      "  _____  __  __ _____  ____  \n"
@@ -319,19 +396,26 @@ int main(int argc, char **argv) {
                      "Welcome to RMDB!\n"
                      "Type 'help;' for help.\n"
                      "\n";
-        // Database name is passed by args
-        std::string db_name = argv[1];
         if (!sm_manager->is_dir(db_name)) {
             // Database not found, create a new one
-            sm_manager->create_db(db_name);
+            sm_manager->create_db(db_name, page_size, tablespace, direct_io);
         }
         // Open database
-        sm_manager->open_db(db_name);
+        sm_manager->open_db(db_name, tablespace, direct_io);
+        // 页面大小在打开数据库后才确定，按其将缓冲池大小换算为帧数
+        if (buffer_pool_bytes != 0) {
+            buffer_pool_manager->resize(std::max<size_t>(buffer_pool_bytes / PAGE_SIZE, 1));
+        }
 
         // recovery database
         recovery->analyze();
         recovery->redo();
         recovery->undo();
+
+        // 恢复完成后开始在后台写回脏页，并按上次关闭时转储的驻留页面列表预热缓冲池。
+        // 预热在调整缓冲池大小之后开始，调整大小需要所有帧都没有在途I/O
+        buffer_pool_manager->start_bg_writer();
+        buffer_pool_manager->start_warmup();
         
         // 开启服务端，开始接受客户端连接
         start_server();
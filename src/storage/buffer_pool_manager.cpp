@@ -10,13 +10,388 @@ See the Mulan PSL v2 for more details. */
 
 #include "buffer_pool_manager.h"
 
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+/**
+ * @description: 为帧分配匿名内存。优先使用预留的大页（MAP_HUGETLB），不可用时使用普通的匿名映射，
+ *              按大页对齐并通过madvise(MADV_HUGEPAGE)请求透明大页，以减少大缓冲池的TLB缺失。
+ *              匿名映射的内存在第一次访问时才由内核分配并清零，分配本身不触碰任何帧
+ * @return {char*} 按BUFFER_POOL_HUGE_PAGE_SIZE对齐的内存
+ * @param {size_t} bytes 需要的字节数
+ * @param {size_t*} mapped_bytes 返回实际映射的字节数，释放时传给free_frame_memory
+ */
+char *BufferPoolManager::allocate_frame_memory(size_t bytes, size_t *mapped_bytes) {
+    size_t length = (std::max<size_t>(bytes, 1) + BUFFER_POOL_HUGE_PAGE_SIZE - 1) / BUFFER_POOL_HUGE_PAGE_SIZE *
+                    BUFFER_POOL_HUGE_PAGE_SIZE;
+    void *frames = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (frames != MAP_FAILED) {
+        *mapped_bytes = length;
+        return static_cast<char *>(frames);
+    }
+
+    // 多映射一个大页，截去首尾使起始地址按大页对齐，透明大页只用于对齐的2MB区域
+    size_t padded_length = length + BUFFER_POOL_HUGE_PAGE_SIZE;
+    frames = mmap(nullptr, padded_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (frames == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    auto begin = reinterpret_cast<uintptr_t>(frames);
+    auto aligned = (begin + BUFFER_POOL_HUGE_PAGE_SIZE - 1) / BUFFER_POOL_HUGE_PAGE_SIZE * BUFFER_POOL_HUGE_PAGE_SIZE;
+    if (aligned > begin) {
+        munmap(frames, aligned - begin);
+    }
+    if (begin + padded_length > aligned + length) {
+        munmap(reinterpret_cast<void *>(aligned + length), begin + padded_length - aligned - length);
+    }
+    // 内核不支持透明大页时忽略失败，仍使用普通页面
+    madvise(reinterpret_cast<void *>(aligned), length, MADV_HUGEPAGE);
+    *mapped_bytes = length;
+    return reinterpret_cast<char *>(aligned);
+}
+
+/**
+ * @description: 释放allocate_frame_memory分配的内存
+ */
+void BufferPoolManager::free_frame_memory(char *frames, size_t mapped_bytes) {
+    if (frames != nullptr) {
+        munmap(frames, mapped_bytes);
+    }
+}
+
+/**
+ * @description: 按当前的PAGE_SIZE重新分配所有帧的数据区，并使每个Page指向自己的帧。
+ * 新的帧内存在第一次使用时才被清零，见allocate_frame_memory
+ */
+void BufferPoolManager::allocate_frames() {
+    size_t frames_bytes = 0;
+    char *frames = allocate_frame_memory(pool_size_ * PAGE_SIZE, &frames_bytes);
+    free_frame_memory(frames_, frames_bytes_);
+    frames_ = frames;
+    frames_bytes_ = frames_bytes;
+    for (size_t i = 0; i < pool_size_; ++i) {
+        pages_[i].data_ = frames_ + i * PAGE_SIZE;
+    }
+}
+
+/**
+ * @description: 切换页面大小，帧的个数不变，按新的页面大小重新分配帧内存
+ * 在打开数据库时由SmManager按db.meta中记录的页面大小调用，此时缓冲池中不能有任何页面
+ * @param {int} page_size 新的页面大小，由调用者保证是MIN_PAGE_SIZE到MAX_PAGE_SIZE之间的2的幂
+ */
+void BufferPoolManager::set_page_size(int page_size) {
+    auto locks = lock_all_shards();
+    if (page_size == PAGE_SIZE) {
+        return;
+    }
+    for (auto &shard : shards_) {
+        if (!shard->page_table.empty()) {
+            throw InternalError("BufferPoolManager::set_page_size: buffer pool is not empty");
+        }
+    }
+    PAGE_SIZE = page_size;
+    allocate_frames();
+}
+
+/**
+ * @description: 为拥有帧[begin, end)的分片创建置换策略
+ * @param {string&} replacer_type "CLOCK"、"LRU"、"LRU-K"（K为LRUK_DEFAULT_K）或"LRU-<K>"
+ */
+std::unique_ptr<Replacer> BufferPoolManager::create_replacer(const std::string &replacer_type, size_t begin,
+                                                             size_t end) {
+    if (replacer_type == "CLOCK") {
+        return std::make_unique<ClockReplacer>(end - begin, static_cast<frame_id_t>(begin));
+    } else if (replacer_type == "LRU") {
+        return std::make_unique<LRUReplacer>(end - begin);
+    } else if (replacer_type == "LRU-K") {
+        return std::make_unique<LRUKReplacer>(end - begin, static_cast<frame_id_t>(begin));
+    } else if (replacer_type.rfind("LRU-", 0) == 0 && replacer_type.size() > 4 &&
+               std::all_of(replacer_type.begin() + 4, replacer_type.end(), ::isdigit)) {
+        size_t k = std::stoul(replacer_type.substr(4));
+        if (k >= 1 && k <= 8) {
+            return std::make_unique<LRUKReplacer>(end - begin, static_cast<frame_id_t>(begin), k);
+        }
+    }
+    throw InternalError("BufferPoolManager: unknown replacer type " + replacer_type);
+}
+
+/**
+ * @description: 切换所有分片的置换策略，在启动时由rmdb按--replacer参数调用，此时缓冲池中不能有任何页面
+ * @param {string&} replacer_type 见create_replacer
+ */
+void BufferPoolManager::set_replacer_type(const std::string &replacer_type) {
+    auto locks = lock_all_shards();
+    std::vector<std::unique_ptr<Replacer>> replacers;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        if (!shards_[i]->page_table.empty()) {
+            throw InternalError("BufferPoolManager::set_replacer_type: buffer pool is not empty");
+        }
+        replacers.push_back(create_replacer(replacer_type, i * pool_size_ / shards_.size(),
+                                            (i + 1) * pool_size_ / shards_.size()));
+    }
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        shards_[i]->replacer = std::move(replacers[i]);
+    }
+    replacer_type_ = replacer_type;
+}
+
+/**
+ * @description: 在线调整缓冲池的帧数，由rmdb按--buffer-pool-size参数以及SET buffer_pool_size调用。
+ *              需要所有帧都未被固定且没有在途的I/O：反复获取所有分片的latch检查，不满足时释放latch稍后重试，
+ *              超过timeout仍不满足时放弃。分片个数不变，缩小时各分片淘汰最冷的页面，增大时保留全部页面，见resize_frames
+ * @param {size_t} pool_size 新的帧数，不少于分片个数，且帧内存不超过物理内存
+ * @param {milliseconds} timeout 等待所有页面取消固定的最长时间
+ * @note 超时抛出BufferPoolBusyError，写回被淘汰的脏页失败时缓冲池保持不变并抛出异常
+ */
+void BufferPoolManager::resize(size_t pool_size, std::chrono::milliseconds timeout) {
+    if (pool_size < shards_.size()) {
+        throw InternalError("BufferPoolManager::resize: pool size is smaller than the number of shards");
+    }
+    long phys_pages = sysconf(_SC_PHYS_PAGES);
+    if (phys_pages > 0 && pool_size * PAGE_SIZE > static_cast<size_t>(phys_pages) * sysconf(_SC_PAGESIZE)) {
+        throw InternalError("BufferPoolManager::resize: pool size exceeds physical memory");
+    }
+    std::scoped_lock resize_lock{resize_latch_};
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        {
+            auto locks = lock_all_shards();
+            // 持有所有分片的latch时不会有新的固定，所有帧都未被固定且没有在途I/O时，没有线程在访问任何帧
+            bool busy = false;
+            for (size_t frame_id = 0; frame_id < pool_size_ && !busy; ++frame_id) {
+                busy = pages_[frame_id].pin_count_ != 0 || pages_[frame_id].io_in_progress_;
+            }
+            if (!busy) {
+                if (pool_size != pool_size_) {
+                    resize_frames(pool_size);
+                }
+                return;
+            }
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            throw BufferPoolBusyError();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+/**
+ * @description: 将缓冲池调整为pool_size个帧，调用者持有所有分片的latch且所有帧都未被固定、没有在途I/O。
+ *              1. 按replacer的淘汰顺序排列各分片的页面（PINNED的页面最后），超出分片新帧数的最冷页面被淘汰，其中的脏页批量写回
+ *              2. 保留页面的数据留在帧内存中原来的位置：增大时将原来的映射整体移动到新映射的开头，不复制数据；
+ *                 缩小时只把位于新大小之外的页面复制到空出的位置，然后释放尾部的内存
+ *              3. 重新编号帧，重建各分片的页表、驻留帧链表、free_list和replacer，保留的页面按原来的冷热顺序交给replacer
+ * @param {size_t} pool_size 新的帧数
+ */
+void BufferPoolManager::resize_frames(size_t pool_size) {
+    const size_t old_size = pool_size_;
+    const size_t num_shards = shards_.size();
+    // 先分配新的描述符数组和帧内存，分配失败时缓冲池保持不变
+    auto pages = std::make_unique<Page[]>(pool_size);
+    char *frames = nullptr;
+    size_t frames_bytes = 0;
+    if (pool_size > old_size) {
+        frames = allocate_frame_memory(pool_size * PAGE_SIZE, &frames_bytes);
+    }
+
+    // 1. 按淘汰顺序（冷的在前）排列各分片的页面，replacer中没有的页面视为最冷，但PINNED的页面视为最热
+    std::vector<std::vector<frame_id_t>> orders(num_shards);
+    std::vector<frame_id_t> dirty;
+    std::vector<size_t> num_evicted(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        auto &shard = *shards_[i];
+        size_t begin = i * old_size / num_shards;
+        std::vector<bool> seen(old_size / num_shards + 1, false);
+        std::vector<frame_id_t> by_replacer;
+        frame_id_t frame_id;
+        while (by_replacer.size() < shard.page_table.size() && shard.replacer->victim(&frame_id)) {
+            auto record = shard.page_table.find(pages_[frame_id].id_);
+            if (record != shard.page_table.end() && record->second == frame_id && !seen[frame_id - begin]) {
+                seen[frame_id - begin] = true;
+                by_replacer.push_back(frame_id);
+            }
+        }
+        auto &order = orders[i];
+        std::vector<frame_id_t> pinned;
+        for (const auto &[page_id, frame_id] : shard.page_table) {
+            if (seen[frame_id - begin]) {
+                continue;
+            }
+            if (pages_[frame_id].priority_ == BufferPriority::PINNED) {
+                pinned.push_back(frame_id);
+            } else {
+                order.push_back(frame_id);
+            }
+        }
+        order.insert(order.end(), by_replacer.begin(), by_replacer.end());
+        order.insert(order.end(), pinned.begin(), pinned.end());
+        size_t capacity = (i + 1) * pool_size / num_shards - i * pool_size / num_shards;
+        num_evicted[i] = order.size() > capacity ? order.size() - capacity : 0;
+        for (size_t k = 0; k < num_evicted[i]; ++k) {
+            if (pages_[order[k]].is_dirty_) {
+                dirty.push_back(order[k]);
+            }
+        }
+    }
+
+    // 写回被淘汰的脏页，失败时恢复脏标记和replacer后放弃
+    try {
+        write_back_frames(dirty);
+    } catch (...) {
+        for (auto frame_id : dirty) {
+            pages_[frame_id].is_dirty_ = true;
+        }
+        for (size_t i = 0; i < num_shards; ++i) {
+            for (auto frame_id : orders[i]) {
+                make_evictable(*shards_[i], frame_id);
+            }
+        }
+        free_frame_memory(frames, frames_bytes);
+        throw;
+    }
+
+    // 2. 确定保留页面的数据在帧内存中的位置（槽），缩小时位于新大小之外的页面复制到新大小之内空闲的槽中
+    auto slot_of = [this](frame_id_t frame_id) {
+        return static_cast<size_t>(pages_[frame_id].data_ - frames_) / PAGE_SIZE;
+    };
+    std::vector<bool> used(std::max(old_size, pool_size), false);
+    for (size_t i = 0; i < num_shards; ++i) {
+        for (size_t k = num_evicted[i]; k < orders[i].size(); ++k) {
+            used[slot_of(orders[i][k])] = true;
+        }
+    }
+    size_t next_free = 0;
+    auto take_free_slot = [&]() {
+        while (used[next_free]) {
+            next_free++;
+        }
+        used[next_free] = true;
+        return next_free;
+    };
+    std::vector<size_t> new_slots(old_size);
+    for (size_t i = 0; i < num_shards; ++i) {
+        for (size_t k = num_evicted[i]; k < orders[i].size(); ++k) {
+            frame_id_t frame_id = orders[i][k];
+            new_slots[frame_id] = slot_of(frame_id);
+            if (new_slots[frame_id] >= pool_size) {
+                new_slots[frame_id] = take_free_slot();
+                memcpy(frames_ + new_slots[frame_id] * PAGE_SIZE, pages_[frame_id].data_, PAGE_SIZE);
+            }
+        }
+    }
+    if (frames != nullptr) {
+        // 把原来的映射移动到新映射的开头，页面数据不需要复制；映射方式不同（如大页）无法移动时逐页复制
+        void *moved = mremap(frames_, frames_bytes_, frames_bytes_, MREMAP_MAYMOVE | MREMAP_FIXED, frames);
+        if (moved == MAP_FAILED) {
+            for (size_t i = 0; i < num_shards; ++i) {
+                for (size_t k = num_evicted[i]; k < orders[i].size(); ++k) {
+                    size_t slot = new_slots[orders[i][k]];
+                    memcpy(frames + slot * PAGE_SIZE, frames_ + slot * PAGE_SIZE, PAGE_SIZE);
+                }
+            }
+            free_frame_memory(frames_, frames_bytes_);
+        }
+        frames_ = frames;
+        frames_bytes_ = frames_bytes;
+    } else {
+        size_t length = (std::max<size_t>(pool_size * PAGE_SIZE, 1) + BUFFER_POOL_HUGE_PAGE_SIZE - 1) /
+                        BUFFER_POOL_HUGE_PAGE_SIZE * BUFFER_POOL_HUGE_PAGE_SIZE;
+        if (length < frames_bytes_) {
+            munmap(frames_ + length, frames_bytes_ - length);
+            frames_bytes_ = length;
+        }
+    }
+
+    // 3. 保留的页面依次放在各分片新的帧范围的开头，其余的帧使用剩下的槽并放入free_list
+    std::vector<std::pair<size_t, size_t>> ranges(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        size_t begin = i * pool_size / num_shards;
+        ranges[i] = {begin, (i + 1) * pool_size / num_shards};
+        for (size_t k = num_evicted[i]; k < orders[i].size(); ++k) {
+            auto &old_page = pages_[orders[i][k]];
+            auto &page = pages[begin + k - num_evicted[i]];
+            page.id_ = old_page.id_;
+            page.is_dirty_ = old_page.is_dirty_.load();
+            page.data_ = frames_ + new_slots[orders[i][k]] * PAGE_SIZE;
+        }
+        for (size_t frame_id = begin + orders[i].size() - num_evicted[i]; frame_id < ranges[i].second; ++frame_id) {
+            pages[frame_id].data_ = frames_ + take_free_slot() * PAGE_SIZE;
+        }
+    }
+    delete[] pages_;
+    pages_ = pages.release();
+    pool_size_ = pool_size;
+
+    for (size_t i = 0; i < num_shards; ++i) {
+        auto &shard = *shards_[i];
+        auto [begin, end] = ranges[i];
+        shard.page_table.clear();
+        shard.file_frames.clear();
+        shard.num_pinned = 0;
+        shard.free_list.clear();
+        shard.replacer = create_replacer(replacer_type_, begin, end);
+        size_t num_kept = orders[i].size() - num_evicted[i];
+        for (size_t frame_id = begin; frame_id < end; ++frame_id) {
+            if (frame_id < begin + num_kept) {
+                shard.page_table.emplace(pages_[frame_id].id_, static_cast<frame_id_t>(frame_id));
+                link_file_frame(shard, static_cast<frame_id_t>(frame_id));
+                make_evictable(shard, static_cast<frame_id_t>(frame_id));
+            } else {
+                shard.free_list.push_back(static_cast<frame_id_t>(frame_id));
+            }
+        }
+    }
+}
+
+/**
+ * @description: 按分片的顺序依次锁住所有分片，用于需要遍历整个缓冲池的操作
+ * @return {vector<unique_lock<shared_mutex>>} 所有分片的排他锁，析构时释放
+ */
+std::vector<std::unique_lock<std::shared_mutex>> BufferPoolManager::lock_all_shards() {
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    locks.reserve(shards_.size());
+    for (auto &shard : shards_) {
+        locks.emplace_back(shard->latch);
+    }
+    return locks;
+}
+
 /**
- * @description: 从free_list或replacer中得到可淘汰帧页的 *frame_id。
+ * @description: 从分片的free_list或replacer中得到可淘汰帧页的 *frame_id。
+ *              指定了访问策略时，若策略的环已满且环中下一个帧仍是本策略读入的未固定页面，则直接复用该帧；
+ *              否则按常规方式得到一个帧并将其加入环中，替换环中无法复用的帧。
+ *              文件达到max_buffer_pct规定的配额时复用该文件自己的帧，见find_quota_victim
  * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
+ * @param {Shard&} shard 页面所属的分片，调用者需持有其latch
+ * @param {int} fd 要读入的页面所属的文件
  * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
- * @note 涉及临界资源 {free_list_}
+ * @param {BufferAccessStrategy*} strategy 访问策略，为nullptr时使用整个分片
+ * @note 涉及临界资源 {shard.free_list}
  */
-bool BufferPoolManager::find_victim_page(frame_id_t* frame_id) {
+bool BufferPoolManager::find_victim_page(Shard &shard, int fd, frame_id_t* frame_id, BufferAccessStrategy *strategy) {
+    BufferAccessStrategy::Ring *ring = nullptr;
+    if (strategy != nullptr) {
+        ring = &strategy->get_ring(shard.id, shards_.size());
+        if (ring->frames.size() == ring->capacity) {
+            frame_id_t candidate = ring->frames[ring->next];
+            // 缓冲池调整大小后环中的帧号可能已不属于本分片，帧在此期间被其他页面占用、被固定或正在I/O时也不能复用
+            size_t begin = shard.id * pool_size_ / shards_.size();
+            size_t end = (shard.id + 1) * pool_size_ / shards_.size();
+            if (static_cast<size_t>(candidate) >= begin && static_cast<size_t>(candidate) < end &&
+                pages_[candidate].ring_id_ == strategy->id_ && pages_[candidate].pin_count_ == 0 &&
+                !pages_[candidate].io_in_progress_) {
+                shard.replacer->remove(candidate);
+                ring->next = (ring->next + 1) % ring->capacity;
+                *frame_id = candidate;
+                return true;
+            }
+        }
+    }
+
     // Todo:
     // 1 使用BufferPoolManager::free_list_判断缓冲池是否已满需要淘汰页面
     // 1.1 未满获得frame
@@ -24,24 +399,52 @@ bool BufferPoolManager::find_victim_page(frame_id_t* frame_id) {
 
     // 判断是否有free frame，有则直接分配 free frame，并且无需淘汰页面
 
-    if (!free_list_.empty()) {
-        *frame_id = free_list_.front();
-        free_list_.pop_front();
-        return true; // 可替換幀查找成功
+    if (find_quota_victim(shard, fd, frame_id)) {
+        // 文件已达到配额，复用它自己的帧
+    } else if (!shard.free_list.empty()) {
+        *frame_id = shard.free_list.front();
+        shard.free_list.pop_front();
     // 已满则使用lru_replacer中的方法选择淘汰页面
     } else {
-        return replacer_->victim(frame_id);
+        // unpin_page不持有latch，pin_count_减为0和调用replacer->unpin之间帧可能被重新固定、被删除后放回free_list，
+        // replacer因此可能给出已被固定、不在页表中或正在I/O的帧。victim已将其移出replacer，跳过即可，
+        // 帧再次减为0时会重新交给replacer
+        while (true) {
+            if (!shard.replacer->victim(frame_id)) {
+                return false;
+            }
+            auto &page = pages_[*frame_id];
+            wait_pin_released(page);
+            auto record = shard.page_table.find(page.id_);
+            if (record != shard.page_table.end() && record->second == *frame_id && page.pin_count_ == 0 &&
+                !page.io_in_progress_) {
+                break;
+            }
+        }
+    }
+
+    // 将得到的帧加入访问策略的环中
+    if (ring != nullptr) {
+        if (ring->frames.size() < ring->capacity) {
+            ring->frames.push_back(*frame_id);
+        } else {
+            ring->frames[ring->next] = *frame_id;
+            ring->next = (ring->next + 1) % ring->capacity;
+        }
     }
+    return true; // 可替換幀查找成功
 }
 
 /**
  * @description: 更新页面数据, 如果为脏页则需写入磁盘，再更新为新页面，更新page元数据(data, is_dirty, page_id)和page table。
+ * 帧和新旧页面都属于同一个分片
+ * @param {Shard&} shard 帧所属的分片，调用者需持有其latch
  * @param {Page*} page 写回页指针
  * @param {PageId} new_page_id 新的page_id
  * @param {frame_id_t} new_frame_id 新的帧frame_id
- * @note 涉及临界资源 {page_table_}
+ * @note 涉及临界资源 {shard.page_table}
  */
-void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t new_frame_id) {
+void BufferPoolManager::update_page(Shard &shard, Page *page, PageId new_page_id, frame_id_t new_frame_id) {
     // Todo:
     // 1 如果是脏页，写回磁盘，并且把dirty置为false
     // 2 更新page table
@@ -51,7 +454,8 @@ void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t n
 
     // 仅对脏页执行更新数据操作
     if (page->is_dirty_) {
-        // 将脏页数据写入磁盘
+        // 将脏页数据写入磁盘，之前先将日志刷新到页面的lsn
+        flush_log_to(page->get_page_lsn());
         disk_manager_->write_page(
             page_id.fd,
             page_id.page_no,
@@ -62,132 +466,497 @@ void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t n
     }
 
     // 在页表中删去旧的页面记录
-    page_table_.erase(page->id_);
+    unlink_file_frame(shard, static_cast<frame_id_t>(page - pages_));
+    shard.page_table.erase(page->id_);
     // 若不需要将 new_page_id 插入回页表
     if (new_frame_id == INVALID_FRAME_ID)
         return;
     // 更新page元数据
     page->id_ = new_page_id;
     // 在页表中插入新的页面记录
-    page_table_.emplace(new_page_id, new_frame_id);
+    shard.page_table.emplace(new_page_id, new_frame_id);
+    link_file_frame(shard, new_frame_id);
+}
+
+/**
+ * @description: 将以id_被页表记录的帧加入id_.fd在分片中的驻留帧链表
+ * @param {Shard&} shard 帧所属的分片，调用者需持有其latch
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void BufferPoolManager::link_file_frame(Shard &shard, frame_id_t frame_id) {
+    auto &page = pages_[frame_id];
+    auto &file = shard.file_frames[page.id_.fd];
+    page.file_prev_ = INVALID_FRAME_ID;
+    page.file_next_ = file.head;
+    if (file.head != INVALID_FRAME_ID) {
+        pages_[file.head].file_prev_ = frame_id;
+    } else {
+        file.tail = frame_id;
+    }
+    file.head = frame_id;
+    file.count++;
+    page.priority_ = BufferPriority::NORMAL;
+    set_frame_priority(shard, frame_id, get_file_policy(page.id_.fd).priority);
+}
+
+/**
+ * @description: 将帧从id_.fd在分片中的驻留帧链表中移除，在帧的id_不再被页表记录之前调用
+ * @param {Shard&} shard 帧所属的分片，调用者需持有其latch
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void BufferPoolManager::unlink_file_frame(Shard &shard, frame_id_t frame_id) {
+    auto &page = pages_[frame_id];
+    auto file = shard.file_frames.find(page.id_.fd);
+    if (--file->second.count == 0) {
+        shard.file_frames.erase(file);
+    } else {
+        if (page.file_prev_ != INVALID_FRAME_ID) {
+            pages_[page.file_prev_].file_next_ = page.file_next_;
+        } else {
+            file->second.head = page.file_next_;
+        }
+        if (page.file_next_ != INVALID_FRAME_ID) {
+            pages_[page.file_next_].file_prev_ = page.file_prev_;
+        } else {
+            file->second.tail = page.file_prev_;
+        }
+    }
+    page.file_prev_ = page.file_next_ = INVALID_FRAME_ID;
+    if (page.priority_ == BufferPriority::PINNED) {
+        shard.num_pinned--;
+    }
+    page.priority_ = BufferPriority::NORMAL;
+}
+
+/**
+ * @description: 遍历fd在各分片中的驻留帧，只访问该文件的帧，不遍历页表
+ * @param {int} fd 目标文件
+ * @param {Func&&} func 对每个帧调用func(Shard&, frame_id_t)，调用者需持有所有分片的latch，func中不能修改链表
+ */
+template <typename Func>
+void BufferPoolManager::for_each_file_frame(int fd, Func &&func) {
+    for (auto &shard : shards_) {
+        auto file = shard->file_frames.find(fd);
+        if (file == shard->file_frames.end()) {
+            continue;
+        }
+        for (frame_id_t frame_id = file->second.head; frame_id != INVALID_FRAME_ID; frame_id = pages_[frame_id].file_next_) {
+            func(*shard, frame_id);
+        }
+    }
+}
+
+/**
+ * @description: 把未固定的帧按其优先级交给replacer：PINNED的帧不交给replacer，LOW的帧作为最冷的帧
+ * @param {Shard&} shard 帧所属的分片
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void BufferPoolManager::make_evictable(Shard &shard, frame_id_t frame_id) {
+    switch (pages_[frame_id].priority_.load()) {
+        case BufferPriority::PINNED:
+            break;
+        case BufferPriority::LOW:
+            shard.replacer->unpin_cold(frame_id);
+            break;
+        default:
+            shard.replacer->unpin(frame_id);
+            break;
+    }
+}
+
+/**
+ * @description: 修改驻留帧的优先级并维护分片中PINNED的帧数，分片中PINNED的帧已达到BUFFER_POOL_MAX_PINNED_PCT时按NORMAL处理。
+ *              帧未被固定且没有在途I/O时按新的优先级调整其在replacer中的状态，否则由之后的取消固定或I/O完成处理
+ * @param {Shard&} shard 帧所属的分片，调用者需持有其排他锁
+ * @param {frame_id_t} frame_id 目标帧，已被页表记录
+ * @param {BufferPriority} priority 帧所属文件的优先级
+ */
+void BufferPoolManager::set_frame_priority(Shard &shard, frame_id_t frame_id, BufferPriority priority) {
+    auto &page = pages_[frame_id];
+    BufferPriority old_priority = page.priority_;
+    if (priority == BufferPriority::PINNED && old_priority != BufferPriority::PINNED) {
+        size_t num_frames = (shard.id + 1) * pool_size_ / shards_.size() - shard.id * pool_size_ / shards_.size();
+        if ((shard.num_pinned + 1) * 100 > num_frames * BUFFER_POOL_MAX_PINNED_PCT) {
+            priority = BufferPriority::NORMAL;
+        }
+    }
+    if (priority == old_priority) {
+        return;
+    }
+    // 等待正在进行的取消固定按旧的优先级完成对replacer的更新
+    wait_pin_released(page);
+    page.priority_ = priority;
+    if (old_priority == BufferPriority::PINNED) {
+        shard.num_pinned--;
+    } else if (priority == BufferPriority::PINNED) {
+        shard.num_pinned++;
+    }
+    if (page.pin_count_ != 0 || page.io_in_progress_) {
+        return;
+    }
+    if (priority == BufferPriority::PINNED) {
+        shard.replacer->remove(frame_id);
+    } else {
+        make_evictable(shard, frame_id);
+    }
+}
+
+/**
+ * @description: 文件在分片中的驻留帧数达到max_buffer_pct规定的配额时，从该文件最早加入的帧开始找一个未固定、
+ *              没有在途I/O且不是PINNED的帧复用，文件不再占用分片中其他页面的帧
+ * @return {bool} 找到可复用的帧时返回true；文件未达到配额或其帧都不可复用时返回false，按常规方式淘汰
+ * @param {Shard&} shard 页面所属的分片，调用者需持有其排他锁
+ * @param {int} fd 要读入的页面所属的文件
+ * @param {frame_id_t*} frame_id 返回可复用的帧，其中仍是该文件的旧页面
+ */
+bool BufferPoolManager::find_quota_victim(Shard &shard, int fd, frame_id_t *frame_id) {
+    auto file = shard.file_frames.find(fd);
+    if (file == shard.file_frames.end()) {
+        return false;
+    }
+    int max_buffer_pct = get_file_policy(fd).max_buffer_pct;
+    if (max_buffer_pct >= 100) {
+        return false;
+    }
+    size_t num_frames = (shard.id + 1) * pool_size_ / shards_.size() - shard.id * pool_size_ / shards_.size();
+    size_t quota = std::max<size_t>(num_frames * max_buffer_pct / 100, 1);
+    if (file->second.count < quota) {
+        return false;
+    }
+    for (frame_id_t candidate = file->second.tail; candidate != INVALID_FRAME_ID;
+         candidate = pages_[candidate].file_prev_) {
+        auto &page = pages_[candidate];
+        if (page.pin_count_ == 0 && !page.io_in_progress_ && page.priority_ != BufferPriority::PINNED) {
+            shard.replacer->remove(candidate);
+            *frame_id = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @description: 设置文件的缓冲池策略，并按新的优先级调整文件已驻留的帧。由SmManager在打开数据库和执行ALTER时调用，
+ *              关闭文件之前应恢复为默认策略，否则之后复用同一fd的文件会沿用该策略
+ * @param {int} fd 目标文件
+ * @param {BufferPolicy&} policy 新的策略，为默认策略时删除文件的策略
+ */
+void BufferPoolManager::set_file_policy(int fd, const BufferPolicy &policy) {
+    {
+        std::unique_lock lock{policy_latch_};
+        if (policy.is_default()) {
+            file_policies_.erase(fd);
+        } else {
+            file_policies_[fd] = policy;
+        }
+    }
+    auto locks = lock_all_shards();
+    for_each_file_frame(fd, [&](Shard &shard, frame_id_t frame_id) { set_frame_priority(shard, frame_id, policy.priority); });
+}
+
+/**
+ * @description: 获得文件的缓冲池策略，没有设置时为默认策略
+ * @param {int} fd 目标文件
+ */
+BufferPolicy BufferPoolManager::get_file_policy(int fd) {
+    std::shared_lock lock{policy_latch_};
+    auto policy = file_policies_.find(fd);
+    return policy != file_policies_.end() ? policy->second : BufferPolicy();
+}
+
+/**
+ * @description: 获得文件驻留在缓冲池中的页面数
+ * @param {int} fd 目标文件
+ */
+size_t BufferPoolManager::get_resident_pages(int fd) {
+    size_t num_pages = 0;
+    for (auto &shard : shards_) {
+        std::shared_lock lock{shard->latch};
+        auto file = shard->file_frames.find(fd);
+        if (file != shard->file_frames.end()) {
+            num_pages += file->second.count;
+        }
+    }
+    return num_pages;
+}
+
+/**
+ * @description: 释放当前线程对帧的一次固定，帧仍被页表记录时见unpin_frame；否则（I/O失败撤销了记录）pin_count_减为0时放回free_list
+ * @param {Shard&} shard 帧所属的分片，调用者需持有其latch
+ * @param {frame_id_t} frame_id 目标帧
+ */
+void BufferPoolManager::release_frame(Shard &shard, frame_id_t frame_id) {
+    auto &page = pages_[frame_id];
+    auto record = shard.page_table.find(page.id_);
+    if (record != shard.page_table.end() && record->second == frame_id) {
+        unpin_frame(shard, frame_id, false);
+        return;
+    }
+    if (page.pin_count_.fetch_sub(1) > 1) {
+        return;
+    }
+    shard.replacer->remove(frame_id);
+    page.ring_id_ = 0;
+    shard.free_list.push_back(frame_id);
+}
+
+/**
+ * @description: 将page_id装入find_victim_page得到的帧，并固定该帧。
+ *              先在页表中记录page_id并将帧标记为io_in_progress_，然后释放分片的latch进行脏页写回和页面读入，
+ *              此期间访问新旧两个页面的线程只在该帧上等待，分片中其他页面的访问不受影响。
+ *              写回期间旧页面仍被页表记录，避免其他线程从磁盘读到旧页面写回之前的数据。
+ * @param {unique_lock<shared_mutex>&} lock 分片latch上的排他锁，调用时持有，返回时仍持有，I/O期间释放
+ * @param {frame_id_t} frame_id 由find_victim_page得到的帧
+ * @param {PageId} page_id 要装入的页面
+ * @param {bool} read 为true时从磁盘读入页面，否则将帧清零（用于new_page）
+ * @param {BufferAccessStrategy*} strategy 帧所属的访问策略，为nullptr时帧属于整个分片
+ * @note I/O失败时撤销页表中的page_id记录后抛出异常
+ */
+void BufferPoolManager::load_frame(Shard &shard, std::unique_lock<std::shared_mutex> &lock, frame_id_t frame_id,
+                                   PageId page_id, bool read, BufferAccessStrategy *strategy) {
+    auto &page = pages_[frame_id];
+    const PageId old_page_id = page.id_;
+    auto old_record = shard.page_table.find(old_page_id);
+    bool old_mapped = old_record != shard.page_table.end() && old_record->second == frame_id;
+    bool write_back = old_mapped && page.is_dirty_;
+    if (old_mapped && !write_back) {
+        unlink_file_frame(shard, frame_id);
+        shard.page_table.erase(old_record);
+    }
+    shard.page_table.emplace(page_id, frame_id);
+    shard.replacer->pin(frame_id);
+    page.pin_count_ = 1;
+    page.io_in_progress_ = true;
+    if (!write_back) {
+        page.id_ = page_id;
+        page.is_dirty_ = false;
+        link_file_frame(shard, frame_id);
+    }
+
+    // I/O结束（无论成功与否）后清除io_in_progress_并唤醒等待该帧的线程
+    auto finish_io = [&]() {
+        page.io_in_progress_ = false;
+        page.io_cv_.notify_all();
+    };
+
+    lock.unlock();
+    if (write_back) {
+        // 前台线程不得不同步写回脏页，说明分片中的干净帧已经不足
+        wake_bg_writer();
+        try {
+            flush_log_to(page.get_page_lsn());
+            disk_manager_->write_page(old_page_id.fd, old_page_id.page_no, page.data_, PAGE_SIZE);
+        } catch (...) {
+            // 写回失败，旧页面仍留在帧中并保持脏标记
+            lock.lock();
+            shard.page_table.erase(page_id);
+            finish_io();
+            release_frame(shard, frame_id);
+            throw;
+        }
+        lock.lock();
+        unlink_file_frame(shard, frame_id);
+        shard.page_table.erase(old_page_id);
+        page.id_ = page_id;
+        page.is_dirty_ = false;
+        link_file_frame(shard, frame_id);
+        lock.unlock();
+    }
+
+    try {
+        if (read) {
+            disk_manager_->read_page(page_id.fd, page_id.page_no, page.data_, PAGE_SIZE);
+        } else {
+            page.reset_memory();
+        }
+    } catch (...) {
+        lock.lock();
+        unlink_file_frame(shard, frame_id);
+        shard.page_table.erase(page_id);
+        finish_io();
+        release_frame(shard, frame_id);
+        throw;
+    }
+    lock.lock();
+    page.ring_id_ = strategy != nullptr ? strategy->id_ : 0;
+    finish_io();
+}
+
+/**
+ * @description: 在分片的页表中查找page_id并固定其所在的帧，若该帧正在进行I/O，则只在该帧上等待I/O结束
+ * @return {Page*} 页面在缓冲池中且可用时返回该页面，否则返回nullptr
+ * @param {unique_lock<shared_mutex>&} lock 分片latch上的排他锁，等待期间释放
+ */
+Page *BufferPoolManager::pin_resident_page(Shard &shard, std::unique_lock<std::shared_mutex> &lock, PageId page_id) {
+    while (true) {
+        auto record = shard.page_table.find(page_id);
+        if (record == shard.page_table.end()) {
+            return nullptr;
+        }
+        frame_id_t frame_id = record->second;
+        auto &page = pages_[frame_id];
+        shard.replacer->pin(frame_id);
+        page.pin_count_ += 1;
+        if (!page.io_in_progress_) {
+            return &page;
+        }
+        page.io_cv_.wait(lock, [&page]() { return !page.io_in_progress_; });
+        // I/O结束后帧中可能已经是别的页面（等待的是被写回的旧页面），或者I/O失败撤销了记录，此时重新查找
+        record = shard.page_table.find(page_id);
+        if (page.id_ == page_id && record != shard.page_table.end() && record->second == frame_id) {
+            return &page;
+        }
+        release_frame(shard, frame_id);
+    }
 }
 
 /**
  * @description: 从buffer pool获取需要的页。
- *              如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++。
+ *              如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++，该页正在读入时等待读入完成。
  *              如果页表不存在page_id（说明该page在磁盘中），则找缓冲池victim page，将其替换为磁盘中读取的page，pin_count置1。
+ *              命中且页面可用时只持有分片latch的共享锁，pin_count原子地增加；其余情况取排他锁。
+ *              磁盘读写在分片的latch之外进行，见load_frame
  * @return {Page*} 若获得了需要的页则将其返回，否则返回nullptr
  * @param {PageId} page_id 需要获取的页的PageId
- * @note 涉及临界资源 {page_table_}
+ * @param {BufferAccessStrategy*} strategy 缺页时使用的访问策略，为nullptr时可以淘汰分片中的任意页面
+ * @note 涉及临界资源 {shard.page_table}
  */
-Page* BufferPoolManager::fetch_page(PageId page_id) {
+Page* BufferPoolManager::fetch_page(PageId page_id, BufferAccessStrategy *strategy) {
     //Todo:
     // 1.     从page_table_中搜寻目标页
-    // 1.1    若目标页有被page_table_记录，则将其所在frame固定(pin)，并返回目标页。
+    // 1.1    若目标页有被page_table_记录，则将其所在frame固定(pin)，等待其I/O结束后返回目标页。
     // 1.2    否则，尝试调用find_victim_page获得一个可用的frame，若失败则返回nullptr
-    // 2.     若获得的可用frame存储的为dirty page，则须调用updata_page将page写回到磁盘
-    // 3.     调用disk_manager_的read_page读取目标页到frame
-    // 4.     固定目标页，更新pin_count_
-    // 5.     返回目标页
+    // 2.     调用load_frame在latch之外写回victim中的脏页，并读取目标页到frame
+    // 3.     返回目标页
 
-    std::scoped_lock lock{latch_};
+    auto &shard = get_shard(page_id);
+    {
+        // 命中路径：共享锁下的页表查找和原子的pin_count自增，持有共享锁时帧不会被淘汰或开始I/O
+        std::shared_lock lock{shard.latch};
+        auto record = shard.page_table.find(page_id);
+        if (record != shard.page_table.end() && !pages_[record->second].io_in_progress_) {
+            auto &page = pages_[record->second];
+            shard.replacer->pin(record->second);
+            page.pin_count_.fetch_add(1);
+            return &page;
+        }
+    }
+    std::unique_lock lock{shard.latch};
 
-    // 尝试在 page table 中查找指定 PageId
-    const auto &target_page_record = page_table_.find(page_id);
     // 如果目标页有被页表记录，则将其所在frame固定，并返回目标页
-    if (target_page_record != page_table_.end()) {
-        // 获得目标帧
-        auto target_frame_id = target_page_record->second;
-        // 更新pin count
-        replacer_->pin(target_frame_id);
-        pages_[target_frame_id].pin_count_ += 1;
-        // 返回目标页
-        return &pages_[target_frame_id];
+    Page *resident_page = pin_resident_page(shard, lock, page_id);
+    if (resident_page != nullptr) {
+        return resident_page;
     }
 
     // 目标页未被页表记录，调用find_victim_page获得一个可用的frame，若失败返回nullptr
     frame_id_t victim_frame_id = INVALID_FRAME_ID;
-    if (!find_victim_page(&victim_frame_id)) {
+    if (!find_victim_page(shard, page_id.fd, &victim_frame_id, strategy)) {
         // find_victim_page 失败
         return nullptr;
     }
 
-    // 从find_victim_page中获得的frame对应的page
-    auto &victim_page = pages_[victim_frame_id];
+    // 写回victim frame并读取磁盘内容到内存，目标页已被固定
+    load_frame(shard, lock, victim_frame_id, page_id, true, strategy);
 
-    // 更新victim frame
-    update_page(&victim_page, page_id, victim_frame_id);
-    // 读取磁盘内容到内存
-    disk_manager_->read_page(
-        page_id.fd,
-        page_id.page_no,
-        victim_page.data_,
-        PAGE_SIZE
-    );
+    // 返回目标页
+    return &pages_[victim_frame_id];
+}
 
-    // 固定目标页 pin_count_置1
-    replacer_->pin(victim_frame_id);
-    victim_page.pin_count_ += 1;
+/**
+ * @description: 取消一次对帧的固定，pin_count_减为0时将帧交给replacer。不需要持有分片的latch：
+ *              脏标记先于pin_count_的减少设置，持有latch看到pin_count_为0的线程（淘汰、后台写回）一定能看到脏标记；
+ *              最后一次取消固定先将pin_count_置为PIN_RELEASING，调用replacer->unpin之后再清除，
+ *              此期间帧可能被重新固定，find_victim_page会跳过这样的帧
+ * @return {bool} 如果帧的pin_count<=0则返回false，否则返回true
+ * @param {Shard&} shard 帧所属的分片
+ * @param {frame_id_t} frame_id 目标帧
+ * @param {bool} is_dirty 若目标page应该被标记为dirty则为true，否则为false
+ */
+bool BufferPoolManager::unpin_frame(Shard &shard, frame_id_t frame_id, bool is_dirty) {
+    auto &page = pages_[frame_id];
+    int pin_count = page.pin_count_.load();
+    if ((pin_count & ~Page::PIN_RELEASING) == 0) {
+        return false;
+    }
+    if (is_dirty) {
+        page.is_dirty_ = true;
+    }
+    // pin_count_不能减为负数，已经为0时返回false
+    while (true) {
+        int count = pin_count & ~Page::PIN_RELEASING;
+        if (count == 0) {
+            return false;
+        }
+        if (count == 1 && (pin_count & Page::PIN_RELEASING)) {
+            // 上一个减为0的线程还未完成replacer->unpin，等它完成后再减为0，否则其完成前帧可能被判定为不可淘汰
+            std::this_thread::yield();
+            pin_count = page.pin_count_.load();
+            continue;
+        }
+        int next = count == 1 ? Page::PIN_RELEASING : pin_count - 1;
+        if (page.pin_count_.compare_exchange_weak(pin_count, next)) {
+            break;
+        }
+    }
+    if (pin_count == 1) {
+        make_evictable(shard, frame_id);
+        page.pin_count_.fetch_sub(Page::PIN_RELEASING);
+    }
+    return true;
+}
 
-    // 返回目标页
-    return &victim_page;
+/**
+ * @description: 等待最后一次取消固定完成对replacer的更新，见Page::PIN_RELEASING。调用者持有分片的latch，
+ *              取消固定的线程不需要latch，很快就会完成
+ */
+void BufferPoolManager::wait_pin_released(Page &page) {
+    while (page.pin_count_.load() & Page::PIN_RELEASING) {
+        std::this_thread::yield();
+    }
 }
 
 /**
  * @description: 取消固定pin_count>0的在缓冲池中的page
- * @return {bool} 如果目标页的pin_count<=0则返回false，否则返回true
+ * @return {bool} 如果目标页不在缓冲池中或其pin_count<=0则返回false，否则返回true
  * @param {PageId} page_id 目标page的page_id
  * @param {bool} is_dirty 若目标page应该被标记为dirty则为true，否则为false
- * @note 涉及临界资源 {page_table_}
+ * @note 涉及临界资源 {shard.page_table}，只持有分片latch的共享锁
  */
 bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
-    // Todo:
-    // 0. lock latch
-    // 1. 尝试在page_table_中搜寻page_id对应的页P
-    // 1.1 P在页表中不存在 return false
-    // 1.2 P在页表中存在，获取其pin_count_
-    // 2.1 若pin_count_已经等于0，则返回false
-    // 2.2 若pin_count_大于0，则pin_count_自减一
-    // 2.2.1 若自减后等于0，则调用replacer_的Unpin
-    // 3 根据参数is_dirty，更改P的is_dirty_
+    // 1. 在共享锁下在page_table_中搜寻page_id对应的页P，P在页表中不存在 return false
+    // 2. 调用unpin_frame原子地减少P的pin_count_并更新P的is_dirty_
 
-    std::scoped_lock lock{latch_};
+    auto &shard = get_shard(page_id);
+    std::shared_lock lock{shard.latch};
 
     // 在页表中寻找page_id对应的页P
-    auto target_page_record = page_table_.find(page_id);
+    auto target_page_record = shard.page_table.find(page_id);
 
     // P在页表中不存在 return false
-    if (target_page_record == page_table_.end()) {
+    if (target_page_record == shard.page_table.end()) {
         return false;
     }
 
-    // P 在页表中存在 获取其 pin_count_
-    auto target_frame_id = target_page_record->second;
-    auto &target_page = pages_[target_frame_id];
-    auto &target_pin_count = target_page.pin_count_;
-
-    // 若 pincount 已经等于 0 返回 false
-    // 若 pincount 大于 0 则其 pincount 自减 1
-    // 若自减后 pincount 等于 0 则调用 replacer_ unpin
-    if (target_pin_count == 0) {
-        return false;
-    }
-    target_pin_count -= 1;
-    if (target_pin_count == 0) {
-        replacer_->unpin(target_frame_id);
-    }
-
-    // 根据参数 is_dirty 更新 P 的 is_dirty
-    target_page.is_dirty_ |= is_dirty;
+    return unpin_frame(shard, target_page_record->second, is_dirty);
+}
 
-    return true;
+/**
+ * @description: 取消固定调用者通过fetch_page或new_page得到的page，调用者仍持有固定，页面不会被淘汰，
+ *              因此不需要查找页表，也不持有分片的latch
+ * @return {bool} 如果目标页的pin_count<=0则返回false，否则返回true
+ * @param {Page*} page 目标page
+ * @param {bool} is_dirty 若目标page应该被标记为dirty则为true，否则为false
+ */
+bool BufferPoolManager::unpin_page(Page *page, bool is_dirty) {
+    return unpin_frame(get_shard(page->id_), static_cast<frame_id_t>(page - pages_), is_dirty);
 }
 
 /**
  * @description: 将目标页写回磁盘，不考虑当前页面是否正在被使用
  * @return {bool} 成功则返回true，否则返回false(只有page_table_中没有目标页时)
  * @param {PageId} page_id 目标页的page_id，不能为INVALID_PAGE_ID
- * @note 涉及临界资源 {page_table_}
+ * @note 涉及临界资源 {shard.page_table}
  */
 bool BufferPoolManager::flush_page(PageId page_id) {
     // Todo:
@@ -197,29 +966,33 @@ bool BufferPoolManager::flush_page(PageId page_id) {
     // 2. 无论P是否为脏都将其写回磁盘。
     // 3. 更新P的is_dirty_
 
-    std::scoped_lock lock{latch_};
+    auto &shard = get_shard(page_id);
+    std::unique_lock lock{shard.latch};
 
-    // 查找页表,尝试获取目标页P缓冲
-    const auto &target_page_record = page_table_.find(page_id);
-    if (target_page_record == page_table_.end()) {
+    // 查找页表,尝试获取目标页P缓冲并将其固定，使其在写回期间不会被淘汰
+    Page *target_page = pin_resident_page(shard, lock, page_id);
+    if (target_page == nullptr) {
         // 目标页P没有被page_table_记录 ，返回false
         return false;
     }
+    frame_id_t target_frame_id = target_page - pages_;
 
-    // 获取对应帧和对应页
-    auto target_frame_id = target_page_record->second;
-    auto &target_page = pages_[target_frame_id];
+    // 先清除脏标记再写回，写回期间其他线程对页面的修改会重新标记为脏
+    target_page->is_dirty_ = false;
 
-    // 无论P是否为脏都将其写回磁盘。
-    disk_manager_->write_page(
-        page_id.fd,
-        page_id.page_no,
-        target_page.data_,
-        PAGE_SIZE
-    );
-
-    // 更新P的is_dirty_
-    target_page.is_dirty_ = false;
+    // 无论P是否为脏都将其写回磁盘，写回在latch之外进行
+    lock.unlock();
+    try {
+        flush_log_to(target_page->get_page_lsn());
+        disk_manager_->write_page(page_id.fd, page_id.page_no, target_page->data_, PAGE_SIZE);
+    } catch (...) {
+        lock.lock();
+        target_page->is_dirty_ = true;
+        release_frame(shard, target_frame_id);
+        throw;
+    }
+    lock.lock();
+    release_frame(shard, target_frame_id);
 
     return true;
 }
@@ -228,140 +1001,865 @@ bool BufferPoolManager::flush_page(PageId page_id) {
  * @description: 创建一个新的page，即从磁盘中移动一个新建的空page到缓冲池某个位置。
  * @return {Page*} 返回新创建的page，若创建失败则返回nullptr
  * @param {PageId*} page_id 当成功创建一个新的page时存储其page_id
- * @note 涉及临界资源 {page_table_}
+ * @param {BufferAccessStrategy*} strategy 使用的访问策略，为nullptr时可以淘汰分片中的任意页面
+ * @note 涉及临界资源 {shard.page_table}
  */
-Page* BufferPoolManager::new_page(PageId* page_id) {
-    // 1.   获得一个可用的frame，若无法获得则返回nullptr
-    // 2.   在fd对应的文件分配一个新的page_id
+Page* BufferPoolManager::new_page(PageId* page_id, BufferAccessStrategy *strategy) {
+    // 1.   在fd对应的文件分配一个新的page_id，由page_id确定新页面所属的分片
+    // 2.   在该分片中获得一个可用的frame，若无法获得则归还page_id并返回nullptr
     // 3.   将frame的数据写回磁盘
     // 4.   固定frame，更新pin_count_
     // 5.   返回获得的page
 
-    std::scoped_lock lock{latch_};
+    // 在fd对应的文件分配一个新的page_id
+    page_id->page_no = disk_manager_->allocate_page(page_id->fd);
+
+    auto &shard = get_shard(*page_id);
+    std::unique_lock lock{shard.latch};
+
+    // 从空闲页表中重用的页面可能已被表扫描读入缓冲池（释放的页面在磁盘上是空页面），此时直接使用已有的frame
+    Page *resident_page = pin_resident_page(shard, lock, *page_id);
+    if (resident_page != nullptr) {
+        resident_page->reset_memory();
+        return resident_page;
+    }
 
     // 获得一个可用的frame，若无法获得则返回nullptr
     frame_id_t victim_frame_id = INVALID_FRAME_ID;
-    if (!find_victim_page(&victim_frame_id)) {
+    if (!find_victim_page(shard, page_id->fd, &victim_frame_id, strategy)) {
+        lock.unlock();
+        disk_manager_->deallocate_page(page_id->fd, page_id->page_no);
+        page_id->page_no = INVALID_PAGE_ID;
         return nullptr;
     }
 
-    // 从find_victim_page中获得的frame对应的page
-    auto &victim_page = pages_[victim_frame_id];
-
-    // 在fd对应的文件分配一个新的page_id
-    page_id->page_no = disk_manager_->allocate_page(page_id->fd);
-    // 更新 victim page
-    update_page(&victim_page, *page_id, victim_frame_id);
-    victim_page.reset_memory();
-
-    // 固定 frame，更新 pincount
-    replacer_->pin(victim_frame_id);
-    pages_[victim_frame_id].pin_count_ += 1;
+    // 写回victim中的脏页并将frame清零，固定 frame
+    load_frame(shard, lock, victim_frame_id, *page_id, false, strategy);
 
-    return &victim_page;
+    return &pages_[victim_frame_id];
 }
 
 /**
  * @description: 从buffer_pool删除目标页
  * @return {bool} 如果目标页不存在于buffer_pool或者成功被删除则返回true，若其存在于buffer_pool但无法删除则返回false
  * @param {PageId} page_id 目标页
- * @note 涉及临界资源 {page_table_, free_list_}
+ * @note 涉及临界资源 {shard.page_table, shard.free_list}
  */
 bool BufferPoolManager::delete_page(PageId page_id) {
     // 1.   在page_table_中查找目标页，若不存在返回true
     // 2.   若目标页的pin_count不为0，则返回false
     // 3.   将目标页数据写回磁盘，从页表中删除目标页，重置其元数据，将其加入free_list_，返回true
 
-    std::scoped_lock lock{latch_};
-    // 在页表中查找目标页 若不存在 返回 true
-    auto target_page_record = page_table_.find(page_id);
-    if (target_page_record == page_table_.end()) {
-        return true;
+    auto &shard = get_shard(page_id);
+    std::unique_lock lock{shard.latch};
+    frame_id_t target_frame;
+    while (true) {
+        // 在页表中查找目标页 若不存在 返回 true
+        auto target_page_record = shard.page_table.find(page_id);
+        if (target_page_record == shard.page_table.end()) {
+            return true;
+        }
+        target_frame = target_page_record->second;
+        auto &page = pages_[target_frame];
+        // 若目标页的pincount不为0 返回false
+        wait_pin_released(page);
+        if (page.pin_count_ != 0) {
+            return false;
+        }
+        if (!page.io_in_progress_) {
+            break;
+        }
+        // 未固定的帧正在I/O说明后台写回线程正在写回该页面，等待写回结束后重新查找
+        page.io_cv_.wait(lock, [&page]() { return !page.io_in_progress_; });
     }
-
-    auto target_frame = target_page_record->second;
     auto &target_page = pages_[target_frame];
 
-    // 若目标页的pincount不为0 返回false
-    if (target_page.pin_count_ != 0) {
-        return false;
-    }
-
     // 将目标页写回磁盘 从业表中删除目标页 重置目标页元数据 将其加入 free_list_ 返回 true
-    update_page(&target_page, page_id, INVALID_FRAME_ID);
+    update_page(shard, &target_page, page_id, INVALID_FRAME_ID);
 
-    free_list_.push_back(target_frame);
+    // 帧进入free_list后不能再被replacer选为淘汰页面
+    shard.replacer->remove(target_frame);
+    target_page.ring_id_ = 0;
+    shard.free_list.push_back(target_frame);
 
     return true;
 }
 
 /**
- * @description: 删除buffer pool manager中缓存的全部页面
+ * @description: 删除buffer pool manager中缓存的fd的全部页面，只遍历fd的驻留帧，与缓冲池大小无关
+ * @return {bool} fd的页面均未被固定时删除并返回true，否则不删除任何页面并返回false
  * @param {int} fd 待删除的文件的fd
  */
 bool BufferPoolManager::delete_all_page(int fd) {
-    std::scoped_lock lock{latch_};
+    auto locks = lock_all_shards();
 
-    std::vector<frame_id_t> target_frames;
-    // 先检查是否所有页面都可删除
-    for (const auto &[page_id, frame_id] : page_table_) {
-        // 只删除 fd 的页面
-        if (page_id.fd != fd)
-            continue;
+    // 等待后台写回线程或预读写完、读完fd的页面，此期间帧未被固定但不能删除
+    wait_file_io(locks, fd);
+
+    std::vector<std::pair<Shard *, frame_id_t>> target_frames;
+    // 先检查是否所有页面都可删除，只遍历 fd 的驻留帧
+    bool pinned = false;
+    for_each_file_frame(fd, [&](Shard &shard, frame_id_t frame_id) {
         // 所有页面均释放才可以删除
-        if (pages_[frame_id].pin_count_ != 0)
-            return false;
+        wait_pin_released(pages_[frame_id]);
+        pinned |= pages_[frame_id].pin_count_ != 0;
         // 加入待删除
-        target_frames.push_back(frame_id);
+        target_frames.emplace_back(&shard, frame_id);
+    });
+    if (pinned) {
+        return false;
+    }
+    {
+        // fd关闭后可能被复用，清除其顺序访问检测状态
+        std::scoped_lock lock{read_ahead_latch_};
+        read_ahead_states_.erase(fd);
     }
     // 删除页面
-    for (frame_id_t frame_id : target_frames) {
+    for (auto [shard, frame_id] : target_frames) {
         auto &target_page = pages_[frame_id];
-        update_page(&target_page, target_page.id_, INVALID_FRAME_ID);
-        free_list_.push_back(frame_id);
+        update_page(*shard, &target_page, target_page.id_, INVALID_FRAME_ID);
+        shard->replacer->remove(frame_id);
+        target_page.ring_id_ = 0;
+        shard->free_list.push_back(frame_id);
     }
     return true;
 }
 
 
 /**
- * @description: 将buffer_pool中的所有页写回到磁盘
+ * @description: 等待一组异步I/O全部完成，若有失败的请求，在全部结束后抛出遇到的第一个异常
+ * @param {vector<future<void>>&} pending 已提交的异步I/O
+ */
+static void wait_all_io(std::vector<std::future<void>> &pending) {
+    std::exception_ptr first_error;
+    for (auto &io : pending) {
+        try {
+            io.get();
+        } catch (...) {
+            if (!first_error) first_error = std::current_exception();
+        }
+    }
+    pending.clear();
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+/**
+ * @description: 清除一组帧的脏标记并将其写回磁盘，见write_frames
+ * @return {FlushStats} 写回的页面数、字节数和写请求数
+ * @param {vector<frame_id_t>&} frames 待写回的帧，调用者需持有这些帧所属分片的latch
+ */
+FlushStats BufferPoolManager::write_back_frames(std::vector<frame_id_t> &frames) {
+    for (auto frame_id : frames) {
+        pages_[frame_id].is_dirty_ = false;
+    }
+    return write_frames(frames);
+}
+
+/**
+ * @description: 将一组帧按(fd, page_no)排序后写回磁盘，同一文件中页号连续的页面合并为一次向量写，
+ * 所有写请求先全部提交再统一等待。不修改帧的元数据
+ * @return {FlushStats} 写回的页面数、字节数和写请求数
+ * @param {vector<frame_id_t>&} frames 待写回的帧，调用者需保证写回期间这些帧不会被淘汰或修改
+ */
+FlushStats BufferPoolManager::write_frames(std::vector<frame_id_t> &frames) {
+    FlushStats stats;
+    std::sort(frames.begin(), frames.end(),
+              [this](frame_id_t a, frame_id_t b) { return pages_[a].id_ < pages_[b].id_; });
+    // 先写日志：这一批页面中最大的lsn之前的日志都落盘之后才能写回页面
+    if (flush_log_) {
+        lsn_t max_lsn = INVALID_LSN;
+        for (auto frame_id : frames) {
+            max_lsn = std::max(max_lsn, pages_[frame_id].get_page_lsn());
+        }
+        flush_log_to(max_lsn);
+    }
+
+    std::vector<std::future<void>> pending;
+    std::vector<struct iovec> iov;
+    iov.reserve(MAX_WRITE_BACK_PAGES);
+    size_t begin = 0;
+    while (begin < frames.size()) {
+        // 找出从begin开始、同一文件中页号连续的一段页面
+        const PageId &start = pages_[frames[begin]].id_;
+        size_t end = begin + 1;
+        while (end < frames.size() && end - begin < MAX_WRITE_BACK_PAGES) {
+            const PageId &cur = pages_[frames[end]].id_;
+            if (cur.fd != start.fd || cur.page_no != start.page_no + static_cast<page_id_t>(end - begin)) {
+                break;
+            }
+            end++;
+        }
+
+        iov.clear();
+        for (size_t i = begin; i < end; i++) {
+            auto &page = pages_[frames[i]];
+            iov.push_back({.iov_base = page.data_, .iov_len = static_cast<size_t>(PAGE_SIZE)});
+        }
+        // iov在提交后即可复用，帧数据在等待结束前不会被修改
+        pending.push_back(disk_manager_->async_write_pages(start.fd, start.page_no, iov.data(), iov.size()));
+        stats.pages += end - begin;
+        stats.bytes += (end - begin) * PAGE_SIZE;
+        stats.syscalls++;
+        begin = end;
+    }
+    wait_all_io(pending);
+    return stats;
+}
+
+/**
+ * @description: 写回页面之前调用，保证lsn及之前的日志已经落盘，遵守先写日志的规则
+ * @param {lsn_t} lsn 将要写回的页面中最大的lsn
+ */
+void BufferPoolManager::flush_log_to(lsn_t lsn) {
+    if (flush_log_ && lsn != INVALID_LSN) {
+        flush_log_(lsn);
+    }
+}
+
+/**
+ * @description: 等待fd的驻留帧上正在进行的I/O（后台写回、淘汰时的写回、预读）全部结束。
+ *              等待时释放该帧所在分片的latch，链表可能改变，之后从头查找
+ * @param {vector<unique_lock<shared_mutex>>&} locks lock_all_shards()返回的所有分片的排他锁
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolManager::wait_file_io(std::vector<std::unique_lock<std::shared_mutex>> &locks, int fd) {
+    while (true) {
+        Shard *io_shard = nullptr;
+        frame_id_t io_frame = INVALID_FRAME_ID;
+        for_each_file_frame(fd, [&](Shard &shard, frame_id_t frame_id) {
+            if (io_shard == nullptr && pages_[frame_id].io_in_progress_) {
+                io_shard = &shard;
+                io_frame = frame_id;
+            }
+        });
+        if (io_shard == nullptr) {
+            return;
+        }
+        auto &page = pages_[io_frame];
+        page.io_cv_.wait(locks[io_shard->id], [&page]() { return !page.io_in_progress_; });
+    }
+}
+
+/**
+ * @description: 等待分片中所有帧上正在进行的I/O结束，写回失败的页面重新成为脏页，由调用者接着写回
+ * @param {Shard&} shard 目标分片
+ * @param {unique_lock<shared_mutex>&} lock 分片latch上的排他锁，等待期间释放
+ */
+void BufferPoolManager::wait_shard_io(Shard &shard, std::unique_lock<std::shared_mutex> &lock) {
+    while (true) {
+        Page *io_page = nullptr;
+        for (const auto &[page_id, frame_id] : shard.page_table) {
+            if (pages_[frame_id].io_in_progress_) {
+                io_page = &pages_[frame_id];
+                break;
+            }
+        }
+        if (io_page == nullptr) {
+            return;
+        }
+        io_page->io_cv_.wait(lock, [io_page]() { return !io_page->io_in_progress_; });
+    }
+}
+
+/**
+ * @description: 开始写回一个帧：清除脏标记并标记为io_in_progress_，写回期间帧不能被淘汰或删除，
+ *              新的访问者在帧上等待写回结束，已固定该帧的线程照常访问，其修改在取消固定时重新标记为脏页
+ * @param {Shard&} shard 帧所属的分片，调用者需持有其排他锁
+ * @param {frame_id_t} frame_id 目标帧，不能正在进行I/O
+ */
+void BufferPoolManager::begin_write_back(Shard &shard, frame_id_t frame_id) {
+    auto &page = pages_[frame_id];
+    shard.replacer->pin(frame_id);
+    page.is_dirty_ = false;
+    page.io_in_progress_ = true;
+}
+
+/**
+ * @description: 在分片的latch之外写回一组由begin_write_back标记的帧，结束后逐帧清除io_in_progress_并唤醒等待的线程，
+ *              未被固定的帧交给replacer。写回失败时帧重新标记为脏页，所有帧结束后抛出异常
+ * @return {FlushStats} 写回的页面数、字节数和写请求数
+ * @param {vector<frame_id_t>&} frames 待写回的帧，调用者不持有任何分片的latch
+ */
+FlushStats BufferPoolManager::write_back_in_progress(std::vector<frame_id_t> &frames) {
+    FlushStats stats;
+    std::exception_ptr error;
+    try {
+        stats = write_frames(frames);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    for (auto frame_id : frames) {
+        auto &page = pages_[frame_id];
+        auto &shard = get_shard(page.id_);
+        std::scoped_lock lock{shard.latch};
+        if (error != nullptr) {
+            page.is_dirty_ = true;
+        }
+        page.io_in_progress_ = false;
+        page.io_cv_.notify_all();
+        // 写回期间被其他线程固定的帧由其unpin_page交给replacer
+        if (page.pin_count_ == 0) {
+            make_evictable(shard, frame_id);
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return stats;
+}
+
+/**
+ * @description: 将buffer_pool中的所有页写回到磁盘。先等待fd上已经开始的I/O结束，再在所有分片的latch下标记fd的驻留帧，
+ *              释放latch后写回，写回期间只有访问这些页面的线程需要等待。返回时fd上没有进行中的I/O，调用者可以关闭文件
+ * @return {FlushStats} 写回的统计信息
+ * @param {int} fd 文件句柄
+ * @note 涉及临界资源 {所有分片的file_frames, pages_}，只遍历fd的驻留帧
+ */
+FlushStats BufferPoolManager::flush_all_pages(int fd) {
+    std::vector<frame_id_t> frames;
+    {
+        auto locks = lock_all_shards();
+        wait_file_io(locks, fd);
+        for_each_file_frame(fd, [&](Shard &shard, frame_id_t frame_id) {
+            begin_write_back(shard, frame_id);
+            frames.push_back(frame_id);
+        });
+    }
+    return write_back_in_progress(frames);
+}
+
+/**
+ * @description: 将所有buffer_pool中全部脏页写入磁盘。逐个分片等待已经开始的写回结束后在其latch下标记脏页，
+ *              释放latch后统一排序合并写回。返回时调用前的所有修改都已写回，可作为关闭数据库和检查点的屏障
+ * @return {FlushStats} 写回的统计信息
+ * @note 涉及临界资源 {所有分片的page_table, pages_}
+ */
+FlushStats BufferPoolManager::flush_all_page() {
+    std::vector<frame_id_t> frames;
+    for (auto &shard : shards_) {
+        std::unique_lock lock{shard->latch};
+        // 先等待分片中已经开始的写回结束，写回失败而重新变脏的页面在下面一起写回
+        wait_shard_io(*shard, lock);
+        for (const auto &[page_id, frame_id] : shard->page_table) {
+            // 只对脏页进行刷新
+            if (!pages_[frame_id].is_dirty_)
+                continue;
+            begin_write_back(*shard, frame_id);
+            frames.push_back(frame_id);
+        }
+    }
+    return write_back_in_progress(frames);
+}
+
+/**
+ * @description: 启动后台写回线程，由rmdb在启动时调用
+ */
+void BufferPoolManager::start_bg_writer() {
+    std::scoped_lock lock{bgwriter_latch_};
+    if (bgwriter_.joinable()) {
+        return;
+    }
+    bgwriter_stop_ = false;
+    bgwriter_ = std::thread(&BufferPoolManager::bg_writer_loop, this);
+}
+
+/**
+ * @description: 停止后台写回线程并等待其退出，正在进行的一轮写回会先完成
+ */
+void BufferPoolManager::stop_bg_writer() {
+    {
+        std::scoped_lock lock{bgwriter_latch_};
+        if (!bgwriter_.joinable()) {
+            return;
+        }
+        bgwriter_stop_ = true;
+    }
+    bgwriter_cv_.notify_one();
+    bgwriter_.join();
+}
+
+/**
+ * @description: 唤醒后台写回线程立即开始下一轮写回
+ */
+void BufferPoolManager::wake_bg_writer() {
+    {
+        std::scoped_lock lock{bgwriter_latch_};
+        bgwriter_wakeup_ = true;
+    }
+    bgwriter_cv_.notify_one();
+}
+
+/**
+ * @description: 后台写回线程的主循环，每隔bgwriter_delay_ms_毫秒或被前台线程唤醒时执行一轮写回，
+ *              并每隔BUFFER_POOL_DUMP_INTERVAL_S秒转储一次驻留页面列表
+ */
+void BufferPoolManager::bg_writer_loop() {
+    std::unique_lock lock{bgwriter_latch_};
+    while (true) {
+        bgwriter_cv_.wait_for(lock, std::chrono::milliseconds(bgwriter_delay_ms_.load()),
+                              [this]() { return bgwriter_stop_ || bgwriter_wakeup_; });
+        if (bgwriter_stop_) {
+            return;
+        }
+        bgwriter_wakeup_ = false;
+        lock.unlock();
+        try {
+            bg_write_round();
+        } catch (RMDBError &e) {
+            // 写回失败的页面仍是脏页，由淘汰或下一轮写回重试
+            std::cerr << "BufferPoolManager: background write failed: " << e.what() << std::endl;
+        }
+        bool dump_due;
+        {
+            std::scoped_lock dump_lock{warmup_dump_latch_};
+            dump_due = std::chrono::steady_clock::now() - last_dump_ >= std::chrono::seconds(BUFFER_POOL_DUMP_INTERVAL_S);
+        }
+        if (dump_due) {
+            try {
+                dump_resident_pages();
+            } catch (RMDBError &e) {
+                std::cerr << "BufferPoolManager: buffer pool dump failed: " << e.what() << std::endl;
+            }
+        }
+        lock.lock();
+    }
+}
+
+/**
+ * @description: 执行一轮后台写回。分片中的干净帧（未固定且不是脏页）和空闲帧少于低水位时开始写回，
+ *              直到达到高水位为止，每轮所有分片合计最多写回bgwriter_max_pages_个页面。
+ *              按页面的LSN从小到大选择最早被修改的脏页，再按(fd, page_no)的顺序合并写回。
+ *              写回期间帧标记为io_in_progress_且不能被淘汰，访问这些页面的线程在帧上等待写回结束
+ * @return {size_t} 本轮写回的页面数
+ */
+size_t BufferPoolManager::bg_write_round() {
+    size_t budget = std::max(bgwriter_max_pages_.load(), 0);
+    size_t low_watermark = std::clamp(bgwriter_low_watermark_.load(), 0, 100);
+    size_t high_watermark = std::clamp(bgwriter_high_watermark_.load(), 0, 100);
+    size_t written = 0;
+    for (size_t i = 0; i < shards_.size() && written < budget; ++i) {
+        auto &shard = *shards_[i];
+        std::unique_lock lock{shard.latch};
+        size_t num_frames = (i + 1) * pool_size_ / shards_.size() - i * pool_size_ / shards_.size();
+
+        size_t num_clean = shard.free_list.size();
+        std::vector<frame_id_t> frames;
+        for (const auto &[page_id, frame_id] : shard.page_table) {
+            const auto &page = pages_[frame_id];
+            if (page.pin_count_ != 0 || page.io_in_progress_) {
+                continue;
+            }
+            if (page.is_dirty_) {
+                frames.push_back(frame_id);
+            } else {
+                num_clean++;
+            }
+        }
+        if (num_clean * 100 < low_watermark * num_frames) {
+            shard.bgwriter_active = true;
+        }
+        size_t target = (high_watermark * num_frames + 99) / 100;
+        if (num_clean >= target) {
+            shard.bgwriter_active = false;
+        }
+        if (!shard.bgwriter_active || frames.empty()) {
+            continue;
+        }
+
+        size_t count = std::min({target - num_clean, budget - written, frames.size()});
+        std::partial_sort(frames.begin(), frames.begin() + count, frames.end(), [this](frame_id_t a, frame_id_t b) {
+            lsn_t lsn_a = pages_[a].get_page_lsn(), lsn_b = pages_[b].get_page_lsn();
+            return lsn_a != lsn_b ? lsn_a < lsn_b : pages_[a].id_ < pages_[b].id_;
+        });
+        frames.resize(count);
+        for (auto frame_id : frames) {
+            begin_write_back(shard, frame_id);
+        }
+
+        lock.unlock();
+        write_back_in_progress(frames);
+        written += frames.size();
+        bgwriter_pages_written_ += frames.size();
+    }
+    return written;
+}
+
+/**
+ * @description: 顺序访问检测，扫描在访问fd的每个页面之前调用。
+ *              连续两次访问相邻的页号时认为是顺序访问，异步预读之后的页面；预读窗口从READ_AHEAD_MIN_PAGES开始，
+ *              每次翻倍直到read_ahead_max_pages_，已预读的页面被访问过半时预读下一个窗口，使I/O与扫描重叠
+ * @param {int} fd 文件句柄
+ * @param {page_id_t} page_no 即将访问的页号
+ * @param {BufferAccessStrategy*} strategy 扫描使用的访问策略，预读窗口不超过其环的一半
+ */
+void BufferPoolManager::read_ahead(int fd, page_id_t page_no, BufferAccessStrategy *strategy) {
+    int max_pages = read_ahead_max_pages_;
+    if (strategy != nullptr) {
+        max_pages = std::min<int>(max_pages, strategy->get_ring_size() / 2);
+    }
+    if (max_pages <= 0) {
+        return;
+    }
+
+    std::vector<page_id_t> page_nos;
+    {
+        std::scoped_lock lock{read_ahead_latch_};
+        auto &state = read_ahead_states_[fd];
+        bool sequential = state.last_page_no != INVALID_PAGE_ID && page_no == state.last_page_no + 1;
+        state.last_page_no = page_no;
+        if (!sequential) {
+            state.window = 0;
+            state.prefetched_until = page_no + 1;
+            return;
+        }
+        // 已预读的页面还剩一半以上时不再预读
+        if (page_no + state.window / 2 < state.prefetched_until) {
+            return;
+        }
+        state.window = state.window == 0 ? std::min(READ_AHEAD_MIN_PAGES, max_pages)
+                                         : std::min(state.window * 2, max_pages);
+        page_id_t end = page_no + 1 + state.window;
+        for (page_id_t prefetch_no = std::max(state.prefetched_until, page_no + 1); prefetch_no < end; ++prefetch_no) {
+            page_nos.push_back(prefetch_no);
+        }
+        state.prefetched_until = end;
+    }
+    prefetch_pages(fd, page_nos, strategy);
+}
+
+/**
+ * @description: 异步预读fd中的一组页面，不在缓冲池中的页面被装入空闲帧或干净的淘汰帧，页号连续的页面合并为一次向量读。
+ *              预读的帧未被固定，但在I/O完成前标记为io_in_progress_，访问这些页面的线程在帧上等待；
+ *              I/O由预读完成线程等待，完成后帧交给replacer。淘汰帧是脏页时跳过该页面，预读不进行同步写回
+ * @return {size_t} 发起预读的页面数
  * @param {int} fd 文件句柄
- * @note 涉及临界资源 {page_table_, pages_}
+ * @param {vector<page_id_t>&} page_nos 要预读的页号，超出文件末尾的页号被忽略
+ * @param {BufferAccessStrategy*} strategy 访问策略，为nullptr时可以淘汰分片中的任意页面
+ * @param {bool} free_frames_only 只使用空闲帧，页面所属分片没有空闲帧时跳过该页面，不淘汰任何已驻留的页面
  */
-void BufferPoolManager::flush_all_pages(int fd) {
-    std::scoped_lock lock{latch_};
-    for (const auto &[page_id, frame_id] : page_table_) {
-        if (page_id.fd != fd)
+size_t BufferPoolManager::prefetch_pages(int fd, const std::vector<page_id_t> &page_nos,
+                                         BufferAccessStrategy *strategy, bool free_frames_only) {
+    page_id_t num_pages = disk_manager_->get_fd2pageno(fd);
+    std::vector<std::pair<page_id_t, frame_id_t>> loading;
+    for (auto page_no : page_nos) {
+        if (page_no < 0 || page_no >= num_pages) {
             continue;
+        }
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        auto &shard = get_shard(page_id);
+        std::scoped_lock lock{shard.latch};
+        if (shard.page_table.count(page_id) != 0) {
+            continue;
+        }
+        frame_id_t frame_id = INVALID_FRAME_ID;
+        if (free_frames_only) {
+            if (shard.free_list.empty()) {
+                continue;
+            }
+            frame_id = shard.free_list.front();
+            shard.free_list.pop_front();
+        } else if (!find_victim_page(shard, fd, &frame_id, strategy)) {
+            continue;
+        }
         auto &page = pages_[frame_id];
-        disk_manager_->write_page(
-            fd,
-            page_id.page_no,
-            page.data_,
-            PAGE_SIZE
-        );
+        auto old_record = shard.page_table.find(page.id_);
+        if (old_record != shard.page_table.end() && old_record->second == frame_id) {
+            if (page.is_dirty_) {
+                make_evictable(shard, frame_id);
+                continue;
+            }
+            unlink_file_frame(shard, frame_id);
+            shard.page_table.erase(old_record);
+        }
+        shard.page_table.emplace(page_id, frame_id);
+        shard.replacer->pin(frame_id);
+        page.id_ = page_id;
         page.is_dirty_ = false;
+        page.io_in_progress_ = true;
+        link_file_frame(shard, frame_id);
+        page.ring_id_ = strategy != nullptr ? strategy->id_ : 0;
+        loading.emplace_back(page_no, frame_id);
+    }
+    if (loading.empty()) {
+        return 0;
+    }
+
+    {
+        std::scoped_lock lock{prefetch_latch_};
+        if (!prefetcher_.joinable()) {
+            prefetch_stop_ = false;
+            prefetcher_ = std::thread(&BufferPoolManager::prefetch_loop, this);
+        }
+    }
+    std::sort(loading.begin(), loading.end());
+    std::vector<struct iovec> iov;
+    size_t begin = 0;
+    while (begin < loading.size()) {
+        size_t end = begin + 1;
+        while (end < loading.size() && end - begin < MAX_WRITE_BACK_PAGES &&
+               loading[end].first == loading[begin].first + static_cast<page_id_t>(end - begin)) {
+            end++;
+        }
+        PrefetchRead read;
+        iov.clear();
+        for (size_t i = begin; i < end; i++) {
+            iov.push_back({.iov_base = pages_[loading[i].second].data_, .iov_len = static_cast<size_t>(PAGE_SIZE)});
+            read.frames.push_back(loading[i].second);
+        }
+        try {
+            read.io = disk_manager_->async_read_pages(fd, loading[begin].first, iov.data(), iov.size());
+        } catch (RMDBError &) {
+            finish_prefetch(read.frames, false);
+            begin = end;
+            continue;
+        }
+        {
+            std::scoped_lock lock{prefetch_latch_};
+            prefetch_queue_.push_back(std::move(read));
+        }
+        prefetch_cv_.notify_one();
+        begin = end;
+    }
+    prefetched_pages_ += loading.size();
+    return loading.size();
+}
+
+/**
+ * @description: 预读完成线程的主循环，依次等待预读的I/O完成，停止时先处理完所有在途的预读
+ */
+void BufferPoolManager::prefetch_loop() {
+    std::unique_lock lock{prefetch_latch_};
+    while (true) {
+        prefetch_cv_.wait(lock, [this]() { return prefetch_stop_ || !prefetch_queue_.empty(); });
+        if (prefetch_queue_.empty()) {
+            return;
+        }
+        PrefetchRead read = std::move(prefetch_queue_.front());
+        prefetch_queue_.pop_front();
+        lock.unlock();
+        bool success = true;
+        try {
+            read.io.get();
+        } catch (RMDBError &) {
+            success = false;
+        }
+        finish_prefetch(read.frames, success);
+        lock.lock();
     }
 }
 
 /**
- * @description: 将所有buffer_pool中全部脏页写入磁盘
- * @note 涉及临界资源 {page_table_, pages_}
+ * @description: 结束一次预读，清除帧的io_in_progress_并唤醒等待的线程。
+ *              成功时未被固定的帧交给replacer；失败时撤销页表中的记录，未被固定的帧放回free_list，
+ *              已被等待线程固定的帧由其在发现页面不在页表中后释放
+ * @param {vector<frame_id_t>&} frames 预读的帧
+ * @param {bool} success 预读是否成功
  */
-void BufferPoolManager::flush_all_page() {
-    std::scoped_lock lock{latch_};
-    for (const auto &[page_id, frame_id] : page_table_) {
+void BufferPoolManager::finish_prefetch(const std::vector<frame_id_t> &frames, bool success) {
+    for (auto frame_id : frames) {
         auto &page = pages_[frame_id];
-        // 只对脏页进行刷新
-        if (!page.is_dirty_)
+        auto &shard = get_shard(page.id_);
+        std::scoped_lock lock{shard.latch};
+        page.io_in_progress_ = false;
+        page.io_cv_.notify_all();
+        if (success) {
+            if (page.pin_count_ == 0) {
+                make_evictable(shard, frame_id);
+            }
             continue;
-        disk_manager_->write_page(
-            page_id.fd,
-            page_id.page_no,
-            page.data_,
-            PAGE_SIZE
-        );
-        page.is_dirty_ = false;
+        }
+        unlink_file_frame(shard, frame_id);
+        shard.page_table.erase(page.id_);
+        if (page.pin_count_ == 0) {
+            shard.replacer->remove(frame_id);
+            page.ring_id_ = 0;
+            shard.free_list.push_back(frame_id);
+        }
+    }
+}
+
+/**
+ * @description: 等待所有在途的预读完成并停止预读完成线程
+ */
+void BufferPoolManager::stop_prefetcher() {
+    {
+        std::scoped_lock lock{prefetch_latch_};
+        if (!prefetcher_.joinable()) {
+            return;
+        }
+        prefetch_stop_ = true;
+    }
+    prefetch_cv_.notify_one();
+    prefetcher_.join();
+}
+
+/**
+ * @description: 设置缓冲池预热的转储文件，由SmManager在打开数据库时设置为数据库目录下的BUFFER_POOL_DUMP_NAME，
+ *              关闭数据库时清空。设置后后台写回线程每隔BUFFER_POOL_DUMP_INTERVAL_S秒转储一次驻留页面列表
+ * @param {string&} path 转储文件的绝对路径，为空时不再转储
+ */
+void BufferPoolManager::set_warmup_dump_path(const std::string &path) {
+    std::scoped_lock lock{warmup_dump_latch_};
+    warmup_dump_path_ = path;
+    last_dump_ = std::chrono::steady_clock::now();
+}
+
+/**
+ * @description: 将缓冲池中驻留页面的列表写入转储文件，每行为"文件名 页号"，按(文件名, 页号)排序。
+ *              先写入临时文件再重命名，崩溃时不会留下不完整的转储文件。各分片依次只取共享锁，不阻塞页面访问，
+ *              得到的列表不是某一时刻的精确快照，但预热只把它当作提示
+ * @return {size_t} 写入的页面数
+ */
+size_t BufferPoolManager::dump_resident_pages() {
+    std::scoped_lock dump_lock{warmup_dump_latch_};
+    if (warmup_dump_path_.empty()) {
+        return 0;
+    }
+    last_dump_ = std::chrono::steady_clock::now();
+
+    std::unordered_map<int, std::vector<page_id_t>> resident;
+    for (auto &shard : shards_) {
+        std::shared_lock lock{shard->latch};
+        for (const auto &[page_id, frame_id] : shard->page_table) {
+            resident[page_id.fd].push_back(page_id.page_no);
+        }
+    }
+    std::vector<std::pair<std::string, std::vector<page_id_t>>> files;
+    for (auto &[fd, page_nos] : resident) {
+        try {
+            files.emplace_back(disk_manager_->get_file_name(fd), std::move(page_nos));
+        } catch (RMDBError &) {
+            // 文件在收集之后被关闭（如DROP TABLE），跳过它的页面
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::string tmp_path = warmup_dump_path_ + ".tmp";
+    std::ofstream ofs(tmp_path, std::ios::out | std::ios::trunc);
+    size_t num_pages = 0;
+    for (auto &[file_name, page_nos] : files) {
+        std::sort(page_nos.begin(), page_nos.end());
+        for (auto page_no : page_nos) {
+            ofs << file_name << ' ' << page_no << '\n';
+        }
+        num_pages += page_nos.size();
+    }
+    ofs.close();
+    if (!ofs || rename(tmp_path.c_str(), warmup_dump_path_.c_str()) < 0) {
+        unlink(tmp_path.c_str());
+        throw UnixError();
+    }
+    return num_pages;
+}
+
+/**
+ * @description: 启动预热线程，读入转储文件中列出的页面，由rmdb在数据库恢复完成后调用，预热不与redo、undo争用缓冲池。
+ *              预热在后台进行，数据库可以同时接受连接，访问尚未读入的页面时照常缺页读入
+ */
+void BufferPoolManager::start_warmup() {
+    stop_warmup();
+    std::string path;
+    {
+        std::scoped_lock lock{warmup_dump_latch_};
+        path = warmup_dump_path_;
+    }
+    if (path.empty()) {
+        return;
+    }
+    warmup_stop_ = false;
+    warmup_total_ = 0;
+    warmup_processed_ = 0;
+    warmup_loaded_ = 0;
+    warmup_active_ = true;
+    warmup_ = std::thread(&BufferPoolManager::warmup_loop, this, std::move(path));
+}
+
+/**
+ * @description: 停止预热线程并等待其退出，已提交的预读会照常完成
+ */
+void BufferPoolManager::stop_warmup() {
+    if (!warmup_.joinable()) {
+        return;
+    }
+    warmup_stop_ = true;
+    warmup_.join();
+}
+
+/**
+ * @description: 统计所有分片中空闲帧的个数
+ */
+size_t BufferPoolManager::count_free_frames() {
+    size_t num_free = 0;
+    for (auto &shard : shards_) {
+        std::shared_lock lock{shard->latch};
+        num_free += shard->free_list.size();
+    }
+    return num_free;
+}
+
+/**
+ * @description: 预热线程的主体。读入转储文件，丢弃已不存在的文件（没有打开）和超出文件末尾的页面，
+ *              按(fd, page_no)排序后每次把一个文件中至多MAX_WRITE_BACK_PAGES个页面交给prefetch_pages，
+ *              连续的页面合并为一次大的顺序读。预热只使用空闲帧：页面所属分片没有空闲帧时跳过该页面，
+ *              所有分片都没有空闲帧时停止，不淘汰任何已驻留的页面
+ * @param {string} path 转储文件的路径
+ */
+void BufferPoolManager::warmup_loop(std::string path) {
+    std::vector<PageId> page_ids;
+    std::ifstream ifs(path);
+    std::unordered_map<std::string, int> fds;
+    std::unordered_map<int, page_id_t> num_pages;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        auto pos = line.rfind(' ');
+        if (pos == std::string::npos || pos == 0) {
+            continue;
+        }
+        std::string file_name = line.substr(0, pos);
+        page_id_t page_no = static_cast<page_id_t>(std::strtol(line.c_str() + pos + 1, nullptr, 10));
+        auto fd_record = fds.find(file_name);
+        if (fd_record == fds.end()) {
+            int fd = disk_manager_->find_file_fd(file_name);
+            try {
+                num_pages[fd] = fd >= 0 ? disk_manager_->get_fd2pageno(fd) : 0;
+            } catch (RMDBError &) {
+                fd = -1;
+            }
+            fd_record = fds.emplace(file_name, fd).first;
+        }
+        int fd = fd_record->second;
+        if (fd >= 0 && page_no >= 0 && page_no < num_pages[fd]) {
+            page_ids.push_back({.fd = fd, .page_no = page_no});
+        }
+    }
+    std::sort(page_ids.begin(), page_ids.end());
+    page_ids.erase(std::unique(page_ids.begin(), page_ids.end()), page_ids.end());
+    page_ids.resize(std::min(page_ids.size(), get_pool_size()));
+    warmup_total_ = page_ids.size();
+
+    size_t begin = 0;
+    std::vector<page_id_t> batch;
+    while (begin < page_ids.size() && !warmup_stop_) {
+        size_t end = begin + 1;
+        while (end < page_ids.size() && end - begin < MAX_WRITE_BACK_PAGES && page_ids[end].fd == page_ids[begin].fd) {
+            end++;
+        }
+        if (count_free_frames() == 0) {
+            break;
+        }
+        batch.clear();
+        for (size_t i = begin; i < end; ++i) {
+            batch.push_back(page_ids[i].page_no);
+        }
+        try {
+            warmup_loaded_ += prefetch_pages(page_ids[begin].fd, batch, nullptr, true);
+        } catch (RMDBError &) {
+            // 文件在预热期间被关闭，跳过它的页面
+        }
+        warmup_processed_ += end - begin;
+        begin = end;
     }
+    warmup_active_ = false;
 }
\ No newline at end of file
@@ -12,8 +12,20 @@ See the Mulan PSL v2 for more details. */
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <array>
@@ -21,41 +33,266 @@ See the Mulan PSL v2 for more details. */
 #include "disk_manager.h"
 #include "errors.h"
 #include "page.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
 #include "replacer/replacer.h"
 
+/**
+ * @description: 一次批量写回的统计信息
+ */
+struct FlushStats {
+    size_t pages = 0;       // 写回的页面数
+    size_t bytes = 0;       // 写回的字节数
+    size_t syscalls = 0;    // 发出的写请求数，每个请求是一次pwritev或一个io_uring SQE
+};
+
+/**
+ * @description: 缓冲池预热的进度
+ */
+struct WarmupStats {
+    bool active = false;    // 预热线程正在运行
+    size_t total = 0;       // 转储文件中仍然有效的页面数，不超过帧数
+    size_t processed = 0;   // 已处理的页面数
+    size_t loaded = 0;      // 实际读入的页面数，已驻留的页面不计
+};
+
+/**
+ * @description: 缓冲池访问策略，即一个固定大小的环形缓冲区，用于大表的顺序扫描、LOAD和CREATE INDEX等批量操作。
+ * 通过策略缺页读入的页面只在环中的帧之间循环复用，不会把缓冲池中的热点页面逐出。
+ * 环按缓冲池的分片划分，每个分片中最多使用ring_size / 分片数个帧。一个策略同一时刻只能被一个线程使用
+ */
+class BufferAccessStrategy {
+    friend class BufferPoolManager;
+
+   public:
+    /**
+     * @param {size_t} ring_bytes 环形缓冲区的大小，按当前的PAGE_SIZE换算为帧数
+     */
+    explicit BufferAccessStrategy(size_t ring_bytes)
+        : id_(next_id_++), ring_size_(std::max<size_t>(ring_bytes / PAGE_SIZE, 1)) {}
+
+    size_t get_ring_size() const { return ring_size_; }
+
+   private:
+    struct Ring {
+        std::vector<frame_id_t> frames;     // 环中的帧
+        size_t capacity = 0;                // 环中最多的帧数
+        size_t next = 0;                    // 下一个复用的位置
+    };
+
+    Ring &get_ring(size_t shard_id, size_t num_shards) {
+        if (rings_.empty()) {
+            rings_.resize(num_shards);
+            for (auto &ring : rings_) {
+                ring.capacity = std::max<size_t>(ring_size_ / num_shards, 1);
+            }
+        }
+        return rings_[shard_id];
+    }
+
+    static inline std::atomic<uint64_t> next_id_{1};
+
+    uint64_t id_;                   // 策略的唯一标识，记录在通过该策略读入的帧的Page::ring_id_中
+    size_t ring_size_;              // 环形缓冲区的帧数
+    std::vector<Ring> rings_;       // 每个分片一个环，第一次使用时创建
+};
+
 class BufferPoolManager {
    private:
-    size_t pool_size_;      // buffer_pool中可容纳页面的个数，即帧的个数
-    Page *pages_;           // buffer_pool中的Page对象数组，在构造空间中申请内存空间，在析构函数中释放，大小为BUFFER_POOL_SIZE
-    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_; // 帧号和页面号的映射哈希表，用于根据页面的PageId定位该页面的帧编号
-    std::list<frame_id_t> free_list_;   // 空闲帧编号的链表
+    /**
+     * @description: 缓冲池的一个分片，拥有一段连续的帧以及这些帧的页表、空闲帧链表和置换策略。
+     * 每个页面按PageId的哈希值固定属于一个分片，不同分片上的操作只取各自的latch，互不阻塞
+     */
+    struct alignas(64) Shard {
+        size_t id;                          // 分片在shards_中的下标
+        std::unordered_map<PageId, frame_id_t, PageIdHash> page_table;  // 页面号和帧号的映射哈希表，只包含本分片的页面
+        std::list<frame_id_t> free_list;    // 本分片中空闲帧编号的链表
+        /**
+         * @description: 一个文件在本分片中的驻留帧链表（Page::file_next_），新加入的帧在表头
+         */
+        struct FileFrames {
+            frame_id_t head = INVALID_FRAME_ID;
+            frame_id_t tail = INVALID_FRAME_ID;     // 最早加入的帧，文件达到max_buffer_pct时从这里开始复用
+            size_t count = 0;                       // 文件在本分片中的驻留帧数
+        };
+        std::unordered_map<int, FileFrames> file_frames;    // 按文件写回和删除时只遍历该文件的帧
+        size_t num_pinned = 0;              // 优先级为PINNED的驻留帧数，不超过分片帧数的BUFFER_POOL_MAX_PINNED_PCT
+        std::unique_ptr<Replacer> replacer; // 本分片的置换策略，只在本分片的帧中选择淘汰页面
+        std::shared_mutex latch;            // 保护本分片的page_table、free_list和帧的元数据，磁盘I/O期间不持有；
+                                            // 命中的fetch_page和unpin_page只取共享锁，pin_count_和is_dirty_为原子变量
+        bool bgwriter_active = false;       // 后台写回线程正在为本分片补充干净帧，只由后台写回线程访问
+    };
+
+    std::atomic<size_t> pool_size_;     // buffer_pool中可容纳页面的个数，即帧的个数，只在持有所有分片的latch时由resize修改
+    Page *pages_;           // buffer_pool中的Page对象数组，在构造空间中申请内存空间，在析构函数中释放，大小为pool_size_
+    char *frames_;          // 所有帧的数据区，大小为pool_size_ * PAGE_SIZE，按大页对齐的匿名映射，满足O_DIRECT的对齐要求
+    size_t frames_bytes_;   // frames_映射的字节数
+    std::vector<std::unique_ptr<Shard>> shards_;    // 各个分片，第i个分片拥有第[i * pool_size_ / n, (i + 1) * pool_size_ / n)个帧
     DiskManager *disk_manager_;
-    Replacer *replacer_;    // buffer_pool的置换策略，当前赛题中为LRU置换策略
-    std::mutex latch_;      // 用于共享数据结构的并发控制
+    std::string replacer_type_ = REPLACER_TYPE;     // 当前的置换策略，resize重建各分片的replacer时使用
+    std::mutex resize_latch_;                       // 使resize互斥执行
+    std::shared_mutex policy_latch_;                // 保护file_policies_，在分片的latch之后获取
+    std::unordered_map<int, BufferPolicy> file_policies_;   // 设置了非默认缓冲池策略的文件
+
+    // 后台写回线程，周期性地将未固定的脏页写回磁盘，使淘汰时通常能直接选到干净帧
+    std::thread bgwriter_;
+    std::mutex bgwriter_latch_;                 // 保护bgwriter_stop_和bgwriter_wakeup_
+    std::condition_variable bgwriter_cv_;
+    bool bgwriter_stop_ = false;
+    bool bgwriter_wakeup_ = false;              // 前台线程淘汰了脏页，提前开始下一轮写回
+    std::atomic<int> bgwriter_delay_ms_{BGWRITER_DELAY_MS};
+    std::atomic<int> bgwriter_max_pages_{BGWRITER_MAX_PAGES};
+    std::atomic<int> bgwriter_low_watermark_{BGWRITER_LOW_WATERMARK};
+    std::atomic<int> bgwriter_high_watermark_{BGWRITER_HIGH_WATERMARK};
+    std::atomic<size_t> bgwriter_pages_written_{0};
+
+    /**
+     * @description: 一次在途的预读，完成前其中的帧标记为io_in_progress_且不能被淘汰
+     */
+    struct PrefetchRead {
+        std::future<void> io;               // 一段连续页面的异步读
+        std::vector<frame_id_t> frames;     // 读入的帧，按页号顺序排列
+    };
+
+    /**
+     * @description: 一个文件的顺序访问检测状态
+     */
+    struct ReadAheadState {
+        page_id_t last_page_no = INVALID_PAGE_ID;   // 上一次访问的页号
+        page_id_t prefetched_until = 0;             // 已预读到的页号（不含）
+        int window = 0;                             // 当前的预读窗口，为0表示尚未检测到顺序访问
+    };
+
+    // 预读完成线程，按提交顺序等待预读的I/O完成，然后将帧交给replacer
+    std::thread prefetcher_;
+    std::mutex prefetch_latch_;                 // 保护prefetch_queue_和prefetch_stop_
+    std::condition_variable prefetch_cv_;
+    std::deque<PrefetchRead> prefetch_queue_;
+    bool prefetch_stop_ = false;
+    std::mutex read_ahead_latch_;               // 保护read_ahead_states_
+    std::unordered_map<int, ReadAheadState> read_ahead_states_;
+    std::atomic<int> read_ahead_max_pages_{READ_AHEAD_MAX_PAGES};
+    std::atomic<size_t> prefetched_pages_{0};
+
+    // 缓冲池预热，转储驻留页面列表并在打开数据库后由预热线程读回
+    std::mutex warmup_dump_latch_;              // 保护warmup_dump_path_和last_dump_，转储期间持有
+    std::string warmup_dump_path_;              // 转储文件的绝对路径，为空时不转储
+    std::chrono::steady_clock::time_point last_dump_;
+    std::thread warmup_;
+    std::atomic<bool> warmup_stop_{false};
+    std::atomic<bool> warmup_active_{false};
+    std::atomic<size_t> warmup_total_{0};
+    std::atomic<size_t> warmup_processed_{0};
+    std::atomic<size_t> warmup_loaded_{0};
+
+    // 先写日志：写回页面前将日志刷新到页面的lsn，由rmdb在启动时设置为LogManager::flush_log_to_disk，未设置时不刷新
+    std::function<void(lsn_t)> flush_log_;
 
    public:
-    BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
+    /**
+     * @param {size_t} pool_size 帧的个数
+     * @param {size_t} num_shards 分片个数，为0时按pool_size / BUFFER_POOL_MIN_SHARD_SIZE选取，不超过BUFFER_POOL_NUM_SHARDS
+     */
+    BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t num_shards = 0)
         : pool_size_(pool_size), disk_manager_(disk_manager) {
-        // 为buffer pool分配一块连续的内存空间
+        // 为buffer pool分配一块连续的内存空间，帧数据单独按PAGE_SIZE对齐分配，使其可以直接用于O_DIRECT读写
         pages_ = new Page[pool_size_];
-        // 可以被Replacer改变
-        if (REPLACER_TYPE.compare("LRU"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else if (REPLACER_TYPE.compare("CLOCK"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else {
-            replacer_ = new LRUReplacer(pool_size_);
+        frames_ = nullptr;
+        frames_bytes_ = 0;
+        allocate_frames();
+        if (num_shards == 0) {
+            num_shards = std::clamp<size_t>(pool_size_ / BUFFER_POOL_MIN_SHARD_SIZE, 1, BUFFER_POOL_NUM_SHARDS);
         }
-        // 初始化时，所有的page都在free_list_中
-        for (size_t i = 0; i < pool_size_; ++i) {
-            free_list_.emplace_back(static_cast<frame_id_t>(i));  // static_cast转换数据类型
+        num_shards = std::clamp<size_t>(num_shards, 1, std::max<size_t>(pool_size_, 1));
+        for (size_t i = 0; i < num_shards; ++i) {
+            auto shard = std::make_unique<Shard>();
+            shard->id = i;
+            size_t begin = i * pool_size_ / num_shards;
+            size_t end = (i + 1) * pool_size_ / num_shards;
+            shard->replacer = create_replacer(replacer_type_, begin, end);
+            // 初始化时，分片的所有帧都在free_list中
+            for (size_t frame_id = begin; frame_id < end; ++frame_id) {
+                shard->free_list.emplace_back(static_cast<frame_id_t>(frame_id));  // static_cast转换数据类型
+            }
+            shards_.push_back(std::move(shard));
         }
     }
 
     ~BufferPoolManager() {
+        stop_warmup();
+        stop_bg_writer();
+        stop_prefetcher();
         delete[] pages_;
-        delete replacer_;
+        free_frame_memory(frames_, frames_bytes_);
+    }
+
+    size_t get_num_shards() const { return shards_.size(); }
+
+    size_t get_pool_size() const { return pool_size_; }
+
+    void resize(size_t pool_size,
+                std::chrono::milliseconds timeout = std::chrono::milliseconds(BUFFER_POOL_RESIZE_TIMEOUT_MS));
+
+    void set_replacer_type(const std::string &replacer_type);
+
+    void set_log_flusher(std::function<void(lsn_t)> flush_log) { flush_log_ = std::move(flush_log); }
+
+    static char *allocate_frame_memory(size_t bytes, size_t *mapped_bytes);
+
+    static void free_frame_memory(char *frames, size_t mapped_bytes);
+
+    void start_bg_writer();
+
+    void stop_bg_writer();
+
+    size_t bg_write_round();
+
+    int get_bgwriter_delay() const { return bgwriter_delay_ms_; }
+
+    void set_bgwriter_delay(int delay_ms) { bgwriter_delay_ms_ = delay_ms; }
+
+    int get_bgwriter_max_pages() const { return bgwriter_max_pages_; }
+
+    void set_bgwriter_max_pages(int max_pages) { bgwriter_max_pages_ = max_pages; }
+
+    int get_bgwriter_low_watermark() const { return bgwriter_low_watermark_; }
+
+    void set_bgwriter_low_watermark(int percent) { bgwriter_low_watermark_ = percent; }
+
+    int get_bgwriter_high_watermark() const { return bgwriter_high_watermark_; }
+
+    void set_bgwriter_high_watermark(int percent) { bgwriter_high_watermark_ = percent; }
+
+    size_t get_bgwriter_pages_written() const { return bgwriter_pages_written_; }
+
+    void read_ahead(int fd, page_id_t page_no, BufferAccessStrategy *strategy = nullptr);
+
+    size_t prefetch_pages(int fd, const std::vector<page_id_t> &page_nos, BufferAccessStrategy *strategy = nullptr,
+                          bool free_frames_only = false);
+
+    int get_read_ahead_max_pages() const { return read_ahead_max_pages_; }
+
+    void set_read_ahead_max_pages(int max_pages) { read_ahead_max_pages_ = max_pages; }
+
+    size_t get_prefetched_pages() const { return prefetched_pages_; }
+
+    void set_file_policy(int fd, const BufferPolicy &policy);
+
+    BufferPolicy get_file_policy(int fd);
+
+    size_t get_resident_pages(int fd);
+
+    void set_warmup_dump_path(const std::string &path);
+
+    size_t dump_resident_pages();
+
+    void start_warmup();
+
+    void stop_warmup();
+
+    WarmupStats get_warmup_stats() const {
+        return {warmup_active_, warmup_total_, warmup_processed_, warmup_loaded_};
     }
 
     /**
@@ -65,24 +302,99 @@ class BufferPoolManager {
     static void mark_dirty(Page* page) { page->is_dirty_ = true; }
 
    public: 
-    Page* fetch_page(PageId page_id);
+    Page* fetch_page(PageId page_id, BufferAccessStrategy *strategy = nullptr);
 
     bool unpin_page(PageId page_id, bool is_dirty);
 
+    bool unpin_page(Page *page, bool is_dirty);
+
     bool flush_page(PageId page_id);
 
-    Page* new_page(PageId* page_id);
+    Page* new_page(PageId* page_id, BufferAccessStrategy *strategy = nullptr);
 
     bool delete_page(PageId page_id);
 
     bool delete_all_page(int fd);
 
-    void flush_all_pages(int fd);
+    FlushStats flush_all_pages(int fd);
+
+    FlushStats flush_all_page();
 
-    void flush_all_page();
+    void set_page_size(int page_size);
 
    private:
-    bool find_victim_page(frame_id_t* frame_id);
+    void allocate_frames();
+
+    static std::unique_ptr<Replacer> create_replacer(const std::string &replacer_type, size_t begin, size_t end);
+
+    /**
+     * @description: 获得页面所属的分片，PageId经乘法哈希打散，使同一文件的相邻页面分布在不同分片中
+     */
+    Shard &get_shard(const PageId &page_id) {
+        uint64_t hash = static_cast<uint64_t>(PageIdHash()(page_id)) * 0x9e3779b97f4a7c15ULL;
+        return *shards_[(hash >> 32) % shards_.size()];
+    }
+
+    std::vector<std::unique_lock<std::shared_mutex>> lock_all_shards();
+
+    bool find_victim_page(Shard &shard, int fd, frame_id_t* frame_id, BufferAccessStrategy *strategy = nullptr);
+
+    bool find_quota_victim(Shard &shard, int fd, frame_id_t *frame_id);
+
+    void make_evictable(Shard &shard, frame_id_t frame_id);
+
+    void set_frame_priority(Shard &shard, frame_id_t frame_id, BufferPriority priority);
+
+    void release_frame(Shard &shard, frame_id_t frame_id);
+
+    bool unpin_frame(Shard &shard, frame_id_t frame_id, bool is_dirty);
+
+    static void wait_pin_released(Page &page);
+
+    void resize_frames(size_t pool_size);
+
+    void link_file_frame(Shard &shard, frame_id_t frame_id);
+
+    void unlink_file_frame(Shard &shard, frame_id_t frame_id);
+
+    template <typename Func>
+    void for_each_file_frame(int fd, Func &&func);
+
+    void load_frame(Shard &shard, std::unique_lock<std::shared_mutex> &lock, frame_id_t frame_id, PageId page_id, bool read,
+                    BufferAccessStrategy *strategy);
+
+    Page *pin_resident_page(Shard &shard, std::unique_lock<std::shared_mutex> &lock, PageId page_id);
+
+    void update_page(Shard &shard, Page* page, PageId new_page_id, frame_id_t new_frame_id);
+
+    FlushStats write_back_frames(std::vector<frame_id_t>& frames);
+
+    FlushStats write_frames(std::vector<frame_id_t>& frames);
+
+    void flush_log_to(lsn_t lsn);
+
+    void wait_file_io(std::vector<std::unique_lock<std::shared_mutex>> &locks, int fd);
+
+    void wait_shard_io(Shard &shard, std::unique_lock<std::shared_mutex> &lock);
+
+    void begin_write_back(Shard &shard, frame_id_t frame_id);
+
+    FlushStats write_back_in_progress(std::vector<frame_id_t>& frames);
+
+    void bg_writer_loop();
+
+    void wake_bg_writer();
+
+    void prefetch_loop();
+
+    void finish_prefetch(const std::vector<frame_id_t> &frames, bool success);
+
+    void stop_prefetcher();
+
+    size_t count_free_frames();
+
+    void warmup_loop(std::string path);
 
-    void update_page(Page* page, PageId new_page_id, frame_id_t new_frame_id);
+    // 一次合并写回的最大页面数，不超过IOV_MAX
+    static constexpr int MAX_WRITE_BACK_PAGES = 256;
 };
\ No newline at end of file
@@ -11,14 +11,203 @@ See the Mulan PSL v2 for more details. */
 #include "storage/disk_manager.h"
 
 #include <assert.h>    // for assert
+#include <limits.h>    // for PATH_MAX
 #include <string.h>    // for memset
 #include <sys/stat.h>  // for stat
-#include <unistd.h>    // for lseek
+#include <unistd.h>    // for pread/pwrite
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
 
 #include "defs.h"
 
-DiskManager::DiskManager() { std::fill_n(fd2pageno_, MAX_FD, 0); }
+DiskManager::DiskManager() {}
+
+/**
+ * @description: 以pread/pwrite为基础的定位读写，不修改fd共享的文件偏移量，因此多个线程可以并发读写同一个文件
+ * 出现短读/短写时继续完成剩余部分，被信号打断时重试
+ * @return {ssize_t} 实际完成的字节数，出错时返回-1
+ */
+static ssize_t pread_full(int fd, char *buf, size_t count, off_t offset) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t n = pread(fd, buf + done, count - done, offset + done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        if (n == 0) break;  // 到达文件末尾
+        done += n;
+    }
+    return done;
+}
+
+static ssize_t pwrite_full(int fd, const char *buf, size_t count, off_t offset) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t n = pwrite(fd, buf + done, count - done, offset + done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        done += n;
+    }
+    return done;
+}
+
+/**
+ * @description: 将path所在目录fsync到磁盘，使其中文件的创建、重命名和删除在崩溃后不会回退
+ */
+static void fsync_parent_dir(const std::string &path) {
+    auto pos = path.find_last_of('/');
+    std::string dir = pos == std::string::npos ? "." : path.substr(0, pos + 1);
+    int dir_fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dir_fd < 0) {
+        throw UnixError();
+    }
+    int ret = fsync(dir_fd);
+    close(dir_fd);
+    if (ret != 0) {
+        throw UnixError();
+    }
+}
+
+/**
+ * @description: O_DIRECT要求缓冲区地址、长度和文件偏移量都按块大小对齐，这里统一按PAGE_SIZE对齐
+ */
+static bool is_page_aligned(const void *ptr, size_t len) {
+    return reinterpret_cast<uintptr_t>(ptr) % PAGE_SIZE == 0 && len % PAGE_SIZE == 0;
+}
+
+/**
+ * @description: 对于O_DIRECT打开的文件，通过一块对齐的中转缓冲区完成不满足对齐要求的读写，
+ * 如RmFileHandle和IxManager只写sizeof(RmFileHdr)或tot_len_字节的文件头。
+ * 写入长度不是PAGE_SIZE的整数倍时，先读出最后一个页面再覆盖前面的部分（read-modify-write）
+ * @return {bool} 读写成功则返回true，出错或读到文件末尾则返回false
+ * @param {off_t} pos 文件偏移量，必须按PAGE_SIZE对齐
+ */
+static bool bounce_direct_io(bool is_write, int fd, off_t pos, const struct iovec *iov, int iovcnt) {
+    size_t total = 0;
+    for (int i = 0; i < iovcnt; i++) total += iov[i].iov_len;
+    size_t len = (total + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    if (len == 0) return true;
+    std::unique_ptr<char, decltype(&std::free)> bounce(static_cast<char *>(std::aligned_alloc(PAGE_SIZE, len)),
+                                                       &std::free);
+    if (bounce == nullptr) return false;
+
+    // O_DIRECT下文件末尾之后的偏移不再对齐，因此只调用一次pread，不像pread_full那样继续读剩余部分
+    auto pread_once = [fd](char *buf, size_t count, off_t offset) {
+        ssize_t n = pread(fd, buf, count, offset);
+        while (n < 0 && errno == EINTR) n = pread(fd, buf, count, offset);
+        return n;
+    };
+
+    if (is_write) {
+        if (total < len) {
+            char *tail = bounce.get() + len - PAGE_SIZE;
+            ssize_t n = pread_once(tail, PAGE_SIZE, pos + len - PAGE_SIZE);
+            if (n < 0) return false;
+            memset(tail + n, 0, PAGE_SIZE - n);
+        }
+        char *dst = bounce.get();
+        for (int i = 0; i < iovcnt; i++) {
+            memcpy(dst, iov[i].iov_base, iov[i].iov_len);
+            dst += iov[i].iov_len;
+        }
+        return pwrite_full(fd, bounce.get(), len, pos) == static_cast<ssize_t>(len);
+    }
+
+    ssize_t n = pread_once(bounce.get(), len, pos);
+    if (n < 0 || static_cast<size_t>(n) < total) return false;
+    const char *src = bounce.get();
+    for (int i = 0; i < iovcnt; i++) {
+        memcpy(iov[i].iov_base, src, iov[i].iov_len);
+        src += iov[i].iov_len;
+    }
+    return true;
+}
+
+/**
+ * @description: 向量读写出现短读/短写时，跳过已完成的done字节，逐个缓冲区补齐剩余部分
+ * @return {bool} 剩余部分全部完成则返回true，出错或读到文件末尾则返回false
+ */
+static bool finish_partial_io(bool is_write, int fd, off_t pos, const struct iovec *iov, int iovcnt, size_t done) {
+    for (int i = 0; i < iovcnt; i++) {
+        size_t len = iov[i].iov_len;
+        if (done >= len) {
+            done -= len;
+            pos += len;
+            continue;
+        }
+        char *base = static_cast<char *>(iov[i].iov_base) + done;
+        ssize_t n = is_write ? pwrite_full(fd, base, len - done, pos + done)
+                             : pread_full(fd, base, len - done, pos + done);
+        if (n < 0 || static_cast<size_t>(n) != len - done) {
+            return false;
+        }
+        pos += len;
+        done = 0;
+    }
+    return true;
+}
+
+static size_t iov_total_len(const struct iovec *iov, int iovcnt) {
+    size_t total = 0;
+    for (int i = 0; i < iovcnt; i++) total += iov[i].iov_len;
+    return total;
+}
+
+/**
+ * @description: 判断一次读写是否需要经过中转缓冲区，即文件以O_DIRECT打开且缓冲区或长度没有对齐
+ */
+bool DiskManager::need_bounce(const OpenFile *file, const struct iovec *iov, int iovcnt) const {
+    if (!file->direct_io) return false;
+    for (int i = 0; i < iovcnt; i++) {
+        if (!is_page_aligned(iov[i].iov_base, iov[i].iov_len)) return true;
+    }
+    return false;
+}
+
+/**
+ * @description: 在Unix fd的pos处完成一次向量读写，不满足O_DIRECT对齐要求时经过中转缓冲区
+ * @return {bool} 全部完成则返回true，出错或读到文件末尾则返回false
+ */
+static bool vectored_io(bool is_write, int fd, off_t pos, const struct iovec *iov, int iovcnt, bool bounce) {
+    if (bounce) {
+        return bounce_direct_io(is_write, fd, pos, iov, iovcnt);
+    }
+    ssize_t size = is_write ? pwritev(fd, iov, iovcnt, pos) : preadv(fd, iov, iovcnt, pos);
+    while (size < 0 && errno == EINTR) {
+        size = is_write ? pwritev(fd, iov, iovcnt, pos) : preadv(fd, iov, iovcnt, pos);
+    }
+    // 短读/短写时补齐剩余部分，仍读不满说明越过了文件末尾
+    return size >= 0 && (static_cast<size_t>(size) == iov_total_len(iov, iovcnt) ||
+                         finish_partial_io(is_write, fd, pos, iov, iovcnt, size));
+}
+
+/**
+ * @description: 同步读写文件中从start_page_no开始的连续页面。独立文件一次preadv/pwritev完成；
+ * 表空间中的文件先映射为段文件中物理连续的若干段，逐段读写，写入时为尚未分配的区分配物理区
+ */
+void DiskManager::do_io(bool is_write, int fd, page_id_t start_page_no, const struct iovec *iov, int iovcnt,
+                        const char *error_msg) {
+    OpenFile *file = get_open_file(fd);
+    (is_write ? file->num_writes : file->num_reads).fetch_add(1, std::memory_order_relaxed);
+    bool bounce = need_bounce(file, iov, iovcnt);
+    if (file->space_id < 0) {
+        if (!vectored_io(is_write, fd, static_cast<off_t>(start_page_no) * PAGE_SIZE, iov, iovcnt, bounce)) {
+            throw InternalError(error_msg);
+        }
+        return;
+    }
+    std::vector<IoSegment> segments;
+    if (!tablespace_->map_io(file->space_id, start_page_no, iov, iovcnt, is_write, segments)) {
+        throw InternalError(error_msg);  // 读取尚未分配的区，即越过了文件末尾
+    }
+    for (auto &segment : segments) {
+        if (!vectored_io(is_write, segment.fd, segment.pos, segment.iov.data(), segment.iov.size(), bounce)) {
+            throw InternalError(error_msg);
+        }
+    }
+}
 
 /**
  * @description: 将数据写入文件的指定磁盘页面中
@@ -28,22 +217,8 @@ DiskManager::DiskManager() { std::fill_n(fd2pageno_, MAX_FD, 0); }
  * @param {int} num_bytes 要写入磁盘的数据大小
  */
 void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int num_bytes) {
-    // Todo:
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
-    // 2.调用write()函数
-    // 注意write返回值与num_bytes不等时 throw InternalError("DiskManager::write_page Error");
-
-    // 尝试定位到指定页面
-    off_t pos = lseek(fd, page_no * PAGE_SIZE, SEEK_SET);
-    if (pos == -1) {
-        throw UnixError();
-    }
-
-    // write返回值与num_bytes不等时 throw InternalError("DiskManager::write_page Error");
-    ssize_t write_size = write(fd, offset, num_bytes);
-    if (write_size != num_bytes) {
-        throw InternalError("DiskManager::write_page Error");
-    }
+    struct iovec iov = {.iov_base = const_cast<char *>(offset), .iov_len = static_cast<size_t>(num_bytes)};
+    do_io(true, fd, page_no, &iov, 1, "DiskManager::write_page Error");
 }
 
 /**
@@ -54,36 +229,357 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
  * @param {int} num_bytes 读取的数据量大小
  */
 void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_bytes) {
-    // Todo:
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
-    // 2.调用read()函数
-    // 注意read返回值与num_bytes不等时，throw InternalError("DiskManager::read_page Error");
+    struct iovec iov = {.iov_base = offset, .iov_len = static_cast<size_t>(num_bytes)};
+    do_io(false, fd, page_no, &iov, 1, "DiskManager::read_page Error");
+}
+
+/**
+ * @description: 将多个缓冲区的数据写入文件中从start_page_no开始的连续页面，一次pwritev完成
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 写入的第一个页面编号
+ * @param {iovec} *iov 待写入的缓冲区数组，按顺序连续写入磁盘
+ * @param {int} iovcnt 缓冲区个数，不超过IOV_MAX
+ */
+void DiskManager::write_pages(int fd, page_id_t start_page_no, const struct iovec *iov, int iovcnt) {
+    do_io(true, fd, start_page_no, iov, iovcnt, "DiskManager::write_pages Error");
+}
+
+/**
+ * @description: 将文件中从start_page_no开始的连续页面读入多个缓冲区，一次preadv完成
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 读取的第一个页面编号
+ * @param {iovec} *iov 存放读取结果的缓冲区数组
+ * @param {int} iovcnt 缓冲区个数，不超过IOV_MAX
+ */
+void DiskManager::read_pages(int fd, page_id_t start_page_no, const struct iovec *iov, int iovcnt) {
+    do_io(false, fd, start_page_no, iov, iovcnt, "DiskManager::read_pages Error");
+}
+
+/**
+ * @description: 切换异步I/O引擎，旧引擎在途的请求会先全部完成
+ * @param {IoEngineType} type 引擎类型，io_uring不可用时回退为同步引擎
+ * @param {unsigned} queue_depth 最多同时在途的请求数
+ */
+void DiskManager::set_io_engine(IoEngineType type, unsigned queue_depth) {
+    auto engine = IoEngine::create(type, queue_depth);
+    std::scoped_lock lock{io_engine_latch_};
+    io_engine_ = std::move(engine);
+}
+
+/**
+ * @description: 获得当前的异步I/O引擎，第一次调用时根据IO_ENGINE_TYPE创建
+ */
+IoEngine *DiskManager::get_io_engine() {
+    std::scoped_lock lock{io_engine_latch_};
+    if (io_engine_ == nullptr) {
+        io_engine_ = IoEngine::create(IO_ENGINE_TYPE == "SYNC" ? IoEngineType::SYNC : IoEngineType::IO_URING,
+                                      IO_ENGINE_QUEUE_DEPTH);
+    }
+    return io_engine_.get();
+}
+
+/**
+ * @description: 通过io_engine_提交一个页面粒度的向量读写请求，完成后就绪返回的future
+ * 表空间中的文件映射为多段时每段各提交一个请求，全部完成后才就绪future
+ * 引擎报告短读/短写时在回调中同步补齐剩余部分，仍失败则在future中设置异常
+ */
+std::future<void> DiskManager::submit_async_io(bool is_write, int fd, page_id_t start_page_no,
+                                               const struct iovec *iov, int iovcnt) {
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future();
+    const char *error_msg = is_write ? "DiskManager::async_write_page Error" : "DiskManager::async_read_page Error";
+    OpenFile *file = get_open_file(fd);
+    // 不满足O_DIRECT对齐要求的请求（只有文件头等少量读写）直接同步完成
+    if (need_bounce(file, iov, iovcnt)) {
+        try {
+            do_io(is_write, fd, start_page_no, iov, iovcnt, error_msg);
+            promise->set_value();
+        } catch (RMDBError &) {
+            promise->set_exception(std::current_exception());
+        }
+        return future;
+    }
+    (is_write ? file->num_writes : file->num_reads).fetch_add(1, std::memory_order_relaxed);
+    std::vector<IoSegment> segments;
+    if (file->space_id < 0) {
+        segments.push_back(IoSegment{fd, static_cast<off_t>(start_page_no) * PAGE_SIZE,
+                                     std::vector<struct iovec>(iov, iov + iovcnt)});
+    } else if (!tablespace_->map_io(file->space_id, start_page_no, iov, iovcnt, is_write, segments)) {
+        promise->set_exception(std::make_exception_ptr(InternalError(error_msg)));
+        return future;
+    }
+
+    // 最后一段完成时就绪future，任意一段失败则设置异常
+    auto remaining = std::make_shared<std::atomic<size_t>>(segments.size());
+    auto failed = std::make_shared<std::atomic<bool>>(false);
+    for (auto &segment : segments) {
+        size_t total = iov_total_len(segment.iov.data(), segment.iov.size());
+        auto callback = [promise, remaining, failed, is_write, error_msg, total, segment](ssize_t res) {
+            if (res < 0 || (static_cast<size_t>(res) != total &&
+                            !finish_partial_io(is_write, segment.fd, segment.pos, segment.iov.data(),
+                                               segment.iov.size(), res))) {
+                failed->store(true);
+            }
+            if (remaining->fetch_sub(1) == 1) {
+                if (failed->load()) {
+                    promise->set_exception(std::make_exception_ptr(InternalError(error_msg)));
+                } else {
+                    promise->set_value();
+                }
+            }
+        };
+        if (is_write) {
+            get_io_engine()->submit_write(segment.fd, segment.pos, segment.iov.data(), segment.iov.size(),
+                                          std::move(callback));
+        } else {
+            get_io_engine()->submit_read(segment.fd, segment.pos, segment.iov.data(), segment.iov.size(),
+                                         std::move(callback));
+        }
+    }
+    return future;
+}
+
+/**
+ * @description: 异步地将数据写入文件的指定页面，offset指向的数据在future就绪前必须保持有效
+ */
+std::future<void> DiskManager::async_write_page(int fd, page_id_t page_no, const char *offset, int num_bytes) {
+    struct iovec iov = {.iov_base = const_cast<char *>(offset), .iov_len = static_cast<size_t>(num_bytes)};
+    return submit_async_io(true, fd, page_no, &iov, 1);
+}
+
+/**
+ * @description: 异步地读取文件中指定页面的数据，offset指向的缓冲区在future就绪前必须保持有效
+ */
+std::future<void> DiskManager::async_read_page(int fd, page_id_t page_no, char *offset, int num_bytes) {
+    struct iovec iov = {.iov_base = offset, .iov_len = static_cast<size_t>(num_bytes)};
+    return submit_async_io(false, fd, page_no, &iov, 1);
+}
+
+/**
+ * @description: 异步地将多个缓冲区写入从start_page_no开始的连续页面
+ */
+std::future<void> DiskManager::async_write_pages(int fd, page_id_t start_page_no, const struct iovec *iov,
+                                                 int iovcnt) {
+    return submit_async_io(true, fd, start_page_no, iov, iovcnt);
+}
 
-    // 尝试定位到指定位置
-    off_t pos = lseek(fd, page_no * PAGE_SIZE, SEEK_SET);
-    if (pos == -1) {
+/**
+ * @description: 异步地将从start_page_no开始的连续页面读入多个缓冲区
+ */
+std::future<void> DiskManager::async_read_pages(int fd, page_id_t start_page_no, const struct iovec *iov,
+                                                int iovcnt) {
+    return submit_async_io(false, fd, start_page_no, iov, iovcnt);
+}
+
+/**
+ * @description: 获得打开的文件，返回的指针在close_file之前保持有效
+ * @param {int} fd 文件句柄，Unix fd或表空间中的虚拟fd
+ */
+DiskManager::OpenFile *DiskManager::get_open_file(int fd) {
+    std::shared_lock lock{fd_latch_};
+    auto file = files_.find(fd);
+    if (file == files_.end()) {
+        throw FileNotOpenError(fd);
+    }
+    return file->second.get();
+}
+
+/**
+ * @description: 获得当前目录的表空间，第一次使用或切换了数据库目录时打开当前目录下的表空间
+ * 读写已打开的文件时直接使用tablespace_，切换数据库目录前需关闭所有文件
+ */
+Tablespace *DiskManager::get_tablespace() {
+    std::scoped_lock lock{tablespace_latch_};
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) == nullptr) {
         throw UnixError();
     }
-    // 读取指定页面，检查read的返回值
-    ssize_t read_size = read(fd, offset, num_bytes);
-    // read返回值与num_bytes不等时，throw InternalError("DiskManager::read_page Error");
-    if (read_size != num_bytes) {
-        throw InternalError("DiskManager::read_page Error");
+    if (tablespace_ == nullptr || tablespace_->get_dir() != cwd) {
+        tablespace_ = std::make_unique<Tablespace>(direct_io_);
     }
+    return tablespace_.get();
 }
 
 /**
- * @description: 分配一个新的页号
+ * @description: 分配一个新的页号，优先重用空闲页表中已释放的页面，否则在文件末尾分配
  * @return {page_id_t} 分配的新页号
  * @param {int} fd 指定文件的文件句柄
  */
 page_id_t DiskManager::allocate_page(int fd) {
-    // 简单的自增分配策略，指定文件的页面编号加1
-    assert(fd >= 0 && fd < MAX_FD);
-    return fd2pageno_[fd]++;
+    OpenFile *file = get_open_file(fd);
+    {
+        FreePageMap &free_map = file->free_map;
+        std::scoped_lock lock{free_map.latch};
+        if (!free_map.pages.empty()) {
+            page_id_t page_no = *free_map.pages.begin();
+            free_map.pages.erase(free_map.pages.begin());
+            free_map.dirty = true;
+            // 磁盘上的空闲页表可能包含重用的页面，需在使用页面之前删除，否则崩溃重启后可能被再次分配
+            if (free_map.on_disk) {
+                drop_free_page_map(file);
+            }
+            return page_no;
+        }
+    }
+    // 没有空闲页面时使用自增分配策略，指定文件的页面编号加1，超出预分配的空间时扩展文件
+    page_id_t page_no = file->num_pages++;
+    if (static_cast<off_t>(page_no + 1) * PAGE_SIZE > file->extent.load()) {
+        extend_file(fd, file, page_no);
+    }
+    return page_no;
+}
+
+/**
+ * @description: 以extend_size_为粒度用fallocate预分配文件空间，使按页追加的文件在磁盘上保持连续，
+ * 预分配之后文件的物理大小大于逻辑末尾，未写过的页面读出为全0。表空间中的文件为页面所在的区分配物理区
+ * @param {int} fd 文件句柄
+ * @param {page_id_t} page_no 需要容纳的页号
+ */
+void DiskManager::extend_file(int fd, OpenFile *file, page_id_t page_no) {
+    if (file->space_id >= 0) {
+        file->extent.store(tablespace_->extend_space(file->space_id, page_no));
+        return;
+    }
+    if (extend_size_ == 0) {
+        return;
+    }
+    std::scoped_lock lock{extend_latch_};
+    off_t extent = file->extent.load();
+    off_t required = static_cast<off_t>(page_no + 1) * PAGE_SIZE;
+    if (required <= extent) {
+        return;  // 已被其他线程扩展
+    }
+    // 文件系统不支持fallocate时不预分配，由写入自然扩展文件
+    off_t new_extent = required;
+    if (!file->fallocate_unsupported) {
+        new_extent = (required + extend_size_ - 1) / extend_size_ * extend_size_;
+        if (fallocate(fd, 0, extent, new_extent - extent) != 0) {
+            if (errno != EOPNOTSUPP) {
+                throw UnixError();
+            }
+            file->fallocate_unsupported = true;
+            new_extent = required;
+        }
+    }
+    file->extent.store(new_extent);
+}
+
+/**
+ * @description: 释放一个页面，将其加入文件的空闲页表，之后allocate_page可以重新分配该页面。
+ * 空闲页表在关闭文件时才写入磁盘，崩溃时释放的页面丢失，只浪费空间
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} page_no 释放的页号，调用者需保证该页面不再被引用，且已从缓冲池中删除
+ */
+void DiskManager::deallocate_page(int fd, page_id_t page_no) {
+    OpenFile *file = get_open_file(fd);
+    assert(page_no >= 0 && page_no < file->num_pages);
+    std::scoped_lock lock{file->free_map.latch};
+    file->free_map.pages.insert(page_no);
+    file->free_map.dirty = true;
+}
+
+/**
+ * @description: 获得文件空闲页表中的页面个数
+ * @param {int} fd 指定文件的文件句柄
+ */
+size_t DiskManager::get_free_page_count(int fd) {
+    OpenFile *file = get_open_file(fd);
+    std::scoped_lock lock{file->free_map.latch};
+    return file->free_map.pages.size();
+}
+
+/**
+ * @description: 打开文件时加载空闲页表。独立文件的空闲页表文件格式为连续存放的page_id_t，
+ * 表空间中的文件从表空间目录中加载
+ * @param {OpenFile} *file 尚未登记到文件打开列表中的文件
+ */
+void DiskManager::load_free_page_map(OpenFile *file) {
+    FreePageMap &free_map = file->free_map;
+    free_map.path = file->path + FREE_PAGE_MAP_SUFFIX;
+    if (file->space_id >= 0) {
+        free_map.pages = get_tablespace()->get_free_pages(file->space_id);
+        free_map.on_disk = !free_map.pages.empty();
+        return;
+    }
+    int map_fd = open(free_map.path.c_str(), O_RDONLY);
+    if (map_fd >= 0) {
+        struct stat stat_buf;
+        if (fstat(map_fd, &stat_buf) != 0) {
+            close(map_fd);
+            throw UnixError();
+        }
+        std::vector<page_id_t> pages(stat_buf.st_size / sizeof(page_id_t));
+        ssize_t size = pages.size() * sizeof(page_id_t);
+        ssize_t read_size = pread_full(map_fd, reinterpret_cast<char *>(pages.data()), size, 0);
+        close(map_fd);
+        if (read_size != size) {
+            throw InternalError("DiskManager::load_free_page_map Error");
+        }
+        free_map.pages.insert(pages.begin(), pages.end());
+        free_map.on_disk = true;
+    }
+}
+
+/**
+ * @description: 关闭文件时将空闲页表整体写入空闲页表文件，空闲页表为空时删除该文件，调用者需持有空闲页表的latch
+ * 释放页面之前引用它的页面（如记录文件的文件头）已经写入文件，先将文件fsync到磁盘，再写临时文件并重命名，
+ * 崩溃时磁盘上要么是旧的要么是新的空闲页表，且其中的页面都已不再被引用
+ */
+void DiskManager::persist_free_page_map(int fd, OpenFile *file) {
+    FreePageMap &free_map = file->free_map;
+    if (free_map.pages.empty()) {
+        drop_free_page_map(file);
+        free_map.dirty = false;
+        return;
+    }
+    if (file->space_id >= 0) {
+        tablespace_->set_free_pages(file->space_id, free_map.pages);
+        free_map.on_disk = true;
+        free_map.dirty = false;
+        return;
+    }
+    if (fdatasync(fd) != 0) {
+        throw UnixError();
+    }
+    std::vector<page_id_t> pages(free_map.pages.begin(), free_map.pages.end());
+    ssize_t size = pages.size() * sizeof(page_id_t);
+    std::string tmp_path = free_map.path + ".tmp";
+    int map_fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (map_fd < 0) {
+        throw UnixError();
+    }
+    ssize_t write_size = pwrite_full(map_fd, reinterpret_cast<const char *>(pages.data()), size, 0);
+    bool synced = write_size == size && fsync(map_fd) == 0;
+    close(map_fd);
+    if (!synced) {
+        throw InternalError("DiskManager::persist_free_page_map Error");
+    }
+    if (rename(tmp_path.c_str(), free_map.path.c_str()) != 0) {
+        throw UnixError();
+    }
+    fsync_parent_dir(free_map.path);
+    free_map.on_disk = true;
+    free_map.dirty = false;
 }
 
-void DiskManager::deallocate_page(__attribute__((unused)) page_id_t page_id) {}
+/**
+ * @description: 删除磁盘上的空闲页表，返回前删除已fsync到磁盘，调用者需持有空闲页表的latch
+ */
+void DiskManager::drop_free_page_map(OpenFile *file) {
+    FreePageMap &free_map = file->free_map;
+    if (!free_map.on_disk) {
+        return;
+    }
+    if (file->space_id >= 0) {
+        tablespace_->set_free_pages(file->space_id, {});
+    } else {
+        if (unlink(free_map.path.c_str()) != 0 && errno != ENOENT) {
+            throw UnixError();
+        }
+        fsync_parent_dir(free_map.path);
+    }
+    free_map.on_disk = false;
+}
 
 bool DiskManager::is_dir(const std::string& path) {
     struct stat st;
@@ -111,6 +607,9 @@ void DiskManager::destroy_dir(const std::string &path) {
  * @param {string} &path 指定路径文件
  */
 bool DiskManager::is_file(const std::string &path) {
+    if (is_tablespace_file(path)) {
+        return get_tablespace()->exists(path);
+    }
     // 用struct stat获取文件信息
     struct stat st;
     return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
@@ -126,6 +625,10 @@ void DiskManager::create_file(const std::string &path) {
     // 调用open()函数，使用O_CREAT模式
     // 注意不能重复创建相同文件
 
+    if (is_tablespace_file(path)) {
+        get_tablespace()->create_space(path);
+        return;
+    }
     // 以读写模式打开文件，如果文件不存在则创建
     int fd = open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
 
@@ -152,11 +655,17 @@ void DiskManager::destroy_file(const std::string &path) {
     // 注意不能删除未关闭的文件
 
     // 判断文件是否已经关闭
+    std::shared_lock lock{fd_latch_};
     if (path2fd_.find(path) != path2fd_.end()) {
         throw FileNotClosedError(path);
     }
-    // 调用unlink()函数
+    if (is_tablespace_file(path)) {
+        get_tablespace()->drop_space(path);
+        return;
+    }
+    // 调用unlink()函数，同时删除该文件的空闲页表文件
     int result = unlink(path.c_str());
+    unlink((path + FREE_PAGE_MAP_SUFFIX).c_str());
 
     // 检查unlink()函数的返回值，了解操作是否成功
     if (result != 0) {
@@ -176,26 +685,59 @@ int DiskManager::open_file(const std::string &path) {
     // 调用open()函数，使用O_RDWR模式
     // 注意不能重复打开相同文件，并且需要更新文件打开列表
 
+    std::unique_lock lock{fd_latch_};
+    return open_file_locked(path, direct_io_);
+}
+
+/**
+ * @description: 打开指定路径文件并登记到文件打开列表中，调用者需持有fd_latch_的独占锁
+ * @return {int} 返回打开的文件的文件句柄，表空间中的文件返回虚拟fd
+ * @param {string} &path 文件所在路径
+ * @param {bool} direct_io 是否使用O_DIRECT打开，文件系统不支持时（如tmpfs）退回普通I/O
+ */
+int DiskManager::open_file_locked(const std::string &path, bool direct_io) {
     if (path2fd_.find(path) != path2fd_.end()) {
         throw FileNotClosedError(path);
     }
-    // 打开文件
-    int fd = open(path.c_str(), O_RDWR);
-
-    // 检查是否打开成功
-    if (fd < 0) {
-        if (errno == ENOENT) {
-            throw FileNotFoundError(path);
-        } else {
+    auto file = std::make_unique<OpenFile>();
+    file->path = path;
+    int fd;
+    if (is_tablespace_file(path)) {
+        // 表空间中的文件不占用Unix fd
+        file->space_id = get_tablespace()->get_space_id(path);
+        file->direct_io = direct_io;
+        file->extent = tablespace_->get_space_size(file->space_id);
+        fd = TABLESPACE_FD_BASE + file->space_id;
+    } else {
+        // 打开文件
+        fd = direct_io ? open(path.c_str(), O_RDWR | O_DIRECT) : -1;
+        if (fd < 0 && direct_io && errno == EINVAL) {
+            std::cerr << "O_DIRECT is not supported for " << path << ", fall back to buffered I/O" << std::endl;
+        }
+        file->direct_io = direct_io && fd >= 0;
+        if (!file->direct_io) {
+            fd = open(path.c_str(), O_RDWR);
+        }
+        // 检查是否打开成功
+        if (fd < 0) {
+            if (errno == ENOENT) {
+                throw FileNotFoundError(path);
+            }
             throw UnixError();
         }
-        return -1;
-    } else {
-        // 成功打开文件，更新文件打开列表
-        path2fd_[path] = fd;
-        fd2path_[fd] = path;
-        return fd;
+        struct stat stat_buf;
+        file->extent = fstat(fd, &stat_buf) == 0 ? stat_buf.st_size : 0;
+    }
+    // 成功打开文件，加载空闲页表并更新文件打开列表
+    try {
+        load_free_page_map(file.get());
+    } catch (RMDBError &) {
+        if (file->space_id < 0) close(fd);
+        throw;
     }
+    path2fd_[path] = fd;
+    files_[fd] = std::move(file);
+    return fd;
 }
 
 /**
@@ -207,16 +749,28 @@ void DiskManager::close_file(int fd) {
     // 调用close()函数
     // 注意不能关闭未打开的文件，并且需要更新文件打开列表
 
-    if (fd2path_.find(fd) == fd2path_.end()) {
+    {
+        // 调用者在关闭前已将文件的页面写回，此时写入空闲页表，避免持有fd_latch_进行fsync
+        OpenFile *file = get_open_file(fd);
+        std::scoped_lock lock{file->free_map.latch};
+        if (file->free_map.dirty) {
+            persist_free_page_map(fd, file);
+        }
+    }
+    std::unique_lock lock{fd_latch_};
+    auto fd_record = files_.find(fd);
+    if (fd_record == files_.end()) {
         throw FileNotOpenError(fd);
     }
-    close(fd);
+    OpenFile *file = fd_record->second.get();
     // 在path2fd_中删除打开记录
-    path2fd_.erase(fd2path_[fd]);
-    // 在fd2path_中删除打开记录
-    fd2path_.erase(fd); 
-    // 在 fd2pageno_ 中归零
-    fd2pageno_[fd] = 0;
+    path2fd_.erase(file->path);
+    // 在files_中删除打开记录，需在close()之前完成，避免fd被复用后读到旧值
+    bool is_unix_fd = file->space_id < 0;
+    files_.erase(fd_record);
+    if (is_unix_fd) {
+        close(fd);
+    }
 }
 
 
@@ -226,6 +780,10 @@ void DiskManager::close_file(int fd) {
  * @param {string} &file_name 文件名
  */
 int DiskManager::get_file_size(const std::string &file_name) {
+    if (is_tablespace_file(file_name)) {
+        auto *tablespace = get_tablespace();
+        return tablespace->exists(file_name) ? tablespace->get_space_size(tablespace->get_space_id(file_name)) : -1;
+    }
     struct stat stat_buf;
     int rc = stat(file_name.c_str(), &stat_buf);
     return rc == 0 ? stat_buf.st_size : -1;
@@ -237,10 +795,7 @@ int DiskManager::get_file_size(const std::string &file_name) {
  * @param {int} fd 文件句柄
  */
 std::string DiskManager::get_file_name(int fd) {
-    if (!fd2path_.count(fd)) {
-        throw FileNotOpenError(fd);
-    }
-    return fd2path_[fd];
+    return get_open_file(fd)->path;
 }
 
 /**
@@ -249,13 +804,53 @@ std::string DiskManager::get_file_name(int fd) {
  * @param {string} &file_name 文件名
  */
 int DiskManager::get_file_fd(const std::string &file_name) {
-    if (!path2fd_.count(file_name)) {
-        return open_file(file_name);
+    {
+        std::shared_lock lock{fd_latch_};
+        auto path_record = path2fd_.find(file_name);
+        if (path_record != path2fd_.end()) {
+            return path_record->second;
+        }
+    }
+    // 未打开时升级为独占锁，并重新检查是否已被其他线程打开
+    std::unique_lock lock{fd_latch_};
+    auto path_record = path2fd_.find(file_name);
+    if (path_record != path2fd_.end()) {
+        return path_record->second;
     }
-    return path2fd_[file_name];
+    return open_file_locked(file_name, direct_io_);
+}
+
+/**
+ * @description: 获得已打开文件的文件句柄，与get_file_fd不同，文件未打开时不会打开它
+ * @return {int} 文件句柄，文件未打开时返回-1
+ * @param {string} &file_name 文件名
+ */
+int DiskManager::find_file_fd(const std::string &file_name) {
+    std::shared_lock lock{fd_latch_};
+    auto path_record = path2fd_.find(file_name);
+    return path_record != path2fd_.end() ? path_record->second : -1;
 }
 
 
+/**
+ * @description: 打开日志文件并初始化日志末尾位置，多个线程同时调用时只打开一次
+ */
+void DiskManager::open_log_file() {
+    std::scoped_lock lock{log_latch_};
+    if (log_fd_ == -1) {
+        // 日志按字节追加写，不满足O_DIRECT的对齐要求，始终使用普通I/O
+        std::unique_lock fd_lock{fd_latch_};
+        log_fd_ = open_file_locked(LOG_FILE_NAME, false);
+    }
+    if (log_end_ == -1) {
+        struct stat stat_buf;
+        if (fstat(log_fd_, &stat_buf) != 0) {
+            throw UnixError();
+        }
+        log_end_ = stat_buf.st_size;
+    }
+}
+
 /**
  * @description:  读取日志文件内容
  * @return {int} 返回读取的数据量，若为-1说明读取数据的起始位置超过了文件大小
@@ -265,18 +860,17 @@ int DiskManager::get_file_fd(const std::string &file_name) {
  */
 int DiskManager::read_log(char *log_data, int size, int offset) {
     // read log file from the previous end
-    if (log_fd_ == -1) {
-        log_fd_ = open_file(LOG_FILE_NAME);
+    if (log_fd_ == -1 || log_end_ == -1) {
+        open_log_file();
     }
-    int file_size = get_file_size(LOG_FILE_NAME);
+    int file_size = log_end_;
     if (offset > file_size) {
         return -1;
     }
 
     size = std::min(size, file_size - offset);
     if(size == 0) return 0;
-    lseek(log_fd_, offset, SEEK_SET);
-    ssize_t bytes_read = read(log_fd_, log_data, size);
+    ssize_t bytes_read = pread_full(log_fd_, log_data, size, offset);
     assert(bytes_read == size);
     return bytes_read;
 }
@@ -288,13 +882,13 @@ int DiskManager::read_log(char *log_data, int size, int offset) {
  * @param {int} size 要写入的内容大小
  */
 void DiskManager::write_log(char *log_data, int size) {
-    if (log_fd_ == -1) {
-        log_fd_ = open_file(LOG_FILE_NAME);
+    if (log_fd_ == -1 || log_end_ == -1) {
+        open_log_file();
     }
 
-    // write from the file_end
-    lseek(log_fd_, 0, SEEK_END);
-    ssize_t bytes_write = write(log_fd_, log_data, size);
+    // write from the file_end，先原子地占用[offset, offset + size)再写入
+    off_t offset = log_end_.fetch_add(size);
+    ssize_t bytes_write = pwrite_full(log_fd_, log_data, size, offset);
     if (bytes_write != size) {
         throw UnixError();
     }
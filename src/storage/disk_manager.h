@@ -12,15 +12,24 @@ See the Mulan PSL v2 for more details. */
 
 #include <fcntl.h>     
 #include <sys/stat.h>  
+#include <sys/uio.h>
 #include <unistd.h>    
 
+#include <atomic>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
 #include "common/config.h"
 #include "errors.h"  
+#include "storage/io_engine.h"
+#include "storage/tablespace.h"
 
 /**
  * @description: DiskManager的作用主要是根据上层的需要对磁盘文件进行操作
@@ -35,9 +44,66 @@ class DiskManager {
 
     void read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
 
+    void write_pages(int fd, page_id_t start_page_no, const struct iovec *iov, int iovcnt);
+
+    void read_pages(int fd, page_id_t start_page_no, const struct iovec *iov, int iovcnt);
+
+    /*异步I/O，通过io_engine_提交，返回的future在I/O完成后就绪，出错时get()抛出异常*/
+    std::future<void> async_write_page(int fd, page_id_t page_no, const char *offset, int num_bytes);
+
+    std::future<void> async_read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
+
+    std::future<void> async_write_pages(int fd, page_id_t start_page_no, const struct iovec *iov, int iovcnt);
+
+    std::future<void> async_read_pages(int fd, page_id_t start_page_no, const struct iovec *iov, int iovcnt);
+
+    void set_io_engine(IoEngineType type, unsigned queue_depth = IO_ENGINE_QUEUE_DEPTH);
+
+    IoEngine *get_io_engine();
+
+    /**
+     * @description: 设置之后打开的表文件和索引文件是否使用O_DIRECT，绕过OS page cache，避免与buffer pool重复缓存
+     * 需在打开数据库之前设置；日志文件始终使用普通I/O
+     */
+    void set_direct_io(bool direct_io) { direct_io_ = direct_io; }
+
+    bool is_direct_io() const { return direct_io_; }
+
+    /**
+     * @description: 设置是否使用表空间模式，此时除日志文件外的所有文件都作为space存放在当前目录的段文件中，
+     * open_file返回不小于TABLESPACE_FD_BASE的虚拟fd，不占用Unix fd，也不受MAX_FD的限制。需在打开数据库之前设置
+     */
+    void set_tablespace_mode(bool tablespace_mode) { tablespace_mode_ = tablespace_mode; }
+
+    bool is_tablespace_mode() const { return tablespace_mode_; }
+
+    Tablespace *get_tablespace();
+
     page_id_t allocate_page(int fd);
 
-    void deallocate_page(page_id_t page_id);
+    void deallocate_page(int fd, page_id_t page_no);
+
+    /**
+     * @description: 设置文件预分配的粒度，新分配的页面超出已预分配的空间时，一次性用fallocate扩展extend_size字节
+     * @param {size_t} extend_size 预分配的字节数，向上取整为PAGE_SIZE的整数倍，为0时不预分配
+     */
+    void set_extend_size(size_t extend_size) {
+        extend_size_ = (extend_size + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    }
+
+    /**
+     * @description: 获得文件已预分配的物理大小，可能大于逻辑末尾get_fd2pageno(fd) * PAGE_SIZE
+     */
+    off_t get_file_extent(int fd) { return get_open_file(fd)->extent.load(); }
+
+    size_t get_free_page_count(int fd);
+
+    /**
+     * @description: 获得文件打开以来发出的读/写请求数，每次read_page(s)、write_page(s)或异步读写计一次
+     */
+    size_t get_num_reads(int fd) { return get_open_file(fd)->num_reads.load(std::memory_order_relaxed); }
+
+    size_t get_num_writes(int fd) { return get_open_file(fd)->num_writes.load(std::memory_order_relaxed); }
 
     /*目录操作*/
     bool is_dir(const std::string &path);
@@ -63,12 +129,17 @@ class DiskManager {
 
     int get_file_fd(const std::string &file_name);
 
+    int find_file_fd(const std::string &file_name);
+
     /*日志操作*/
     int read_log(char *log_data, int size, int offset);
 
     void write_log(char *log_data, int size);
 
-    void SetLogFd(int log_fd) { log_fd_ = log_fd; }
+    void SetLogFd(int log_fd) {
+        log_fd_ = log_fd;
+        log_end_ = -1;
+    }
 
     int GetLogFd() { return log_fd_; }
 
@@ -77,22 +148,89 @@ class DiskManager {
      * @param {int} fd 文件对应的文件句柄
      * @param {int} start_page_no 已经分配的页面个数，即文件接下来从start_page_no开始分配页面编号
      */
-    void set_fd2pageno(int fd, int start_page_no) { fd2pageno_[fd] = start_page_no; }
+    void set_fd2pageno(int fd, int start_page_no) { get_open_file(fd)->num_pages.store(start_page_no); }
 
     /**
      * @description: 获得文件目前已分配的页面个数，即如果文件要分配一个新页面，需要从fd2pagenp_[fd]开始分配
      * @return {page_id_t} 已分配的页面个数 
      * @param {int} fd 文件对应的句柄
      */
-    page_id_t get_fd2pageno(int fd) { return fd2pageno_[fd]; }
+    page_id_t get_fd2pageno(int fd) { return get_open_file(fd)->num_pages.load(); }
+
+    static bool is_virtual_fd(int fd) { return fd >= TABLESPACE_FD_BASE; }
 
-    static constexpr int MAX_FD = 8192;
+    // 表空间中space_id对应的虚拟fd为TABLESPACE_FD_BASE + space_id，大于进程可能分配的任何Unix fd
+    static constexpr int TABLESPACE_FD_BASE = 1 << 20;
+
+    // 空闲页表文件的后缀，文件"t"的空闲页表保存在"t.fpm"中
+    static constexpr const char *FREE_PAGE_MAP_SUFFIX = ".fpm";
 
    private:
-    // 文件打开列表，用于记录文件是否被打开
-    std::unordered_map<std::string, int> path2fd_;  //<Page文件磁盘路径,Page fd>哈希表
-    std::unordered_map<int, std::string> fd2path_;  //<Page fd,Page文件磁盘路径>哈希表
+    int open_file_locked(const std::string &path, bool direct_io);
+
+    void open_log_file();
+
+    std::future<void> submit_async_io(bool is_write, int fd, page_id_t start_page_no, const struct iovec *iov,
+                                      int iovcnt);
+
+    // 一个打开文件的空闲页表，记录已释放、可以被allocate_page重新分配的页号
+    // 内存中的空闲页表在关闭文件时整体写入磁盘，磁盘上的空闲页表只能是实际空闲页面的子集：
+    // 重用其中的页面之前先将其删除，崩溃后新释放的页面丢失，但不会被重复分配
+    struct FreePageMap {
+        std::string path;           // 空闲页表文件的路径，表空间中的文件保存在表空间目录中
+        std::set<page_id_t> pages;  // 空闲页号，优先分配最小的页号，使文件尽量紧凑
+        bool on_disk = false;       // 磁盘上是否存在空闲页表
+        bool dirty = false;         // 内存中的空闲页表是否有尚未写入磁盘的修改
+        std::mutex latch;           // 保护本文件的空闲页表
+    };
+
+    // 一个打开的文件，fd为独立文件的Unix fd或表空间中的虚拟fd
+    struct OpenFile {
+        std::string path;
+        int space_id = -1;                      // 表空间中的space_id，独立文件为-1
+        bool direct_io = false;                 // 是否以O_DIRECT打开
+        std::atomic<page_id_t> num_pages{0};    // 文件中已经分配的页面个数，即文件的逻辑末尾
+        std::atomic<off_t> extent{0};           // 文件已经预分配的物理大小
+        bool fallocate_unsupported = false;     // 文件系统不支持fallocate，之后不再预分配，由extend_latch_保护
+        FreePageMap free_map;                   // 空闲页表
+        std::atomic<size_t> num_reads{0};       // 打开以来发出的读请求数
+        std::atomic<size_t> num_writes{0};      // 打开以来发出的写请求数
+    };
+
+    OpenFile *get_open_file(int fd);
+
+    bool need_bounce(const OpenFile *file, const struct iovec *iov, int iovcnt) const;
+
+    bool is_tablespace_file(const std::string &path) const { return tablespace_mode_ && path != LOG_FILE_NAME; }
+
+    void do_io(bool is_write, int fd, page_id_t start_page_no, const struct iovec *iov, int iovcnt,
+               const char *error_msg);
+
+    void load_free_page_map(OpenFile *file);
+
+    void persist_free_page_map(int fd, OpenFile *file);
+
+    void drop_free_page_map(OpenFile *file);
+
+    void extend_file(int fd, OpenFile *file, page_id_t page_no);
+
+    // 文件打开列表，用于记录文件是否被打开，由fd_latch_保护
+    std::unordered_map<std::string, int> path2fd_;                   //<Page文件磁盘路径,Page fd>哈希表
+    std::unordered_map<int, std::unique_ptr<OpenFile>> files_;       //<Page fd,打开的文件>哈希表
+    std::shared_mutex fd_latch_;  // 文件打开列表的读写锁，查询取共享锁，打开/关闭取独占锁
 
     int log_fd_ = -1;                             // WAL日志文件的文件句柄，默认为-1，代表未打开日志文件
-    page_id_t fd2pageno_[MAX_FD] {};  // 文件中已经分配的页面个数，初始值为0
+    std::atomic<off_t> log_end_{-1};              // 日志文件的末尾位置，write_log从此处追加，-1表示尚未初始化
+    std::mutex log_latch_;                        // 保护日志文件的打开
+    std::mutex extend_latch_;                     // 串行化文件的预分配
+    size_t extend_size_ = FILE_EXTEND_SIZE;       // 文件预分配的粒度
+
+    bool direct_io_ = false;                      // 新打开的表文件和索引文件是否使用O_DIRECT
+
+    bool tablespace_mode_ = false;                // 是否使用表空间存放表文件和索引文件
+    std::unique_ptr<Tablespace> tablespace_;      // 当前目录的表空间，第一次使用时创建
+    std::mutex tablespace_latch_;                 // 保护tablespace_的创建
+
+    std::unique_ptr<IoEngine> io_engine_;         // 异步I/O引擎，第一次使用时按IO_ENGINE_TYPE创建
+    std::mutex io_engine_latch_;                  // 保护io_engine_的创建和替换
 };
\ No newline at end of file
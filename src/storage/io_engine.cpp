@@ -0,0 +1,59 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/io_engine.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+#include <iostream>
+
+#include "errors.h"
+
+#if __has_include(<linux/io_uring.h>)
+#include "storage/io_uring_engine.h"
+#define RMDB_HAVE_IO_URING 1
+#endif
+
+/**
+ * @description: 同步执行向量读，被信号打断时重试
+ */
+void SyncIoEngine::submit_read(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) {
+    ssize_t res = preadv(fd, iov, iovcnt, offset);
+    while (res < 0 && errno == EINTR) {
+        res = preadv(fd, iov, iovcnt, offset);
+    }
+    callback(res < 0 ? -errno : res);
+}
+
+/**
+ * @description: 同步执行向量写，被信号打断时重试
+ */
+void SyncIoEngine::submit_write(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) {
+    ssize_t res = pwritev(fd, iov, iovcnt, offset);
+    while (res < 0 && errno == EINTR) {
+        res = pwritev(fd, iov, iovcnt, offset);
+    }
+    callback(res < 0 ? -errno : res);
+}
+
+std::unique_ptr<IoEngine> IoEngine::create(IoEngineType type, unsigned queue_depth) {
+#ifdef RMDB_HAVE_IO_URING
+    if (type == IoEngineType::IO_URING) {
+        try {
+            return std::make_unique<UringIoEngine>(queue_depth);
+        } catch (RMDBError &e) {
+            // 内核过旧或io_uring被禁用（如seccomp），回退为同步引擎
+            std::cerr << "io_uring unavailable, fall back to sync io engine: " << e.what() << std::endl;
+        }
+    }
+#endif
+    return std::make_unique<SyncIoEngine>();
+}
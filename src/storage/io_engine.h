@@ -0,0 +1,78 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * @description: 异步I/O引擎的类型
+ * SYNC: 在提交线程中直接调用preadv/pwritev完成，作为不支持io_uring时的回退方案
+ * IO_URING: 基于io_uring，可以同时保持多个I/O请求在途
+ */
+enum class IoEngineType { SYNC, IO_URING };
+
+/**
+ * @description: IoEngine是DiskManager下层的异步I/O接口，提交请求后通过回调通知完成
+ * 回调的参数为实际传输的字节数，出错时为-errno；回调可能在提交线程或引擎内部的完成线程中执行
+ */
+class IoEngine {
+   public:
+    using Callback = std::function<void(ssize_t result)>;
+
+    virtual ~IoEngine() = default;
+
+    /**
+     * @description: 提交一个向量读请求，从文件的offset处读入iov描述的缓冲区
+     * @note iov数组在函数返回后即可释放，但其指向的缓冲区必须保持有效直到回调执行
+     */
+    virtual void submit_read(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) = 0;
+
+    /**
+     * @description: 提交一个向量写请求，将iov描述的缓冲区写入文件的offset处
+     * @note iov数组在函数返回后即可释放，但其指向的缓冲区必须保持有效直到回调执行
+     */
+    virtual void submit_write(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) = 0;
+
+    /** 阻塞直到所有已提交的请求都执行完回调 */
+    virtual void wait_all() = 0;
+
+    virtual IoEngineType type() const = 0;
+
+    virtual std::string name() const = 0;
+
+    /**
+     * @description: 创建指定类型的I/O引擎，若内核不支持io_uring则回退为同步引擎
+     * @param {IoEngineType} type 期望的引擎类型
+     * @param {unsigned} queue_depth io_uring的队列深度，即最多同时在途的请求数
+     */
+    static std::unique_ptr<IoEngine> create(IoEngineType type, unsigned queue_depth = 64);
+};
+
+/**
+ * @description: 同步I/O引擎，submit时直接完成I/O并在当前线程中执行回调
+ */
+class SyncIoEngine : public IoEngine {
+   public:
+    void submit_read(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) override;
+
+    void submit_write(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) override;
+
+    void wait_all() override {}
+
+    IoEngineType type() const override { return IoEngineType::SYNC; }
+
+    std::string name() const override { return "sync"; }
+};
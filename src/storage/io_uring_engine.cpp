@@ -0,0 +1,243 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#if __has_include(<linux/io_uring.h>)
+
+#include "storage/io_uring_engine.h"
+
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include "errors.h"
+
+// 用于唤醒完成线程的NOP请求的user_data，不对应任何在途请求
+static constexpr uint64_t WAKEUP_USER_DATA = UINT64_MAX;
+
+static int io_uring_setup(unsigned entries, struct io_uring_params *params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+/**
+ * @description: 创建io_uring实例并映射SQ/CQ环形队列，随后启动完成线程
+ * @param {unsigned} queue_depth 队列深度
+ */
+UringIoEngine::UringIoEngine(unsigned queue_depth) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = io_uring_setup(std::max(queue_depth, 1u), &params);
+    if (ring_fd_ < 0) {
+        throw UnixError();
+    }
+    sq_entries_ = params.sq_entries;
+    cq_entries_ = params.cq_entries;
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+
+    sq_ring_ptr_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_SQ_RING);
+    if (sq_ring_ptr_ == MAP_FAILED) {
+        sq_ring_ptr_ = nullptr;
+        close(ring_fd_);
+        throw UnixError();
+    }
+    if (single_mmap) {
+        cq_ring_ptr_ = sq_ring_ptr_;
+    } else {
+        cq_ring_ptr_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                            IORING_OFF_CQ_RING);
+        if (cq_ring_ptr_ == MAP_FAILED) {
+            munmap(sq_ring_ptr_, sq_ring_size_);
+            close(ring_fd_);
+            throw UnixError();
+        }
+    }
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        if (!single_mmap) munmap(cq_ring_ptr_, cq_ring_size_);
+        munmap(sq_ring_ptr_, sq_ring_size_);
+        close(ring_fd_);
+        throw UnixError();
+    }
+    sqes_ = static_cast<struct io_uring_sqe *>(sqes);
+
+    char *sq_ptr = static_cast<char *>(sq_ring_ptr_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.array);
+    char *cq_ptr = static_cast<char *>(cq_ring_ptr_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq_ptr + params.cq_off.cqes);
+
+    // 在途请求数不超过SQ的大小，CQ默认为SQ的两倍，因此不会溢出
+    requests_.resize(sq_entries_);
+    for (unsigned i = sq_entries_; i > 0; i--) {
+        free_slots_.push_back(i - 1);
+    }
+
+    reaper_ = std::thread(&UringIoEngine::reap_completions, this);
+}
+
+/**
+ * @description: 等待所有在途请求完成，通过一个NOP请求唤醒并结束完成线程，最后释放io_uring资源
+ */
+UringIoEngine::~UringIoEngine() {
+    wait_all();
+    {
+        std::scoped_lock lock{submit_latch_};
+        stop_ = true;
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & *sq_mask_;
+        struct io_uring_sqe *sqe = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_NOP;
+        sqe->user_data = WAKEUP_USER_DATA;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        while (io_uring_enter(ring_fd_, 1, 0, 0) < 0 && (errno == EINTR || errno == EAGAIN)) {
+        }
+    }
+    reaper_.join();
+
+    munmap(sqes_, sqes_size_);
+    if (cq_ring_ptr_ != sq_ring_ptr_) munmap(cq_ring_ptr_, cq_ring_size_);
+    munmap(sq_ring_ptr_, sq_ring_size_);
+    close(ring_fd_);
+}
+
+void UringIoEngine::submit_read(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) {
+    submit(false, fd, offset, iov, iovcnt, std::move(callback));
+}
+
+void UringIoEngine::submit_write(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) {
+    submit(true, fd, offset, iov, iovcnt, std::move(callback));
+}
+
+/**
+ * @description: 填写一个READV/WRITEV请求的SQE并提交给内核，在途请求已满时阻塞等待空闲槽位。
+ *              提交失败时撤销SQE、槽位和in_flight_后抛出异常，回调不会被执行，wait_all()不会等待该请求
+ */
+void UringIoEngine::submit(bool is_write, int fd, off_t offset, const struct iovec *iov, int iovcnt,
+                           Callback callback) {
+    std::unique_lock lock{submit_latch_};
+    slot_cv_.wait(lock, [this] { return !free_slots_.empty(); });
+    unsigned slot = free_slots_.back();
+    free_slots_.pop_back();
+    auto &request = requests_[slot];
+    request.iov.assign(iov, iov + iovcnt);
+    request.callback = std::move(callback);
+
+    unsigned tail = *sq_tail_;
+    unsigned index = tail & *sq_mask_;
+    struct io_uring_sqe *sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(request.iov.data());
+    sqe->len = iovcnt;
+    sqe->user_data = slot;
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    in_flight_++;
+
+    int ret;
+    while ((ret = io_uring_enter(ring_fd_, 1, 0, 0)) < 0 && (errno == EINTR || errno == EAGAIN)) {
+    }
+    // 出错时内核没有取走SQE（取走后请求的错误通过CQE返回），此时持有submit_latch_，可以直接撤销
+    if (ret < 0 && __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == tail) {
+        int err = errno;
+        __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+        request.iov.clear();
+        request.callback = nullptr;
+        free_slots_.push_back(slot);
+        in_flight_--;
+        lock.unlock();
+        slot_cv_.notify_all();
+        errno = err;
+        throw UnixError();
+    }
+}
+
+/**
+ * @description: 阻塞直到in_flight_归零，即所有已提交请求的回调都已执行完毕
+ */
+void UringIoEngine::wait_all() {
+    std::unique_lock lock{submit_latch_};
+    slot_cv_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+/**
+ * @description: 完成线程的主循环，等待CQE到达后依次执行请求的回调并回收槽位。
+ *              只在收到析构函数的唤醒请求后退出，等待出错时稍后重试，否则在途请求的回调永远不会执行
+ * @note 回调在完成线程中执行，不能在回调中阻塞等待本引擎的其他请求
+ */
+void UringIoEngine::reap_completions() {
+    while (true) {
+        int ret = io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0 && errno != EINTR) {
+            // EBUSY（CQ已满）等错误：先收割已经到达的CQE，随后重试
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        bool wakeup = false;
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            struct io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+            uint64_t user_data = cqe->user_data;
+            int res = cqe->res;
+            head++;
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+            if (user_data == WAKEUP_USER_DATA) {
+                wakeup = true;
+                continue;
+            }
+
+            Callback callback;
+            {
+                std::scoped_lock lock{submit_latch_};
+                callback = std::move(requests_[user_data].callback);
+            }
+            callback(res);
+            {
+                std::scoped_lock lock{submit_latch_};
+                requests_[user_data].iov.clear();
+                free_slots_.push_back(static_cast<unsigned>(user_data));
+                in_flight_--;
+            }
+            slot_cv_.notify_all();
+        }
+        if (wakeup && stop_) {
+            break;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,85 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "io_engine.h"
+
+/**
+ * @description: 基于io_uring的异步I/O引擎，直接使用io_uring_setup/io_uring_enter系统调用，不依赖liburing
+ * 提交线程在submit_latch_保护下填写SQE并提交，内部的完成线程阻塞等待CQE并执行回调
+ */
+class UringIoEngine : public IoEngine {
+   public:
+    /**
+     * @description: 初始化io_uring实例，内核不支持或被禁止时抛出UnixError
+     * @param {unsigned} queue_depth 队列深度，最多同时在途的请求数
+     */
+    explicit UringIoEngine(unsigned queue_depth);
+
+    ~UringIoEngine() override;
+
+    void submit_read(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) override;
+
+    void submit_write(int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback) override;
+
+    void wait_all() override;
+
+    IoEngineType type() const override { return IoEngineType::IO_URING; }
+
+    std::string name() const override { return "io_uring"; }
+
+   private:
+    // 在途请求的上下文，通过SQE的user_data定位，iovec数组需保持到请求完成
+    struct Request {
+        std::vector<struct iovec> iov;
+        Callback callback;
+    };
+
+    void submit(bool is_write, int fd, off_t offset, const struct iovec *iov, int iovcnt, Callback callback);
+
+    void reap_completions();
+
+    int ring_fd_ = -1;
+    unsigned sq_entries_ = 0;
+    unsigned cq_entries_ = 0;
+
+    // SQ/CQ共享内存映射
+    void *sq_ring_ptr_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    void *cq_ring_ptr_ = nullptr;
+    size_t cq_ring_size_ = 0;
+    struct io_uring_sqe *sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    unsigned *sq_head_ = nullptr;
+    unsigned *sq_tail_ = nullptr;
+    unsigned *sq_mask_ = nullptr;
+    unsigned *sq_array_ = nullptr;
+    unsigned *cq_head_ = nullptr;
+    unsigned *cq_tail_ = nullptr;
+    unsigned *cq_mask_ = nullptr;
+    struct io_uring_cqe *cqes_ = nullptr;
+
+    std::vector<Request> requests_;         // 在途请求表，下标即user_data
+    std::vector<unsigned> free_slots_;      // requests_中空闲的下标
+    size_t in_flight_ = 0;                  // 已提交但尚未执行回调的请求数
+
+    std::mutex submit_latch_;               // 保护SQ、requests_、free_slots_和in_flight_
+    std::condition_variable slot_cv_;       // 有请求完成时通知等待空闲槽位或wait_all的线程
+    std::atomic<bool> stop_{false};
+    std::thread reaper_;                    // 完成线程
+};
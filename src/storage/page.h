@@ -12,6 +12,8 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/config.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <shared_mutex>
 
 /**
@@ -22,8 +24,9 @@ struct PageId {
     page_id_t page_no = INVALID_PAGE_ID;
 
     friend bool operator==(const PageId &x, const PageId &y) { return x.fd == y.fd && x.page_no == y.page_no; }
+    // 先按fd再按page_no排序，使同一文件中相邻的页面在排序后也相邻
     bool operator<(const PageId& x) const {
-        if(fd < x.fd) return true;
+        if (fd != x.fd) return fd < x.fd;
         return page_no < x.page_no;
     }
 
@@ -32,13 +35,13 @@ struct PageId {
     }
 
     inline int64_t Get() const {
-        return (static_cast<int64_t>(fd << 16) | page_no);
+        return (static_cast<int64_t>(fd) << 32) | static_cast<uint32_t>(page_no);
     }
 };
 
 // PageId的自定义哈希算法, 用于构建unordered_map<PageId, frame_id_t, PageIdHash>
 struct PageIdHash {
-    size_t operator()(const PageId &x) const { return (x.fd << 16) | x.page_no; }
+    size_t operator()(const PageId &x) const { return (static_cast<size_t>(x.fd) << 32) | static_cast<uint32_t>(x.page_no); }
 };
 
 template <>
@@ -46,16 +49,34 @@ struct std::hash<PageId> {
     size_t operator()(const PageId &obj) const { return std::hash<int64_t>()(obj.Get()); }
 };
 
+/**
+ * @description: 文件的页面在缓冲池中的优先级。PINNED的页面读入后不再交给replacer，不会被淘汰；
+ * LOW的页面取消固定时作为replacer中最冷的帧，优先被淘汰
+ */
+enum class BufferPriority : uint8_t { LOW, NORMAL, PINNED };
+
+/**
+ * @description: 表或索引文件的缓冲池策略，由ALTER TABLE/INDEX ... SET (buffer_priority = ..., max_buffer_pct = ...)设置
+ */
+struct BufferPolicy {
+    BufferPriority priority = BufferPriority::NORMAL;
+    int max_buffer_pct = 100;   // 文件最多占用的帧数占缓冲池的百分比，达到后复用该文件自己的帧
+
+    bool is_default() const { return priority == BufferPriority::NORMAL && max_buffer_pct == 100; }
+};
+
 /**
  * @description: Page类声明, Page是RMDB数据块的单位、是负责数据操作Record模块的操作对象，
- * Page对象在磁盘上有文件存储, 若在Buffer中则有帧偏移, 并非特指Buffer或Disk上的数据
+ * Page对象在磁盘上有文件存储, 若在Buffer中则有帧偏移, 并非特指Buffer或Disk上的数据。
+ * Page对象本身只是帧的描述符，页面数据在BufferPoolManager的帧内存中；描述符按cache line对齐，
+ * 命中路径访问的元数据集中在第一个cache line，遍历描述符数组时不会触及页面数据
  */
-class Page {
+class alignas(64) Page {
     friend class BufferPoolManager;
 
    public:
-    
-    Page() { reset_memory(); }
+    // data_由BufferPoolManager在构造时指向其按PAGE_SIZE对齐的帧内存
+    Page() = default;
 
     ~Page() = default;
 
@@ -65,6 +86,10 @@ class Page {
 
     bool is_dirty() const { return is_dirty_; }
 
+    // pin_count_中的标志位：最后一次取消固定已将计数减为0，但尚未调用replacer->unpin。
+    // 标志位清除之前pin_count_不为0，淘汰、删除和缩小缓冲池都要等待，之后不会再有线程访问该帧
+    static constexpr int PIN_RELEASING = 1 << 30;
+
     static constexpr size_t OFFSET_PAGE_START = 0;
     static constexpr size_t OFFSET_LSN = 0;
     static constexpr size_t OFFSET_PAGE_HDR = 4;
@@ -111,15 +136,31 @@ class Page {
     PageId id_;
 
     /** The actual data that is stored within a page.
-     *  该页面在bufferPool中的偏移地址
+     *  该页面在bufferPool中的偏移地址，指向BufferPoolManager的帧内存，起始地址按PAGE_SIZE对齐，满足O_DIRECT的要求
      */
-    char data_[PAGE_SIZE] = {};
+    char *data_ = nullptr;
+
+    /** The pin count of this page. 命中时在分片latch的共享锁下原子地增加，取消固定时不需要latch，见PIN_RELEASING */
+    std::atomic<int> pin_count_{0};
+
+    /** 脏页判断，取消固定时先于pin_count_的减少设置，淘汰者看到pin_count_为0时也能看到脏标记 */
+    std::atomic<bool> is_dirty_{false};
+
+    /** 帧正在进行缺页读入或脏页写回，此时帧已被页表记录但数据不可用，由所属分片的latch保护 */
+    bool io_in_progress_ = false;
+
+    /** 通过BufferAccessStrategy读入该页面时为策略的id，该帧可被这一策略的环形缓冲区复用；否则为0 */
+    uint64_t ring_id_ = 0;
+
+    /** 页面所属文件的缓冲池优先级，帧加入驻留帧链表时按文件的策略设置；取消固定时不持有latch读取，因此为原子变量 */
+    std::atomic<BufferPriority> priority_{BufferPriority::NORMAL};
 
-    /** 脏页判断 */
-    bool is_dirty_ = false;
+    /** 同一文件驻留在同一分片中的帧组成的双向链表，帧以id_被页表记录时在id_.fd的链表中，由所属分片的latch保护 */
+    frame_id_t file_prev_ = INVALID_FRAME_ID;
+    frame_id_t file_next_ = INVALID_FRAME_ID;
 
-    /** The pin count of this page. */
-    int pin_count_ = 0;
+    /** I/O结束时通知等待该帧的线程，与所属分片的latch（shared_mutex）配合使用 */
+    std::condition_variable_any io_cv_;
 
     std::shared_mutex rwlock;
 };
\ No newline at end of file
@@ -0,0 +1,353 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/tablespace.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+
+#include "errors.h"
+
+/**
+ * @description: 打开当前目录下的表空间，加载目录文件并打开所有段文件
+ */
+Tablespace::Tablespace(bool direct_io) : direct_io_(direct_io) {
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) == nullptr) {
+        throw UnixError();
+    }
+    dir_ = cwd;
+    load();
+}
+
+Tablespace::~Tablespace() {
+    for (int fd : segment_fds_) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+bool Tablespace::exists(const std::string &name) {
+    std::shared_lock lock{latch_};
+    return name2id_.count(name) > 0;
+}
+
+/**
+ * @description: 新建一个空的space，此时不分配任何区
+ */
+void Tablespace::create_space(const std::string &name) {
+    std::unique_lock lock{latch_};
+    if (name2id_.count(name) > 0) {
+        throw FileExistsError(name);
+    }
+    int space_id = next_space_id_++;
+    spaces_[space_id] = Space{.name = name, .extents = {}, .free_pages = {}};
+    name2id_[name] = space_id;
+    persist();
+}
+
+/**
+ * @description: 删除一个space，其占用的物理区归还表空间，供之后新分配的区重用
+ */
+void Tablespace::drop_space(const std::string &name) {
+    std::unique_lock lock{latch_};
+    auto pos = name2id_.find(name);
+    if (pos == name2id_.end()) {
+        throw FileNotFoundError(name);
+    }
+    auto &space = spaces_.at(pos->second);
+    free_extents_.insert(space.extents.begin(), space.extents.end());
+    spaces_.erase(pos->second);
+    name2id_.erase(pos);
+    persist();
+}
+
+int Tablespace::get_space_id(const std::string &name) {
+    std::shared_lock lock{latch_};
+    auto pos = name2id_.find(name);
+    if (pos == name2id_.end()) {
+        throw FileNotFoundError(name);
+    }
+    return pos->second;
+}
+
+Tablespace::Space &Tablespace::get_space(int space_id) {
+    auto pos = spaces_.find(space_id);
+    if (pos == spaces_.end()) {
+        throw InternalError("Tablespace: invalid space id " + std::to_string(space_id));
+    }
+    return pos->second;
+}
+
+bool Tablespace::map_io(int space_id, page_id_t start_page_no, const struct iovec *iov, int iovcnt, bool allocate,
+                        std::vector<IoSegment> &segments) {
+    {
+        std::shared_lock lock{latch_};
+        if (map_io_locked(get_space(space_id), start_page_no, iov, iovcnt, false, segments)) {
+            return true;
+        }
+    }
+    if (!allocate) {
+        return false;
+    }
+    // 需要分配新的区，取独占锁后重新映射
+    std::unique_lock lock{latch_};
+    int num_extents = num_extents_;
+    size_t num_free_extents = free_extents_.size();
+    map_io_locked(get_space(space_id), start_page_no, iov, iovcnt, true, segments);
+    if (num_extents != num_extents_ || num_free_extents != free_extents_.size()) {
+        persist();
+    }
+    return true;
+}
+
+/**
+ * @description: 逐个缓冲区地将space内的字节偏移换算为段文件中的位置，物理上相邻的部分合并为同一段
+ * @return {bool} 所有部分都完成映射则返回true
+ */
+bool Tablespace::map_io_locked(Space &space, page_id_t start_page_no, const struct iovec *iov, int iovcnt,
+                               bool allocate, std::vector<IoSegment> &segments) {
+    segments.clear();
+    off_t offset = static_cast<off_t>(start_page_no) * PAGE_SIZE;
+    for (int i = 0; i < iovcnt; i++) {
+        char *base = static_cast<char *>(iov[i].iov_base);
+        size_t done = 0;
+        while (done < iov[i].iov_len) {
+            size_t extent_no = offset / EXTENT_SIZE;
+            off_t in_extent = offset % EXTENT_SIZE;
+            size_t len = std::min<size_t>(iov[i].iov_len - done, EXTENT_SIZE - in_extent);
+            if (extent_no >= space.extents.size()) {
+                if (!allocate) {
+                    return false;
+                }
+                while (extent_no >= space.extents.size()) {
+                    space.extents.push_back(allocate_extent());
+                }
+            }
+            int physical = space.extents[extent_no];
+            int fd = segment_fds_[physical / EXTENTS_PER_SEGMENT];
+            off_t pos = (physical % EXTENTS_PER_SEGMENT) * EXTENT_SIZE + in_extent;
+
+            auto &last = segments.empty() ? segments.emplace_back(IoSegment{fd, pos, {}}) : segments.back();
+            off_t last_end = last.pos;
+            for (auto &entry : last.iov) last_end += entry.iov_len;
+            if (last.fd != fd || last_end != pos) {
+                segments.push_back(IoSegment{fd, pos, {}});
+            }
+            segments.back().iov.push_back({.iov_base = base + done, .iov_len = len});
+            done += len;
+            offset += len;
+        }
+    }
+    return true;
+}
+
+/**
+ * @description: 分配一个物理区，优先重用被删除的space释放的区，调用者需持有独占锁
+ * @return {int} 物理区号
+ */
+int Tablespace::allocate_extent() {
+    int extent;
+    bool reused = !free_extents_.empty();
+    if (reused) {
+        extent = *free_extents_.begin();
+        free_extents_.erase(free_extents_.begin());
+    } else {
+        extent = num_extents_++;
+    }
+    int fd = open_segment(extent / EXTENTS_PER_SEGMENT);
+    off_t pos = (extent % EXTENTS_PER_SEGMENT) * EXTENT_SIZE;
+    // 重用的区中残留着被删除space的数据，先清零，使未写过的页面读出为全0
+    int mode = reused ? FALLOC_FL_ZERO_RANGE : 0;
+    if (fallocate(fd, mode, pos, EXTENT_SIZE) != 0) {
+        if (errno != EOPNOTSUPP) {
+            throw UnixError();
+        }
+        if (reused) {
+            std::vector<char> zeros(EXTENT_SIZE, 0);
+            if (pwrite(fd, zeros.data(), EXTENT_SIZE, pos) != EXTENT_SIZE) {
+                throw UnixError();
+            }
+        }
+    }
+    return extent;
+}
+
+/**
+ * @description: 打开（必要时创建）第segment_no个段文件
+ * @return {int} 段文件的fd
+ */
+int Tablespace::open_segment(int segment_no) {
+    if (segment_no < static_cast<int>(segment_fds_.size()) && segment_fds_[segment_no] >= 0) {
+        return segment_fds_[segment_no];
+    }
+    std::string path = dir_ + "/" + TABLESPACE_SEGMENT_PREFIX + std::to_string(segment_no);
+    int flags = O_RDWR | O_CREAT;
+    int fd = direct_io_ ? open(path.c_str(), flags | O_DIRECT, S_IRUSR | S_IWUSR) : -1;
+    if (fd < 0) {
+        fd = open(path.c_str(), flags, S_IRUSR | S_IWUSR);
+    }
+    if (fd < 0) {
+        throw UnixError();
+    }
+    if (segment_no >= static_cast<int>(segment_fds_.size())) {
+        segment_fds_.resize(segment_no + 1, -1);
+    }
+    segment_fds_[segment_no] = fd;
+    return fd;
+}
+
+off_t Tablespace::extend_space(int space_id, page_id_t page_no) {
+    std::unique_lock lock{latch_};
+    auto &space = get_space(space_id);
+    size_t num_extents = static_cast<off_t>(page_no) * PAGE_SIZE / EXTENT_SIZE + 1;
+    if (space.extents.size() < num_extents) {
+        while (space.extents.size() < num_extents) {
+            space.extents.push_back(allocate_extent());
+        }
+        persist();
+    }
+    return space.extents.size() * EXTENT_SIZE;
+}
+
+off_t Tablespace::get_space_size(int space_id) {
+    std::shared_lock lock{latch_};
+    return get_space(space_id).extents.size() * EXTENT_SIZE;
+}
+
+std::set<page_id_t> Tablespace::get_free_pages(int space_id) {
+    std::shared_lock lock{latch_};
+    return get_space(space_id).free_pages;
+}
+
+/**
+ * @description: 更新space的空闲页表并写入目录文件。释放页面之前引用它的页面（如记录文件的文件头）已经更新，
+ * 新的空闲页表写入之前先将段文件fsync到磁盘，保证崩溃后不会出现仍被引用的页面出现在空闲页表中
+ */
+void Tablespace::set_free_pages(int space_id, const std::set<page_id_t> &free_pages) {
+    std::unique_lock lock{latch_};
+    if (!free_pages.empty()) {
+        for (int fd : segment_fds_) {
+            if (fd >= 0 && fsync(fd) != 0) {
+                throw UnixError();
+            }
+        }
+    }
+    get_space(space_id).free_pages = free_pages;
+    persist();
+}
+
+int Tablespace::get_num_segments() {
+    std::shared_lock lock{latch_};
+    return segment_fds_.size();
+}
+
+/**
+ * @description: 从目录文件加载表空间，格式为
+ * next_space_id num_extents
+ * num_free_extents extent...
+ * num_spaces
+ * name space_id num_extents extent... num_free_pages page_no...
+ */
+void Tablespace::load() {
+    std::ifstream ifs(dir_ + "/" + TABLESPACE_DIR_NAME);
+    if (!ifs.is_open()) {
+        return;
+    }
+    size_t n;
+    ifs >> next_space_id_ >> num_extents_ >> n;
+    for (size_t i = 0; i < n; i++) {
+        int extent;
+        ifs >> extent;
+        free_extents_.insert(extent);
+    }
+    ifs >> n;
+    for (size_t i = 0; i < n; i++) {
+        Space space;
+        int space_id;
+        size_t num_extents, num_free_pages;
+        ifs >> space.name >> space_id >> num_extents;
+        space.extents.resize(num_extents);
+        for (auto &extent : space.extents) {
+            ifs >> extent;
+        }
+        ifs >> num_free_pages;
+        for (size_t j = 0; j < num_free_pages; j++) {
+            page_id_t page_no;
+            ifs >> page_no;
+            space.free_pages.insert(page_no);
+        }
+        name2id_[space.name] = space_id;
+        spaces_[space_id] = std::move(space);
+    }
+    if (!ifs) {
+        throw InternalError("Tablespace: corrupted " + std::string(TABLESPACE_DIR_NAME));
+    }
+    for (int segment_no = 0; segment_no * EXTENTS_PER_SEGMENT < num_extents_; segment_no++) {
+        open_segment(segment_no);
+    }
+}
+
+/**
+ * @description: 将目录写入临时文件后rename覆盖目录文件，保证崩溃时目录文件是完整的旧版本或新版本，调用者需持有独占锁
+ */
+void Tablespace::persist() {
+    std::string path = dir_ + "/" + TABLESPACE_DIR_NAME;
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream ofs(tmp_path, std::ios::trunc);
+        ofs << next_space_id_ << ' ' << num_extents_ << '\n' << free_extents_.size();
+        for (int extent : free_extents_) {
+            ofs << ' ' << extent;
+        }
+        ofs << '\n' << spaces_.size() << '\n';
+        for (auto &[space_id, space] : spaces_) {
+            ofs << space.name << ' ' << space_id << ' ' << space.extents.size();
+            for (int extent : space.extents) {
+                ofs << ' ' << extent;
+            }
+            ofs << ' ' << space.free_pages.size();
+            for (page_id_t page_no : space.free_pages) {
+                ofs << ' ' << page_no;
+            }
+            ofs << '\n';
+        }
+        if (!ofs) {
+            throw InternalError("Tablespace: failed to write " + tmp_path);
+        }
+    }
+    // 目录中保存着各个文件的空闲页表，重命名前后都需要fsync，使已经重用的页面在崩溃后不会再次出现在空闲页表中
+    int tmp_fd = open(tmp_path.c_str(), O_RDONLY);
+    if (tmp_fd < 0) {
+        throw UnixError();
+    }
+    int ret = fsync(tmp_fd);
+    close(tmp_fd);
+    if (ret != 0) {
+        throw UnixError();
+    }
+    if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+        throw UnixError();
+    }
+    int dir_fd = open(dir_.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dir_fd < 0) {
+        throw UnixError();
+    }
+    ret = fsync(dir_fd);
+    close(dir_fd);
+    if (ret != 0) {
+        throw UnixError();
+    }
+}
@@ -0,0 +1,116 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <map>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * @description: 一段在段文件中物理连续的读写
+ */
+struct IoSegment {
+    int fd;                         // 段文件的Unix fd
+    off_t pos;                      // 段文件中的偏移量
+    std::vector<struct iovec> iov;  // 该段对应的缓冲区
+};
+
+/**
+ * @description: 表空间，将数据库中所有表文件和索引文件存放在少数几个段文件中
+ * 每个表文件或索引文件在表空间中是一个space，以space_id标识，space内的页面按区(extent)分配，
+ * 区是段文件中TABLESPACE_EXTENT_SIZE字节的连续空间，第i个区映射到段文件中的某个物理区。
+ * 目录文件TABLESPACE_DIR_NAME记录所有space的名称、区映射和空闲页表，每次结构变化时整体重写
+ */
+class Tablespace {
+   public:
+    /**
+     * @description: 打开当前目录下的表空间，目录文件不存在时创建一个空的表空间
+     * @param {bool} direct_io 是否以O_DIRECT打开段文件
+     */
+    explicit Tablespace(bool direct_io);
+
+    ~Tablespace();
+
+    bool exists(const std::string &name);
+
+    void create_space(const std::string &name);
+
+    void drop_space(const std::string &name);
+
+    int get_space_id(const std::string &name);
+
+    /**
+     * @description: 将space中从start_page_no开始的读写映射为段文件中物理连续的若干段
+     * @return {bool} 映射成功返回true；allocate为false且访问到尚未分配的区时返回false
+     * @param {bool} allocate 是否为尚未分配的区分配物理区，写入时为true
+     */
+    bool map_io(int space_id, page_id_t start_page_no, const struct iovec *iov, int iovcnt, bool allocate,
+                std::vector<IoSegment> &segments);
+
+    /**
+     * @description: 为space中直到page_no的所有区分配物理区，使未写过的页面可以读出全0
+     * @return {off_t} 分配之后space的空间大小
+     */
+    off_t extend_space(int space_id, page_id_t page_no);
+
+    /**
+     * @description: 获得space已分配的空间大小，即区的个数乘以区的大小
+     */
+    off_t get_space_size(int space_id);
+
+    std::set<page_id_t> get_free_pages(int space_id);
+
+    void set_free_pages(int space_id, const std::set<page_id_t> &free_pages);
+
+    int get_num_segments();
+
+    const std::string &get_dir() const { return dir_; }
+
+    static constexpr off_t EXTENT_SIZE = TABLESPACE_EXTENT_SIZE;
+    static constexpr off_t EXTENTS_PER_SEGMENT = TABLESPACE_SEGMENT_SIZE / TABLESPACE_EXTENT_SIZE;
+
+   private:
+    struct Space {
+        std::string name;
+        std::vector<int> extents;       // 第i个元素为space的第i个区所在的物理区号
+        std::set<page_id_t> free_pages; // 空闲页表，见DiskManager::allocate_page
+    };
+
+    Space &get_space(int space_id);
+
+    bool map_io_locked(Space &space, page_id_t start_page_no, const struct iovec *iov, int iovcnt, bool allocate,
+                       std::vector<IoSegment> &segments);
+
+    int allocate_extent();
+
+    int open_segment(int segment_no);
+
+    void load();
+
+    void persist();
+
+    bool direct_io_;
+    std::string dir_;                           // 表空间所在的目录（绝对路径）
+    std::map<int, Space> spaces_;               // space_id到space的映射
+    std::map<std::string, int> name2id_;        // space名称到space_id的映射
+    int next_space_id_ = 0;                     // 下一个新建space的space_id
+    int num_extents_ = 0;                       // 已使用的物理区的个数
+    std::set<int> free_extents_;                // 被删除的space释放的物理区
+    std::vector<int> segment_fds_;              // 各个段文件的fd
+    std::shared_mutex latch_;                   // 映射查询取共享锁，修改取独占锁
+};
@@ -0,0 +1,640 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "index/ix_manager.h"
+#include "record/rm_manager.h"
+#include "record/rm_scan.h"
+#include "storage/buffer_pool_manager.h"
+#include "storage/disk_manager.h"
+
+/**
+ * 存储层性能测试，用法: storage_bench <case> [args...]
+ * 每个case在当前目录下创建自己的测试文件，测试结束后删除
+ */
+
+using bench_clock = std::chrono::steady_clock;
+
+static double elapsed_seconds(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+// 丢弃文件在OS page cache中的缓存，使每一轮测试都从设备读取
+static void drop_file_cache(int fd) {
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+// 创建一个包含num_pages个页面的测试文件并打开，返回其fd
+static int create_bench_file(DiskManager *disk_manager, const std::string &filename, int num_pages) {
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    disk_manager->create_file(filename);
+    int fd = disk_manager->open_file(filename);
+
+    constexpr int batch = 64;
+    std::vector<char> buf(batch * PAGE_SIZE);
+    std::vector<struct iovec> iov(batch);
+    for (int page_no = 0; page_no < num_pages; page_no += batch) {
+        int n = std::min(batch, num_pages - page_no);
+        for (int i = 0; i < n; i++) {
+            memset(buf.data() + i * PAGE_SIZE, (page_no + i) & 0xff, PAGE_SIZE);
+            iov[i] = {.iov_base = buf.data() + i * PAGE_SIZE, .iov_len = static_cast<size_t>(PAGE_SIZE)};
+        }
+        disk_manager->write_pages(fd, page_no, iov.data(), n);
+    }
+    disk_manager->set_fd2pageno(fd, num_pages);
+    drop_file_cache(fd);
+    return fd;
+}
+
+static void print_result(const std::string &name, int num_ios, double seconds) {
+    printf("%-32s %10d ios %10.3f s %12.0f iops %10.2f MB/s\n", name.c_str(), num_ios, seconds, num_ios / seconds,
+           num_ios * (double)PAGE_SIZE / seconds / (1024 * 1024));
+}
+
+/**
+ * @description: 比较同步引擎和io_uring引擎在不同队列深度下的随机读，以及整文件写回（模拟checkpoint）的吞吐
+ * 参数: [num_pages=16384] [num_reads=8192]
+ */
+static void bench_io_engine(int argc, char **argv) {
+    int num_pages = argc > 0 ? atoi(argv[0]) : 16384;
+    int num_reads = argc > 1 ? atoi(argv[1]) : 8192;
+    const std::string filename = "storage_bench_io_engine.db";
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    int fd = create_bench_file(disk_manager.get(), filename, num_pages);
+
+    std::mt19937 rng(2023);
+    std::vector<page_id_t> targets(num_reads);
+    for (auto &page_no : targets) {
+        page_no = rng() % num_pages;
+    }
+
+    // 基准：阻塞式read_page，队列深度为1
+    {
+        char buf[MAX_PAGE_SIZE];
+        auto start = bench_clock::now();
+        for (page_id_t page_no : targets) {
+            disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+        }
+        print_result("read_page (blocking)", num_reads, elapsed_seconds(start));
+        drop_file_cache(fd);
+    }
+
+    for (IoEngineType type : {IoEngineType::SYNC, IoEngineType::IO_URING}) {
+        for (unsigned queue_depth : {1u, 4u, 32u}) {
+            disk_manager->set_io_engine(type, queue_depth);
+            std::string name = disk_manager->get_io_engine()->name() + " random read qd=" + std::to_string(queue_depth);
+
+            // 滑动窗口：保持queue_depth个读请求在途，第i个请求使用第i % queue_depth个缓冲区
+            std::vector<char> bufs(queue_depth * PAGE_SIZE);
+            std::deque<std::future<void>> window;
+            auto start = bench_clock::now();
+            for (int i = 0; i < num_reads; i++) {
+                if (window.size() == queue_depth) {
+                    window.front().get();
+                    window.pop_front();
+                }
+                char *buf = bufs.data() + (i % queue_depth) * PAGE_SIZE;
+                window.push_back(disk_manager->async_read_page(fd, targets[i], buf, PAGE_SIZE));
+            }
+            while (!window.empty()) {
+                window.front().get();
+                window.pop_front();
+            }
+            print_result(name, num_reads, elapsed_seconds(start));
+            drop_file_cache(fd);
+        }
+
+        // 整文件写回：一次性提交全部页面后等待，最后fdatasync
+        std::string name = disk_manager->get_io_engine()->name() + " checkpoint write";
+        std::vector<char> bufs(num_pages * (size_t)PAGE_SIZE, 0x5a);
+        std::vector<std::future<void>> pending;
+        auto start = bench_clock::now();
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            pending.push_back(
+                disk_manager->async_write_page(fd, page_no, bufs.data() + (size_t)page_no * PAGE_SIZE, PAGE_SIZE));
+        }
+        for (auto &io : pending) {
+            io.get();
+        }
+        fdatasync(fd);
+        print_result(name, num_pages, elapsed_seconds(start));
+        drop_file_cache(fd);
+    }
+
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+}
+
+/**
+ * @description: 在多个文件中随机弄脏大量页面后调用flush_all_page，统计排序合并后的写请求数和耗时
+ * 参数: [num_files=4] [pages_per_file=16384] [dirty_ratio=0.5]
+ */
+static void bench_flush(int argc, char **argv) {
+    int num_files = argc > 0 ? atoi(argv[0]) : 4;
+    int pages_per_file = argc > 1 ? atoi(argv[1]) : 16384;
+    double dirty_ratio = argc > 2 ? atof(argv[2]) : 0.5;
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto bpm = std::make_unique<BufferPoolManager>(num_files * pages_per_file, disk_manager.get());
+    std::vector<int> fds;
+    for (int i = 0; i < num_files; i++) {
+        fds.push_back(create_bench_file(disk_manager.get(), "storage_bench_flush_" + std::to_string(i) + ".db",
+                                        pages_per_file));
+    }
+
+    std::mt19937 rng(2023);
+    std::uniform_real_distribution<double> dist(0, 1);
+    for (int fd : fds) {
+        for (int page_no = 0; page_no < pages_per_file; page_no++) {
+            Page *page = bpm->fetch_page(PageId{fd, page_no});
+            bool dirty = dist(rng) < dirty_ratio;
+            if (dirty) page->get_data()[0]++;
+            bpm->unpin_page(PageId{fd, page_no}, dirty);
+        }
+    }
+
+    auto start = bench_clock::now();
+    FlushStats stats = bpm->flush_all_page();
+    for (int fd : fds) {
+        fdatasync(fd);
+    }
+    double seconds = elapsed_seconds(start);
+    print_result("flush_all_page", stats.pages, seconds);
+    printf("%-32s %10zu bytes %8zu write requests %8.1f pages/request\n", "", stats.bytes, stats.syscalls,
+           stats.syscalls == 0 ? 0.0 : (double)stats.pages / stats.syscalls);
+
+    for (int i = 0; i < num_files; i++) {
+        bpm->delete_all_page(fds[i]);
+        disk_manager->close_file(fds[i]);
+        disk_manager->destroy_file("storage_bench_flush_" + std::to_string(i) + ".db");
+    }
+}
+
+/**
+ * @description: 在不同页面大小下比较B+树的扇出、表文件的空间利用率和冷启动全表扫描的吞吐
+ * 每种页面大小使用相同字节数的缓冲池，记录为record_size字节的定长记录
+ * 参数: [num_records=200000] [record_size=400] [pool_mb=64]
+ */
+static void bench_page_size(int argc, char **argv) {
+    int num_records = argc > 0 ? atoi(argv[0]) : 200000;
+    int record_size = argc > 1 ? atoi(argv[1]) : 400;
+    size_t pool_bytes = (argc > 2 ? atol(argv[2]) : 64) * 1024 * 1024;
+    const std::string filename = "storage_bench_page_size.tab";
+
+    printf("%-10s %8s %8s %10s %8s %10s %12s %10s\n", "page_size", "fanout", "height", "recs/page", "fill",
+           "pages", "scan recs/s", "scan MB/s");
+    for (int page_size : {4096, 8192, 16384, 32768}) {
+        auto disk_manager = std::make_unique<DiskManager>();
+        auto bpm = std::make_unique<BufferPoolManager>(pool_bytes / page_size, disk_manager.get());
+        bpm->set_page_size(page_size);
+        RmManager rm_manager(disk_manager.get(), bpm.get());
+        IxManager ix_manager(disk_manager.get(), bpm.get());
+
+        // B+树扇出：以int为键的索引中每个结点最多容纳的键值对数量，以及容纳num_records个键需要的层数
+        ColMeta key_col = {.tab_name = filename, .name = "id", .type = TYPE_INT, .len = sizeof(int), .offset = 0};
+        if (ix_manager.exists(filename, {key_col})) {
+            ix_manager.destroy_index(filename, {key_col});
+        }
+        ix_manager.create_index(filename, {key_col});
+        auto ih = ix_manager.open_index(filename, {key_col});
+        int fanout = ih->get_file_hdr()->btree_order_;
+        ix_manager.close_index(ih.get());
+        ix_manager.destroy_index(filename, {key_col});
+        int height = 1;
+        for (double capacity = fanout; capacity < num_records; capacity *= fanout) {
+            height++;
+        }
+
+        // 按页面顺序填满表文件
+        if (disk_manager->is_file(filename)) {
+            disk_manager->destroy_file(filename);
+        }
+        rm_manager.create_file(filename, record_size);
+        auto fh = rm_manager.open_file(filename);
+        int records_per_page = fh->get_file_hdr().num_records_per_page;
+        std::vector<char> record(record_size, 0x5a);
+        for (int i = 0; i < num_records; i++) {
+            int slot_no = i % records_per_page;
+            page_id_t page_no;
+            if (slot_no == 0) {
+                RmPageHandle page_handle = fh->create_new_page_handle();
+                page_no = page_handle.page->get_page_id().page_no;
+                bpm->unpin_page(page_handle.page->get_page_id(), true);
+            } else {
+                page_no = fh->get_file_hdr().num_pages - 1;
+            }
+            memcpy(record.data(), &i, sizeof(int));
+            fh->insert_record(Rid{page_no, slot_no}, record.data());
+        }
+        int num_pages = fh->get_file_hdr().num_pages;
+        double fill = (double)records_per_page * record_size / page_size;
+        bpm->flush_all_pages(fh->GetFd());
+        drop_file_cache(fh->GetFd());
+        rm_manager.close_file(fh.get());
+
+        // 冷启动全表扫描，每条记录读取其第一个int
+        bpm = std::make_unique<BufferPoolManager>(pool_bytes / page_size, disk_manager.get());
+        bpm->set_page_size(page_size);
+        RmManager scan_rm_manager(disk_manager.get(), bpm.get());
+        fh = scan_rm_manager.open_file(filename);
+        auto start = bench_clock::now();
+        long long sum = 0;
+        int num_scanned = 0;
+        for (RmScan scan(fh.get()); !scan.is_end(); scan.next_page()) {
+            for (int slot_no : scan.slots()) {
+                sum += *reinterpret_cast<const int *>(scan.get_record(slot_no));
+                num_scanned++;
+            }
+        }
+        double seconds = elapsed_seconds(start);
+        if (num_scanned != num_records || sum != (long long)num_records * (num_records - 1) / 2) {
+            std::cerr << "page_size " << page_size << ": scan returned wrong records" << std::endl;
+        }
+        printf("%-10d %8d %8d %10d %7.1f%% %10d %12.0f %10.1f\n", page_size, fanout, height, records_per_page,
+               fill * 100, num_pages, num_scanned / seconds,
+               (double)num_pages * page_size / seconds / (1024 * 1024));
+        scan_rm_manager.close_file(fh.get());
+        rm_manager.destroy_file(filename);
+    }
+    PAGE_SIZE = DEFAULT_PAGE_SIZE;
+}
+
+/**
+ * @description: 多线程命中路径吞吐：所有页面预先读入缓冲池，各线程随机fetch_page/unpin_page，
+ * 比较单分片（等价于全局latch）和默认分片数下线程数从1增加到max_threads时的吞吐
+ * 参数: [num_pages=16384] [ops_per_thread=1000000] [max_threads=32]
+ */
+static void bench_hit_path(int argc, char **argv) {
+    int num_pages = argc > 0 ? atoi(argv[0]) : 16384;
+    int ops_per_thread = argc > 1 ? atoi(argv[1]) : 1000000;
+    int max_threads = argc > 2 ? atoi(argv[2]) : 32;
+    const std::string filename = "storage_bench_hit_path.db";
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    int fd = create_bench_file(disk_manager.get(), filename, num_pages);
+    printf("%-10s %8s %14s\n", "shards", "threads", "ops/s");
+    for (size_t num_shards : {size_t(1), size_t(0)}) {
+        auto bpm = std::make_unique<BufferPoolManager>(num_pages, disk_manager.get(), num_shards);
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            bpm->fetch_page(PageId{fd, page_no});
+            bpm->unpin_page(PageId{fd, page_no}, false);
+        }
+        for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+            std::vector<std::thread> threads;
+            auto start = bench_clock::now();
+            for (int t = 0; t < num_threads; t++) {
+                threads.emplace_back([&, t]() {
+                    std::mt19937 rng(t);
+                    std::uniform_int_distribution<int> dist(0, num_pages - 1);
+                    for (int i = 0; i < ops_per_thread; i++) {
+                        Page *page = bpm->fetch_page(PageId{fd, dist(rng)});
+                        if (page == nullptr) {
+                            std::cerr << "hit_path: fetch_page failed" << std::endl;
+                            exit(1);
+                        }
+                        bpm->unpin_page(page, false);
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            double seconds = elapsed_seconds(start);
+            printf("%-10zu %8d %14.0f\n", bpm->get_num_shards(), num_threads,
+                   (double)num_threads * ops_per_thread / seconds);
+        }
+        bpm->delete_all_page(fd);
+    }
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+}
+
+/**
+ * @description: 点查询与并发全表扫描混合时各置换策略下点查询的命中率
+ * 点查询在hot_pages个页面（模拟索引内部结点和小表）中随机访问，另一个线程反复顺序扫描scan_pages个页面的大表，
+ * 每个页面连续访问8次（模拟逐条记录访问），缓冲池可容纳全部热点页面但远小于大表，点查询的缺页数取自热点文件的读请求数
+ * 参数: [hot_pages=512] [scan_pages=16384] [pool_pages=1024] [num_lookups=200000]
+ */
+static void bench_scan_resistance(int argc, char **argv) {
+    int hot_pages = argc > 0 ? atoi(argv[0]) : 512;
+    int scan_pages = argc > 1 ? atoi(argv[1]) : 16384;
+    int pool_pages = argc > 2 ? atoi(argv[2]) : 1024;
+    int num_lookups = argc > 3 ? atoi(argv[3]) : 200000;
+    constexpr int accesses_per_scan_page = 8;
+    const std::string hot_filename = "storage_bench_scan_resistance_hot.db";
+    const std::string scan_filename = "storage_bench_scan_resistance_scan.db";
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    int hot_fd = create_bench_file(disk_manager.get(), hot_filename, hot_pages);
+    int scan_fd = create_bench_file(disk_manager.get(), scan_filename, scan_pages);
+    printf("%-10s %10s %10s %10s %14s\n", "replacer", "lookups", "misses", "hit ratio", "scan pages/s");
+    for (const char *replacer_type : {"LRU", "CLOCK", "LRU-K"}) {
+        auto bpm = std::make_unique<BufferPoolManager>(pool_pages, disk_manager.get());
+        bpm->set_replacer_type(replacer_type);
+        auto access = [&bpm](PageId page_id) {
+            if (bpm->fetch_page(page_id) == nullptr) {
+                std::cerr << "scan_resistance: fetch_page failed" << std::endl;
+                exit(1);
+            }
+            bpm->unpin_page(page_id, false);
+        };
+        // 预热：每个热点页面访问两次
+        for (int round = 0; round < 2; round++) {
+            for (int page_no = 0; page_no < hot_pages; page_no++) {
+                access(PageId{hot_fd, page_no});
+            }
+        }
+
+        std::atomic<bool> stop{false};
+        std::atomic<long long> num_scanned{0};
+        auto start = bench_clock::now();
+        std::thread scan_thread([&]() {
+            while (!stop.load()) {
+                for (int page_no = 0; page_no < scan_pages && !stop.load(); page_no++) {
+                    for (int i = 0; i < accesses_per_scan_page; i++) {
+                        access(PageId{scan_fd, page_no});
+                    }
+                    num_scanned++;
+                }
+            }
+        });
+        size_t reads_before = disk_manager->get_num_reads(hot_fd);
+        std::mt19937 rng(2023);
+        std::uniform_int_distribution<int> dist(0, hot_pages - 1);
+        for (int i = 0; i < num_lookups; i++) {
+            access(PageId{hot_fd, dist(rng)});
+            if (i % 64 == 0) {
+                std::this_thread::yield();  // 让扫描线程在单核机器上也能与点查询交替执行
+            }
+        }
+        size_t misses = disk_manager->get_num_reads(hot_fd) - reads_before;
+        stop = true;
+        scan_thread.join();
+        double seconds = elapsed_seconds(start);
+        printf("%-10s %10d %10zu %9.2f%% %14.0f\n", replacer_type, num_lookups, misses,
+               100.0 * (num_lookups - (double)misses) / num_lookups, num_scanned / seconds);
+        bpm->delete_all_page(hot_fd);
+        bpm->delete_all_page(scan_fd);
+    }
+    disk_manager->close_file(hot_fd);
+    disk_manager->close_file(scan_fd);
+    disk_manager->destroy_file(hot_filename);
+    disk_manager->destroy_file(scan_filename);
+}
+
+/**
+ * @description: 冷缓存顺序扫描在不同预读窗口上限下的吞吐，预读窗口为0时不预读
+ * 扫描按RmScan的方式使用BULK_READ环形缓冲区，在每个页面上计算一次校验和模拟逐条记录处理，每一轮之前丢弃OS page cache
+ * 参数: [num_pages=65536] [pool_pages=4096]
+ */
+static void bench_read_ahead(int argc, char **argv) {
+    int num_pages = argc > 0 ? atoi(argv[0]) : 65536;
+    int pool_pages = argc > 1 ? atoi(argv[1]) : 4096;
+    const std::string filename = "storage_bench_read_ahead.db";
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    int fd = create_bench_file(disk_manager.get(), filename, num_pages);
+    auto bpm = std::make_unique<BufferPoolManager>(pool_pages, disk_manager.get());
+    printf("%-12s %10s %10s %12s\n", "max_pages", "reads", "seconds", "MB/s");
+    for (int max_pages : {0, 8, 32, 128}) {
+        drop_file_cache(fd);
+        bpm->set_read_ahead_max_pages(max_pages);
+        BufferAccessStrategy strategy(BUFFER_RING_BULK_READ_SIZE);
+        size_t reads_before = disk_manager->get_num_reads(fd);
+        uint64_t checksum = 0;
+        auto start = bench_clock::now();
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            bpm->read_ahead(fd, page_no, &strategy);
+            Page *page = bpm->fetch_page(PageId{fd, page_no}, &strategy);
+            if (page == nullptr) {
+                std::cerr << "read_ahead: fetch_page failed" << std::endl;
+                exit(1);
+            }
+            for (int i = 0; i < PAGE_SIZE; i += 8) {
+                checksum = checksum * 31 + *reinterpret_cast<uint64_t *>(page->get_data() + i);
+            }
+            bpm->unpin_page(PageId{fd, page_no}, false);
+        }
+        double seconds = elapsed_seconds(start);
+        printf("%-12d %10zu %10.3f %12.1f\n", max_pages, disk_manager->get_num_reads(fd) - reads_before, seconds,
+               num_pages * (double)PAGE_SIZE / seconds / (1024 * 1024));
+        if (checksum == 0) {
+            std::cerr << "read_ahead: unexpected checksum" << std::endl;
+        }
+        bpm->delete_all_page(fd);
+    }
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+}
+
+// 打开统计当前线程dTLB读缺失次数的硬件计数器，内核或虚拟机不支持时返回-1
+static int open_dtlb_counter() {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+// 读取/proc/self/smaps_rollup中的AnonHugePages，即当前进程使用的透明大页（KB）
+static long anon_huge_pages_kb() {
+    FILE *file = fopen("/proc/self/smaps_rollup", "r");
+    if (file == nullptr) {
+        return -1;
+    }
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) {
+            break;
+        }
+    }
+    fclose(file);
+    return kb;
+}
+
+/**
+ * @description: 比较帧内存的两种分配方式：原来的aligned_alloc + memset，以及BufferPoolManager现在使用的按大页对齐、
+ * madvise(MADV_HUGEPAGE)、首次访问时才清零的匿名映射。分别统计分配耗时、首次写入全部帧的耗时，
+ * 以及在全部帧上随机读取（模拟缓冲池命中路径访问页头）的耗时和dTLB读缺失次数，最后给出构造整个BufferPoolManager的耗时
+ * 参数: [pool_pages=65536] [num_accesses=10000000]
+ */
+static void bench_frame_memory(int argc, char **argv) {
+    size_t pool_pages = argc > 0 ? atol(argv[0]) : BUFFER_POOL_SIZE;
+    long num_accesses = argc > 1 ? atol(argv[1]) : 10000000;
+    size_t bytes = pool_pages * PAGE_SIZE;
+
+    printf("%-14s %10s %12s %12s %14s %14s\n", "allocator", "alloc_ms", "first_use_ms", "access_ns", "dtlb_misses",
+           "huge_pages_kb");
+    for (bool huge_pages : {false, true}) {
+        auto start = bench_clock::now();
+        char *frames;
+        size_t mapped_bytes = 0;
+        if (huge_pages) {
+            frames = BufferPoolManager::allocate_frame_memory(bytes, &mapped_bytes);
+        } else {
+            frames = static_cast<char *>(std::aligned_alloc(PAGE_SIZE, bytes));
+            memset(frames, 0, bytes);
+        }
+        double alloc_ms = elapsed_seconds(start) * 1000;
+
+        // 每个帧写入页头，相当于每个帧第一次装入页面
+        start = bench_clock::now();
+        for (size_t i = 0; i < pool_pages; i++) {
+            frames[i * PAGE_SIZE] = static_cast<char>(i);
+        }
+        double first_use_ms = elapsed_seconds(start) * 1000;
+
+        int counter = open_dtlb_counter();
+        std::mt19937_64 rng(2023);
+        uint64_t checksum = 0;
+        if (counter >= 0) {
+            ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+            ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+        }
+        start = bench_clock::now();
+        for (long i = 0; i < num_accesses; i++) {
+            uint64_t r = rng();
+            checksum += frames[(r % pool_pages) * PAGE_SIZE + (r >> 52) % PAGE_SIZE];
+        }
+        double access_ns = elapsed_seconds(start) * 1e9 / num_accesses;
+        long long misses = -1;
+        if (counter >= 0) {
+            ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) {
+                misses = -1;
+            }
+            close(counter);
+        }
+        long huge_kb = anon_huge_pages_kb();
+        printf("%-14s %10.1f %12.1f %12.1f %14s %14ld\n", huge_pages ? "mmap+thp" : "aligned_alloc", alloc_ms,
+               first_use_ms, access_ns, misses < 0 ? "n/a" : std::to_string(misses).c_str(), huge_kb);
+        if (checksum == 1) {
+            printf("\n");
+        }
+        if (huge_pages) {
+            BufferPoolManager::free_frame_memory(frames, mapped_bytes);
+        } else {
+            std::free(frames);
+        }
+    }
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto start = bench_clock::now();
+    auto bpm = std::make_unique<BufferPoolManager>(pool_pages, disk_manager.get());
+    printf("BufferPoolManager(%zu) constructed in %.1f ms\n", pool_pages, elapsed_seconds(start) * 1000);
+}
+
+/**
+ * @description: 缓冲池被一个大文件占满时，反复写回并删除一个小文件的页面（close_index、drop_table的场景），
+ * 统计每次flush_all_pages(fd)和delete_all_page(fd)的平均耗时，只与小文件驻留的页面数有关而与缓冲池大小无关
+ * 参数: [pool_pages=262144] [small_pages=16] [rounds=1000]
+ */
+static void bench_drop_small_file(int argc, char **argv) {
+    int pool_pages = argc > 0 ? atoi(argv[0]) : 262144;
+    int small_pages = argc > 1 ? atoi(argv[1]) : 16;
+    int rounds = argc > 2 ? atoi(argv[2]) : 1000;
+    const std::string big_file = "storage_bench_drop_big.db";
+    const std::string small_file = "storage_bench_drop_small.db";
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    int big_fd = create_bench_file(disk_manager.get(), big_file, pool_pages - small_pages);
+    int small_fd = create_bench_file(disk_manager.get(), small_file, small_pages);
+    auto bpm = std::make_unique<BufferPoolManager>(pool_pages, disk_manager.get());
+    for (int page_no = 0; page_no < pool_pages - small_pages; page_no++) {
+        bpm->unpin_page(bpm->fetch_page(PageId{big_fd, page_no}), false);
+    }
+
+    double flush_seconds = 0;
+    double delete_seconds = 0;
+    for (int round = 0; round < rounds; round++) {
+        for (int page_no = 0; page_no < small_pages; page_no++) {
+            bpm->unpin_page(bpm->fetch_page(PageId{small_fd, page_no}), true);
+        }
+        auto start = bench_clock::now();
+        bpm->flush_all_pages(small_fd);
+        flush_seconds += elapsed_seconds(start);
+        start = bench_clock::now();
+        if (!bpm->delete_all_page(small_fd)) {
+            std::cerr << "drop_small_file: delete_all_page failed" << std::endl;
+            exit(1);
+        }
+        delete_seconds += elapsed_seconds(start);
+    }
+    printf("pool_pages %d small_pages %d: flush_all_pages %.1f us, delete_all_page %.1f us\n", pool_pages,
+           small_pages, flush_seconds / rounds * 1e6, delete_seconds / rounds * 1e6);
+
+    bpm->delete_all_page(big_fd);
+    disk_manager->close_file(big_fd);
+    disk_manager->destroy_file(big_file);
+    disk_manager->close_file(small_fd);
+    disk_manager->destroy_file(small_file);
+}
+
+struct BenchCase {
+    const char *name;
+    void (*run)(int argc, char **argv);
+    const char *usage;
+};
+
+static const BenchCase bench_cases[] = {
+    {"io_engine", bench_io_engine, "[num_pages=16384] [num_reads=8192]"},
+    {"flush", bench_flush, "[num_files=4] [pages_per_file=16384] [dirty_ratio=0.5]"},
+    {"page_size", bench_page_size, "[num_records=200000] [record_size=400] [pool_mb=64]"},
+    {"hit_path", bench_hit_path, "[num_pages=16384] [ops_per_thread=1000000] [max_threads=32]"},
+    {"scan_resistance", bench_scan_resistance, "[hot_pages=512] [scan_pages=16384] [pool_pages=1024] [num_lookups=200000]"},
+    {"read_ahead", bench_read_ahead, "[num_pages=65536] [pool_pages=4096]"},
+    {"frame_memory", bench_frame_memory, "[pool_pages=65536] [num_accesses=10000000]"},
+    {"drop_small_file", bench_drop_small_file, "[pool_pages=262144] [small_pages=16] [rounds=1000]"},
+};
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <case> [args...]\n";
+        for (auto &bench_case : bench_cases) {
+            std::cerr << "    " << bench_case.name << " " << bench_case.usage << "\n";
+        }
+        exit(1);
+    }
+    for (auto &bench_case : bench_cases) {
+        if (strcmp(argv[1], bench_case.name) == 0) {
+            bench_case.run(argc - 2, argv + 2);
+            return 0;
+        }
+    }
+    std::cerr << "Unknown case: " << argv[1] << std::endl;
+    return 1;
+}
@@ -13,7 +13,11 @@ See the Mulan PSL v2 for more details. */
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <climits>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
 
 #include "index/ix.h"
 #include "record/rm.h"
@@ -32,11 +36,17 @@ bool SmManager::is_dir(const std::string& db_name) {
 /**
  * @description: 创建数据库，所有的数据库相关文件都放在数据库同名文件夹下
  * @param {string&} db_name 数据库名称
+ * @param {int} page_size 数据库的页面大小，必须是MIN_PAGE_SIZE到MAX_PAGE_SIZE之间的2的幂，创建后不可修改
+ * @param {bool} tablespace 是否将表文件和索引文件存放在表空间的段文件中，创建后不可修改
+ * @param {bool} direct_io 是否以O_DIRECT读写表文件和索引文件，创建后不可修改
  */
-void SmManager::create_db(const std::string& db_name) {
+void SmManager::create_db(const std::string& db_name, int page_size, bool tablespace, bool direct_io) {
     if (is_dir(db_name)) {
         throw DatabaseExistsError(db_name);
     }
+    if (page_size < MIN_PAGE_SIZE || page_size > MAX_PAGE_SIZE || (page_size & (page_size - 1)) != 0) {
+        throw InvalidPageSizeError(page_size);
+    }
     //为数据库创建一个子目录
     std::string cmd = "mkdir " + db_name;
     if (system(cmd.c_str()) < 0) {  // 创建一个名为db_name的目录
@@ -46,7 +56,7 @@ void SmManager::create_db(const std::string& db_name) {
         throw UnixError();
     }
     //创建系统目录
-    DbMeta *new_db = new DbMeta(db_name);
+    DbMeta *new_db = new DbMeta(db_name, page_size, tablespace, direct_io);
 
     // 注意，此处ofstream会在当前目录创建(如果没有此文件先创建)和打开一个名为DB_META_NAME的文件
     std::ofstream ofs(DB_META_NAME);
@@ -82,8 +92,10 @@ void SmManager::drop_db(const std::string& db_name) {
 /**
  * @description: 打开数据库，找到数据库对应的文件夹，并加载数据库元数据和相关文件
  * @param {string&} db_name 数据库名称，与文件夹同名
+ * @param {bool} tablespace 启动时要求使用表空间模式，数据库不是以表空间模式创建时拒绝打开
+ * @param {bool} direct_io 启动时要求使用O_DIRECT，数据库不是以O_DIRECT创建时拒绝打开
  */
-void SmManager::open_db(const std::string& db_name) {
+void SmManager::open_db(const std::string& db_name, bool tablespace, bool direct_io) {
     if (!is_dir(db_name)) {
         throw DatabaseNotFoundError(db_name);
     }
@@ -93,6 +105,23 @@ void SmManager::open_db(const std::string& db_name) {
 
     std::ifstream(DB_META_NAME) >> db_; // 加载数据库元数据
 
+    // 按数据库的页面大小重新分配缓冲池的帧，之后打开的文件都按这一页面大小读写
+    int page_size = db_.get_page_size();
+    if (page_size < MIN_PAGE_SIZE || page_size > MAX_PAGE_SIZE || (page_size & (page_size - 1)) != 0) {
+        throw InvalidPageSizeError(page_size);
+    }
+    buffer_pool_manager_->set_page_size(page_size);
+
+    // 按创建数据库时选定的模式查找和读写表文件和索引文件
+    if (tablespace && !db_.is_tablespace()) {
+        throw DatabaseModeMismatchError(db_name, "--tablespace");
+    }
+    if (direct_io && !db_.is_direct_io()) {
+        throw DatabaseModeMismatchError(db_name, "--direct-io");
+    }
+    disk_manager_->set_tablespace_mode(db_.is_tablespace());
+    disk_manager_->set_direct_io(db_.is_direct_io());
+
     // 加载数据库表文件
     for (const auto &[tab_name, _] : db_.tabs_) {
         fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
@@ -102,9 +131,25 @@ void SmManager::open_db(const std::string& db_name) {
     for (const auto &[tab_name, tab] : db_.tabs_) {
         for (auto &index : tab.indexes) {
             std::string index_name = ix_manager_->get_index_name(tab_name, index.cols);
-            ihs_.emplace(tab_name, ix_manager_->open_index(tab_name, tab.cols));
+            ihs_.emplace(index_name, ix_manager_->open_index(tab_name, index.cols));
+        }
+    }
+
+    // 恢复表和索引的缓冲池策略，预热读入的页面即按这些策略管理
+    for (const auto &[file_name, policy] : db_.buffer_policies_) {
+        int fd = disk_manager_->find_file_fd(file_name);
+        if (fd >= 0) {
+            buffer_pool_manager_->set_file_policy(fd, policy);
         }
     }
+
+    // 设置驻留页面列表的转储文件，rmdb在恢复完成后按上次关闭时的转储在后台预热缓冲池。
+    // 转储文件使用绝对路径，供后台写回线程周期性地转储
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) == nullptr) {
+        throw UnixError();
+    }
+    buffer_pool_manager_->set_warmup_dump_path(std::string(cwd) + "/" + BUFFER_POOL_DUMP_NAME);
 }
 
 /**
@@ -121,9 +166,33 @@ void SmManager::flush_meta() {
  */
 void SmManager::close_db() {
     flush_meta();
+    // 转储驻留页面列表，供下次打开数据库时预热缓冲池
+    buffer_pool_manager_->stop_warmup();
+    try {
+        buffer_pool_manager_->dump_resident_pages();
+    } catch (RMDBError &e) {
+        std::cerr << "Failed to dump buffer pool: " << e.what() << std::endl;
+    }
+    buffer_pool_manager_->set_warmup_dump_path("");
+    // 文件关闭后fd可能被复用，恢复为默认策略
+    for (const auto &[file_name, policy] : db_.buffer_policies_) {
+        int fd = disk_manager_->find_file_fd(file_name);
+        if (fd >= 0) {
+            buffer_pool_manager_->set_file_policy(fd, BufferPolicy());
+        }
+    }
     // 刷新全部脏页
     buffer_pool_manager_->flush_all_page();
 
+    // 关闭索引文件，写回索引文件头（根节点、叶子链表等），否则下次打开数据库时索引为空
+    for (auto &[index_name, ih] : ihs_) {
+        ix_manager_->close_index(ih.get());
+    }
+    // 关闭表文件，写回文件头，并在关闭时将空闲页表写入磁盘，否则释放的页面在下次打开数据库后无法重用
+    for (auto &[tab_name, fh] : fhs_) {
+        rm_manager_->close_file(fh.get());
+    }
+
     // 清空记录
     fhs_.clear();
     ihs_.clear();
@@ -177,7 +246,8 @@ void SmManager::desc_table(const std::string& tab_name, Context* context) {
     printer.print_separator(context);
     // Print fields
     for (auto &col : tab.cols) {
-        std::vector<std::string> field_info = {col.name, coltype2str(col.type), col.index ? "YES" : "NO"};
+        std::string type_str = col.is_varchar ? "VARCHAR" : coltype2str(col.type);
+        std::vector<std::string> field_info = {col.name, type_str, col.index ? "YES" : "NO"};
         printer.print_record(field_info, context);
     }
     // Print footer
@@ -197,19 +267,25 @@ void SmManager::create_table(const std::string& tab_name, const std::vector<ColD
     // Create table meta
     int curr_offset = 0;
     TabMeta tab(tab_name);
+    std::vector<RmVarCol> var_cols;
     for (const auto &col_def : col_defs) {
+        if (col_def.is_varchar) {
+            var_cols.push_back(RmVarCol{.offset = curr_offset, .len = col_def.len});
+        }
         ColMeta col = {.tab_name = tab_name,
                        .name     = col_def.name,
                        .type     = col_def.type,
                        .len      = col_def.len,
                        .offset   = curr_offset,
-                       .index    = false};
+                       .index    = false,
+                       .is_varchar = col_def.is_varchar};
         curr_offset += col_def.len;
         tab.cols.push_back(col);
     }
     // Create & open record file
     int record_size = curr_offset;  // record_size就是col meta所占的大小（表的元数据也是以记录的形式进行存储的）
-    rm_manager_->create_file(tab_name, record_size);
+    // 含有VARCHAR字段的表使用slotted page格式，变长字段只保存实际内容
+    rm_manager_->create_file(tab_name, record_size, var_cols);
     db_.tabs_.emplace(tab_name, tab);
     fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
 
@@ -232,6 +308,7 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
     }
 
     //先删除db_中的表，再删除文件表，最后删除fhs_中的表
+    clear_buffer_policy(tab_name);
     fhs_[tab_name]->close_all_page();
     rm_manager_->close_file(fhs_[tab_name].get());
     rm_manager_->destroy_file(tab_name);
@@ -279,6 +356,9 @@ void SmManager::create_index(const std::string& tab_name, const std::vector<std:
     }
     // 加载col len
     new_index.col_tot_len = 0;
+    for (auto &col : new_index.cols) {
+        new_index.col_tot_len += col.len;
+    }
 
     // 加载
     ix_manager_->create_index(tab_name, new_index.cols);
@@ -295,14 +375,19 @@ void SmManager::create_index(const std::string& tab_name, const std::vector<std:
     char *key = new char[new_index.col_tot_len];
     auto ix_hdl = ihs_.at(index_name).get();
     auto file_hdl = fhs_.at(tab_name).get();
-    for (RmScan rm_scan(file_hdl); !rm_scan.is_end(); rm_scan.next()) {
-        auto rec = file_hdl->get_record(rm_scan.rid(), context);  
-        int offset = 0;
-        for(size_t i = 0; i < new_index.col_num; ++i) {
-                memcpy(key + offset, rec->data + new_index.cols[i].offset, new_index.cols[i].len);
+    // 按页面批量扫描，每个页面只pin一次，键直接从缓冲池页面中的记录构造
+    for (RmScan rm_scan(file_hdl); !rm_scan.is_end(); rm_scan.next_page()) {
+        for (int slot_no : rm_scan.slots()) {
+            Rid rid{.page_no = rm_scan.page_no(), .slot_no = slot_no};
+            context->lock_mgr_->lock_shared_on_record(context->txn_, rid, file_hdl->GetFd());
+            const char *rec = rm_scan.get_record(slot_no);
+            int offset = 0;
+            for(size_t i = 0; i < new_index.col_num; ++i) {
+                memcpy(key + offset, rec + new_index.cols[i].offset, new_index.cols[i].len);
                 offset += new_index.cols[i].len;
             }
-        ix_hdl->insert_entry(key, rm_scan.rid(), context->txn_);
+            ix_hdl->insert_entry(key, rid, context->txn_);
+        }
     }
 
     delete[] key;
@@ -327,6 +412,7 @@ void SmManager::drop_index(const std::string& tab_name, const std::vector<std::s
 
     table.indexes.erase(table.get_index_meta(col_names));
     std::string index_name = ix_manager_->get_index_name(tab_name, col_names);
+    clear_buffer_policy(index_name);
     ix_manager_->close_index(ihs_.at(index_name).get());
     ix_manager_->destroy_index(tab_name, col_names);
     ihs_.erase(ix_manager_->get_index_name(tab_name, col_names));
@@ -356,6 +442,7 @@ void SmManager::drop_index(const std::string& tab_name, const std::vector<ColMet
 
     table.indexes.erase(table.get_index_meta(col_names));
     std::string index_name = ix_manager_->get_index_name(tab_name, col_names);
+    clear_buffer_policy(index_name);
     ix_manager_->close_index(ihs_.at(index_name).get());
     ix_manager_->destroy_index(tab_name, col_names);
     ihs_.erase(ix_manager_->get_index_name(tab_name, col_names));
@@ -399,4 +486,244 @@ void SmManager::show_index(const std::string& tab_name, Context* context) {
         printer.print_record({tab_name, "unique", x}, context);
     }
     printer.print_separator(context);
+}
+/**
+ * @description: 设置表或索引的缓冲池策略并保存在db.meta中，立即对文件已驻留的页面生效
+ * @param {string&} tab_name 表名称
+ * @param {vector<string>&} col_names 索引包含的字段，为空时设置表的策略
+ * @param {vector<pair<string, string>>&} options 选项名和选项值，buffer_priority为pinned、normal或low，
+ *        max_buffer_pct为1到100之间的整数
+ */
+void SmManager::set_buffer_policy(const std::string& tab_name, const std::vector<std::string>& col_names,
+                                  const std::vector<std::pair<std::string, std::string>>& options) {
+    TabMeta &tab = db_.get_table(tab_name);
+    std::string file_name = tab_name;
+    if (!col_names.empty()) {
+        if (!tab.is_index(col_names)) {
+            throw IndexNotFoundError(tab_name, col_names);
+        }
+        file_name = ix_manager_->get_index_name(tab_name, col_names);
+    }
+
+    BufferPolicy policy;
+    auto record = db_.buffer_policies_.find(file_name);
+    if (record != db_.buffer_policies_.end()) {
+        policy = record->second;
+    }
+    for (auto [name, value] : options) {
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+        if (name == "buffer_priority") {
+            if (value == "pinned") {
+                policy.priority = BufferPriority::PINNED;
+            } else if (value == "normal") {
+                policy.priority = BufferPriority::NORMAL;
+            } else if (value == "low") {
+                policy.priority = BufferPriority::LOW;
+            } else {
+                throw InvalidSettingValueError(name, value);
+            }
+        } else if (name == "max_buffer_pct") {
+            char *end = nullptr;
+            long pct = std::strtol(value.c_str(), &end, 10);
+            if (value.empty() || *end != '\0' || pct < 1 || pct > 100) {
+                throw InvalidSettingValueError(name, value);
+            }
+            policy.max_buffer_pct = static_cast<int>(pct);
+        } else {
+            throw SettingNotFoundError(name);
+        }
+    }
+
+    if (policy.is_default()) {
+        db_.buffer_policies_.erase(file_name);
+    } else {
+        db_.buffer_policies_[file_name] = policy;
+    }
+    flush_meta();
+    buffer_pool_manager_->set_file_policy(disk_manager_->get_file_fd(file_name), policy);
+}
+
+/**
+ * @description: 删除文件的缓冲池策略，在关闭并删除表文件或索引文件之前调用
+ * @param {string&} file_name 表文件或索引文件名
+ */
+void SmManager::clear_buffer_policy(const std::string& file_name) {
+    if (db_.buffer_policies_.erase(file_name) == 0) {
+        return;
+    }
+    int fd = disk_manager_->find_file_fd(file_name);
+    if (fd >= 0) {
+        buffer_pool_manager_->set_file_policy(fd, BufferPolicy());
+    }
+}
+
+/**
+ * @description: 显示每个表和索引的缓冲池策略以及驻留在缓冲池中的页面数
+ * @param {Context*} context
+ */
+void SmManager::show_buffer_residency(Context* context) {
+    static const char* priority_names[] = {"low", "normal", "pinned"};
+    std::vector<std::string> captions = {"File", "Priority", "Max_pct", "Pages"};
+    std::vector<std::vector<std::string>> rows;
+    auto add_row = [&](const std::string& file_name) {
+        int fd = disk_manager_->find_file_fd(file_name);
+        BufferPolicy policy = fd >= 0 ? buffer_pool_manager_->get_file_policy(fd) : BufferPolicy();
+        size_t num_pages = fd >= 0 ? buffer_pool_manager_->get_resident_pages(fd) : 0;
+        rows.push_back({file_name, priority_names[static_cast<int>(policy.priority)],
+                        std::to_string(policy.max_buffer_pct), std::to_string(num_pages)});
+    };
+    for (const auto &[tab_name, tab] : db_.tabs_) {
+        add_row(tab_name);
+        for (const auto &index : tab.indexes) {
+            add_row(ix_manager_->get_index_name(tab_name, index.cols));
+        }
+    }
+
+    if (output2file) {
+        std::fstream outfile;
+        outfile.open("output.txt", std::ios::out | std::ios::app);
+        outfile << "|";
+        for (auto &caption : captions) {
+            outfile << " " << caption << " |";
+        }
+        outfile << "\n";
+        for (auto &row : rows) {
+            outfile << "|";
+            for (auto &field : row) {
+                outfile << " " << field << " |";
+            }
+            outfile << "\n";
+        }
+        outfile.close();
+    }
+
+    RecordPrinter printer(captions.size());
+    printer.print_separator(context);
+    printer.print_record(captions, context);
+    printer.print_separator(context);
+    for (auto &row : rows) {
+        printer.print_record(row, context);
+    }
+    printer.print_separator(context);
+}
+
+/**
+ * @description: 运行时可通过set/show语句读写的设置项
+ */
+struct Setting {
+    int min_value;
+    int max_value;
+    std::function<int(BufferPoolManager*)> get;
+    std::function<void(BufferPoolManager*, int)> set;
+};
+
+static const std::map<std::string, Setting>& get_settings() {
+    static const std::map<std::string, Setting> settings = {
+        {"bgwriter_delay",
+         {10, 10000, &BufferPoolManager::get_bgwriter_delay, &BufferPoolManager::set_bgwriter_delay}},
+        {"bgwriter_max_pages",
+         {0, BUFFER_POOL_SIZE, &BufferPoolManager::get_bgwriter_max_pages, &BufferPoolManager::set_bgwriter_max_pages}},
+        {"bgwriter_low_watermark",
+         {0, 100, &BufferPoolManager::get_bgwriter_low_watermark, &BufferPoolManager::set_bgwriter_low_watermark}},
+        {"bgwriter_high_watermark",
+         {0, 100, &BufferPoolManager::get_bgwriter_high_watermark, &BufferPoolManager::set_bgwriter_high_watermark}},
+        {"read_ahead_max_pages",
+         {0, 256, &BufferPoolManager::get_read_ahead_max_pages, &BufferPoolManager::set_read_ahead_max_pages}},
+        // 缓冲池大小，以MB为单位，修改时在线增减帧数，见BufferPoolManager::resize
+        {"buffer_pool_size",
+         {1, std::numeric_limits<int>::max(),
+          [](BufferPoolManager* bpm) { return static_cast<int>(bpm->get_pool_size() * PAGE_SIZE >> 20); },
+          [](BufferPoolManager* bpm, int size_mb) { bpm->resize((static_cast<size_t>(size_mb) << 20) / PAGE_SIZE); }}},
+    };
+    return settings;
+}
+
+/**
+ * @description: 只能通过show语句查看的状态项
+ */
+static const std::map<std::string, std::function<std::string(BufferPoolManager*)>>& get_statuses() {
+    static const std::map<std::string, std::function<std::string(BufferPoolManager*)>> statuses = {
+        // 缓冲池预热的进度，即已读入的页面数/需要预热的页面数，以及预热是否仍在进行，如"1024/65536 running"
+        {"buffer_pool_warmup",
+         [](BufferPoolManager* bpm) {
+             auto stats = bpm->get_warmup_stats();
+             return std::to_string(stats.loaded) + "/" + std::to_string(stats.total) + (stats.active ? " running" : " done");
+         }},
+    };
+    return statuses;
+}
+
+/**
+ * @description: 按名称查找设置项，名称不区分大小写
+ */
+static const Setting& find_setting(std::string& name) {
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    if (get_statuses().count(name) != 0 || name == "buffer_pool_residency") {
+        throw ReadOnlySettingError(name);
+    }
+    auto setting = get_settings().find(name);
+    if (setting == get_settings().end()) {
+        throw SettingNotFoundError(name);
+    }
+    return setting->second;
+}
+
+/**
+ * @description: 修改设置项，立即对之后的操作生效
+ * @param {string&} name 设置项名称
+ * @param {Value&} value 新的值，必须是设置项允许范围内的整数
+ */
+void SmManager::set_setting(const std::string& name, const Value& value) {
+    std::string setting_name = name;
+    const Setting& setting = find_setting(setting_name);
+    if (value.type != TYPE_INT) {
+        throw InvalidSettingValueError(setting_name, value.type == TYPE_STRING ? value.str_val : coltype2str(value.type));
+    }
+    if (value.int_val < setting.min_value || value.int_val > setting.max_value) {
+        throw InvalidSettingValueError(setting_name, std::to_string(value.int_val));
+    }
+    // 低水位不能高于高水位
+    if ((setting_name == "bgwriter_low_watermark" && value.int_val > buffer_pool_manager_->get_bgwriter_high_watermark()) ||
+        (setting_name == "bgwriter_high_watermark" && value.int_val < buffer_pool_manager_->get_bgwriter_low_watermark())) {
+        throw InvalidSettingValueError(setting_name, std::to_string(value.int_val));
+    }
+    setting.set(buffer_pool_manager_, value.int_val);
+}
+
+/**
+ * @description: 显示设置项的当前值
+ * @param {string&} name 设置项名称
+ * @param {Context*} context
+ */
+void SmManager::show_setting(const std::string& name, Context* context) {
+    std::string setting_name = name;
+    std::string value;
+    std::transform(setting_name.begin(), setting_name.end(), setting_name.begin(), ::tolower);
+    // 每个表和索引一行，不是单个值
+    if (setting_name == "buffer_pool_residency") {
+        show_buffer_residency(context);
+        return;
+    }
+    auto status = get_statuses().find(setting_name);
+    if (status != get_statuses().end()) {
+        value = status->second(buffer_pool_manager_);
+    } else {
+        value = std::to_string(find_setting(setting_name).get(buffer_pool_manager_));
+    }
+
+    if (output2file) {
+        std::fstream outfile;
+        outfile.open("output.txt", std::ios::out | std::ios::app);
+        outfile << "| " << setting_name << " |\n";
+        outfile << "| " << value << " |\n";
+        outfile.close();
+    }
+
+    RecordPrinter printer(1);
+    printer.print_separator(context);
+    printer.print_record({setting_name}, context);
+    printer.print_separator(context);
+    printer.print_record({value}, context);
+    printer.print_separator(context);
 }
\ No newline at end of file
@@ -22,6 +22,7 @@ struct ColDef {
     std::string name;  // Column name
     ColType type;      // Type of column
     int len;           // Length of column
+    bool is_varchar = false;  // 是否为VARCHAR字段，在表文件中只保存实际长度的内容
 };
 
 /* 系统管理器，负责元数据管理和DDL语句的执行 */
@@ -54,11 +55,12 @@ class SmManager {
 
     bool is_dir(const std::string& db_name);
 
-    void create_db(const std::string& db_name);
+    void create_db(const std::string& db_name, int page_size = DEFAULT_PAGE_SIZE, bool tablespace = false,
+                   bool direct_io = false);
 
     void drop_db(const std::string& db_name);
 
-    void open_db(const std::string& db_name);
+    void open_db(const std::string& db_name, bool tablespace = false, bool direct_io = false);
 
     void close_db();
 
@@ -79,4 +81,16 @@ class SmManager {
     void drop_index(const std::string& tab_name, const std::vector<ColMeta>& col_names, Context* context);
 
     void show_index(const std::string& tab_name, Context* context);
+
+    void set_buffer_policy(const std::string& tab_name, const std::vector<std::string>& col_names,
+                           const std::vector<std::pair<std::string, std::string>>& options);
+
+    void show_buffer_residency(Context* context);
+
+    void set_setting(const std::string& name, const Value& value);
+
+    void show_setting(const std::string& name, Context* context);
+
+   private:
+    void clear_buffer_policy(const std::string& file_name);
 };
\ No newline at end of file
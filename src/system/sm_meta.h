@@ -13,12 +13,14 @@ See the Mulan PSL v2 for more details. */
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "errors.h"
 #include "sm_defs.h"
 #include "common/common.h"
+#include "storage/page.h"
 
 /* 字段元数据 */
 struct ColMeta {
@@ -28,15 +30,24 @@ struct ColMeta {
     int len;                // 字段长度
     int offset;             // 字段位于记录中的偏移量
     bool index;             /** unused */
+    bool is_varchar = false;  // 是否为VARCHAR字段，类型与CHAR相同，只在DESC中区分
 
     friend std::ostream &operator<<(std::ostream &os, const ColMeta &col) {
         // ColMeta中有各个基本类型的变量，然后调用重载的这些变量的操作符<<（具体实现逻辑在defs.h）
         return os << col.tab_name << ' ' << col.name << ' ' << col.type << ' ' << col.len << ' ' << col.offset << ' '
-                  << col.index;
+                  << col.index << ' ' << col.is_varchar;
     }
 
     friend std::istream &operator>>(std::istream &is, ColMeta &col) {
-        return is >> col.tab_name >> col.name >> col.type >> col.len >> col.offset >> col.index;
+        is >> col.tab_name >> col.name >> col.type >> col.len >> col.offset >> col.index;
+        // 每个字段占一行，is_varchar写在行末，旧版本的db.meta没有这一项，按CHAR字段读取
+        std::string rest;
+        std::getline(is, rest);
+        std::istringstream rest_is(rest);
+        if (!(rest_is >> col.is_varchar)) {
+            col.is_varchar = false;
+        }
+        return is;
     }
 };
 
@@ -231,9 +242,20 @@ class DbMeta {
    private:
     std::string name_;                      // 数据库名称
     std::map<std::string, TabMeta> tabs_;   // 数据库中包含的表
+    int page_size_ = DEFAULT_PAGE_SIZE;     // 数据库的页面大小，所有表文件和索引文件都使用这一页面大小
+    std::map<std::string, BufferPolicy> buffer_policies_;  // 表文件或索引文件名 -> 非默认的缓冲池策略
+    bool tablespace_ = false;               // 表文件和索引文件是否存放在表空间的段文件中，创建数据库时确定
+    bool direct_io_ = false;                // 表文件和索引文件是否使用O_DIRECT读写，创建数据库时确定
 
    public:
-    DbMeta(std::string name = "") : name_(name) {}
+    DbMeta(std::string name = "", int page_size = DEFAULT_PAGE_SIZE, bool tablespace = false, bool direct_io = false)
+        : name_(name), page_size_(page_size), tablespace_(tablespace), direct_io_(direct_io) {}
+
+    int get_page_size() const { return page_size_; }
+
+    bool is_tablespace() const { return tablespace_; }
+
+    bool is_direct_io() const { return direct_io_; }
 
     /* 判断数据库中是否存在指定名称的表 */
     bool is_table(const std::string &tab_name) const { return tabs_.find(tab_name) != tabs_.end(); }
@@ -258,6 +280,14 @@ class DbMeta {
         for (auto &entry : db_meta.tabs_) {
             os << entry.second << '\n';
         }
+        // 页面大小、缓冲池策略和存储模式写在最后，使旧版本的db.meta（没有这些项）按DEFAULT_PAGE_SIZE、默认策略
+        // 、独立文件模式和普通I/O打开
+        os << db_meta.page_size_ << '\n';
+        os << db_meta.buffer_policies_.size() << '\n';
+        for (auto &[file_name, policy] : db_meta.buffer_policies_) {
+            os << file_name << ' ' << static_cast<int>(policy.priority) << ' ' << policy.max_buffer_pct << '\n';
+        }
+        os << db_meta.tablespace_ << ' ' << db_meta.direct_io_ << '\n';
         return os;
     }
 
@@ -269,6 +299,28 @@ class DbMeta {
             is >> tab;
             db_meta.tabs_[tab.name] = tab;
         }
+        if (!(is >> db_meta.page_size_)) {
+            db_meta.page_size_ = DEFAULT_PAGE_SIZE;
+            return is;
+        }
+        // 缓冲池策略同样可以缺省
+        if (is >> n) {
+            for (size_t i = 0; i < n; i++) {
+                std::string file_name;
+                int priority;
+                BufferPolicy policy;
+                is >> file_name >> priority >> policy.max_buffer_pct;
+                policy.priority = static_cast<BufferPriority>(priority);
+                db_meta.buffer_policies_[file_name] = policy;
+            }
+        }
+        // 存储模式同样可以缺省
+        if (!(is >> db_meta.tablespace_)) {
+            db_meta.tablespace_ = false;
+        }
+        if (!(is >> db_meta.direct_io_)) {
+            db_meta.direct_io_ = false;
+        }
         return is;
     }
 };
@@ -19,22 +19,29 @@ See the Mulan PSL v2 for more details. */
 
 #include <algorithm>
 #include <cassert>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <set>
+#include <sstream>
 #include <string>
 #include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
 #include "storage/disk_manager.h"
+#include "system/sm_meta.h"
 
 const std::string TEST_DB_NAME = "BufferPoolManagerTest_db";  // 以数据库名作为根目录
 const std::string TEST_FILE_NAME = "basic";                   // 测试文件的名字
@@ -53,7 +60,7 @@ std::unordered_map<int, char *> mock;  // fd -> buffer
 char *mock_get_page(int fd, int page_no) { return &mock[fd][page_no * PAGE_SIZE]; }
 
 void check_disk(int fd, int page_no) {
-    char buf[PAGE_SIZE];
+    char buf[MAX_PAGE_SIZE];
     disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
     char *mock_buf = mock_get_page(fd, page_no);
     assert(memcmp(buf, mock_buf, PAGE_SIZE) == 0);
@@ -231,6 +238,105 @@ TEST(LRUReplacerTest, SampleTest) {
     EXPECT_EQ(4, value);
 }
 
+TEST(ClockReplacerTest, SampleTest) {
+    // 管理的帧为[10, 17)
+    ClockReplacer clock_replacer(7, 10);
+
+    // Scenario: unpin six frames, their reference bits are set.
+    for (frame_id_t frame_id = 10; frame_id < 16; frame_id++) {
+        clock_replacer.unpin(frame_id);
+    }
+    EXPECT_EQ(6, clock_replacer.Size());
+
+    // Scenario: the hand clears the reference bits and usage counts, then evicts in clock order.
+    frame_id_t value;
+    ASSERT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(10, value);
+    ASSERT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(11, value);
+    ASSERT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(12, value);
+
+    // Scenario: a pinned frame is skipped, a referenced frame gets another chance.
+    clock_replacer.pin(14);
+    EXPECT_EQ(2, clock_replacer.Size());
+    clock_replacer.unpin(13);
+    ASSERT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(15, value);
+    ASSERT_TRUE(clock_replacer.victim(&value));
+    EXPECT_EQ(13, value);
+    EXPECT_FALSE(clock_replacer.victim(&value));
+    EXPECT_EQ(0, clock_replacer.Size());
+}
+
+TEST(ReplacerTest, UnpinColdTest) {
+    // 三种置换策略都先淘汰以unpin_cold加入的帧
+    std::vector<std::unique_ptr<Replacer>> replacers;
+    replacers.push_back(std::make_unique<LRUReplacer>(8));
+    replacers.push_back(std::make_unique<ClockReplacer>(8));
+    replacers.push_back(std::make_unique<LRUKReplacer>(8, 0, 2, 1));
+    for (auto &replacer : replacers) {
+        for (frame_id_t frame_id : {0, 1, 2}) {
+            replacer->pin(frame_id);
+            replacer->unpin(frame_id);
+        }
+        replacer->pin(3);
+        replacer->unpin_cold(3);
+        replacer->pin(4);
+        replacer->unpin(4);
+        EXPECT_EQ(5, replacer->Size());
+        frame_id_t value;
+        ASSERT_TRUE(replacer->victim(&value));
+        EXPECT_EQ(3, value);
+    }
+}
+
+TEST(LRUKReplacerTest, SampleTest) {
+    // K = 2，相关访问期为1次访问
+    LRUKReplacer lru_k_replacer(8, 0, 2, 1);
+    auto access = [&](frame_id_t frame_id) {
+        lru_k_replacer.pin(frame_id);
+        lru_k_replacer.unpin(frame_id);
+    };
+
+    // Scenario: frames 0 and 1 are referenced twice, frames 5, 2, 3 and 4 once (like a scan).
+    // The back-to-back references to frame 3 are correlated and count as a single reference.
+    for (frame_id_t frame_id : {0, 1, 5, 2, 3, 3, 4, 0, 1}) {
+        access(frame_id);
+    }
+    EXPECT_EQ(6, lru_k_replacer.Size());
+
+    // Scenario: frames with fewer than K references are evicted first, earliest reference first.
+    frame_id_t value;
+    ASSERT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(5, value);
+    ASSERT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(2, value);
+    ASSERT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(3, value);
+    ASSERT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(4, value);
+
+    // Scenario: among frames with K references, the one with the earliest K-th most recent reference goes first.
+    lru_k_replacer.pin(1);
+    EXPECT_EQ(1, lru_k_replacer.Size());
+    ASSERT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(0, value);
+    EXPECT_FALSE(lru_k_replacer.victim(&value));
+
+    // Scenario: a removed frame loses its history.
+    lru_k_replacer.unpin(1);
+    lru_k_replacer.remove(1);
+    EXPECT_EQ(0, lru_k_replacer.Size());
+    access(1);
+    access(6);
+    access(6);
+    access(7);
+    access(6);
+    ASSERT_TRUE(lru_k_replacer.victim(&value));
+    EXPECT_EQ(1, value);
+}
+
 /** 注意：每个测试点只测试了单个文件！
  * 对于每个测试点，先创建和进入目录TEST_DB_NAME
  * 然后在此目录下创建和打开文件TEST_FILE_NAME，记录其文件描述符fd */
@@ -328,6 +434,476 @@ TEST_F(BufferPoolManagerTest, SampleTest) {
     bpm->flush_all_pages(fd);
 }
 
+TEST_F(BufferPoolManagerTest, FlushCoalesceTest) {
+    constexpr int num_pages = 40;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), i, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+
+    // 页号连续的脏页合并为一次写
+    FlushStats stats = bpm->flush_all_page();
+    EXPECT_EQ(stats.pages, num_pages);
+    EXPECT_EQ(stats.bytes, num_pages * PAGE_SIZE);
+    EXPECT_EQ(stats.syscalls, 1);
+
+    // 不相邻的脏页各自写回，干净页不写
+    for (int page_no : {20, 5}) {
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        memset(page->get_data(), page_no + 100, PAGE_SIZE);
+        bpm->unpin_page(PageId{fd, page_no}, true);
+    }
+    stats = bpm->flush_all_page();
+    EXPECT_EQ(stats.pages, 2);
+    EXPECT_EQ(stats.syscalls, 2);
+    EXPECT_EQ(bpm->flush_all_page().pages, 0);
+
+    char buf[MAX_PAGE_SIZE];
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+        char expected = (page_no == 5 || page_no == 20) ? page_no + 100 : page_no;
+        EXPECT_EQ(buf[0], expected);
+        EXPECT_EQ(buf[PAGE_SIZE - 1], expected);
+    }
+}
+
+TEST_F(BufferPoolManagerTest, PageSizeTest) {
+    constexpr int page_size = 16384;
+    constexpr int num_pages = 3;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(8, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    bpm->set_page_size(page_size);
+    EXPECT_EQ(PAGE_SIZE, page_size);
+
+    // 帧按新的页面大小分配，页面按新的页面大小写入文件
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(page->get_data()) % page_size, 0);
+        memset(page->get_data(), i + 1, page_size);
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->flush_all_pages(fd);
+    std::vector<char> buf(page_size);
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        pread(fd, buf.data(), page_size, static_cast<off_t>(page_no) * page_size);
+        EXPECT_EQ(std::count(buf.begin(), buf.end(), page_no + 1), page_size);
+    }
+
+    // 缓冲池中还有页面时不能切换页面大小
+    EXPECT_THROW(bpm->set_page_size(DEFAULT_PAGE_SIZE), InternalError);
+    bpm->delete_all_page(fd);
+    bpm->set_page_size(DEFAULT_PAGE_SIZE);
+    EXPECT_EQ(PAGE_SIZE, DEFAULT_PAGE_SIZE);
+
+    // 页面大小保存在db.meta的最后，旧版本的db.meta按DEFAULT_PAGE_SIZE打开
+    std::stringstream ss;
+    ss << DbMeta("db", page_size);
+    DbMeta db_meta;
+    ss >> db_meta;
+    EXPECT_EQ(db_meta.get_page_size(), page_size);
+    std::stringstream old_ss("db\n0\n");
+    DbMeta old_db_meta;
+    old_ss >> old_db_meta;
+    EXPECT_EQ(old_db_meta.get_page_size(), DEFAULT_PAGE_SIZE);
+}
+
+TEST_F(BufferPoolManagerTest, DeletePageTest) {
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(2, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    ASSERT_NE(nullptr, bpm->new_page(&page_id));
+    EXPECT_TRUE(bpm->unpin_page(page_id, false));
+    EXPECT_TRUE(bpm->delete_page(page_id));
+
+    // 被删除页面的帧回到free_list后不能再被replacer淘汰，两个帧都被固定时无法再获得新页面
+    ASSERT_NE(nullptr, bpm->new_page(&page_id));
+    ASSERT_NE(nullptr, bpm->new_page(&page_id));
+    EXPECT_EQ(nullptr, bpm->new_page(&page_id));
+}
+
+TEST_F(BufferPoolManagerTest, FileFramesTest) {
+    constexpr int num_pages = 48;
+    const std::string other_file = "file_frames_test.db";
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    if (disk_manager->is_file(other_file)) {
+        disk_manager->destroy_file(other_file);
+    }
+    disk_manager->create_file(other_file);
+    int fds[2] = {BufferPoolManagerTest::fd_, disk_manager->open_file(other_file)};
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager);
+
+    // 两个文件的页面交替写入，缓冲池放不下全部页面，淘汰时帧在两个文件的链表之间移动
+    for (int i = 0; i < num_pages; i++) {
+        for (int fd : fds) {
+            PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(page_id.page_no, i);
+            snprintf(page->get_data(), PAGE_SIZE, "%d:%d", fd, i);
+            bpm->unpin_page(page, true);
+        }
+    }
+
+    // 按文件写回只写回该文件驻留在缓冲池中的页面，两个文件的驻留页面数之和等于帧数
+    size_t resident[2] = {bpm->flush_all_pages(fds[0]).pages, bpm->flush_all_pages(fds[1]).pages};
+    EXPECT_EQ(resident[0] + resident[1], 64);
+
+    // 删除一个文件的页面不影响另一个文件，其页面全部被固定时不能删除
+    Page *pinned = bpm->fetch_page(PageId{fds[1], num_pages - 1});
+    ASSERT_NE(nullptr, pinned);
+    EXPECT_FALSE(bpm->delete_all_page(fds[1]));
+    EXPECT_TRUE(bpm->delete_all_page(fds[0]));
+    EXPECT_EQ(bpm->flush_all_pages(fds[0]).pages, 0);
+    EXPECT_EQ(bpm->flush_all_pages(fds[1]).pages, resident[1]);
+    bpm->unpin_page(pinned, false);
+
+    // 空出的帧被另一个文件的页面占用后，两个文件的页面仍可正确读取
+    for (int i = 0; i < num_pages; i++) {
+        for (int fd : fds) {
+            Page *page = bpm->fetch_page(PageId{fd, i});
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::to_string(fd) + ":" + std::to_string(i), page->get_data());
+            bpm->unpin_page(page, false);
+        }
+    }
+    EXPECT_TRUE(bpm->delete_all_page(fds[1]));
+    EXPECT_TRUE(bpm->delete_all_page(fds[0]));
+    EXPECT_EQ(bpm->flush_all_page().pages, 0);
+    disk_manager->close_file(fds[1]);
+    disk_manager->destroy_file(other_file);
+}
+
+TEST_F(BufferPoolManagerTest, BufferPolicyTest) {
+    constexpr int num_hot_pages = 4;
+    constexpr int num_cold_pages = 200;
+    const std::string cold_file = "buffer_policy_test.db";
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    if (disk_manager->is_file(cold_file)) {
+        disk_manager->destroy_file(cold_file);
+    }
+    disk_manager->create_file(cold_file);
+    int hot_fd = BufferPoolManagerTest::fd_;
+    int cold_fd = disk_manager->open_file(cold_file);
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager, 1);
+
+    // 热点文件的页面设为pinned，冷文件最多占用10%的帧
+    bpm->set_file_policy(hot_fd, {.priority = BufferPriority::PINNED});
+    bpm->set_file_policy(cold_fd, {.max_buffer_pct = 10});
+    for (int i = 0; i < num_hot_pages; i++) {
+        PageId page_id = {.fd = hot_fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "hot %d", i);
+        bpm->unpin_page(page, true);
+    }
+    for (int i = 0; i < num_cold_pages; i++) {
+        PageId page_id = {.fd = cold_fd, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "cold %d", i);
+        bpm->unpin_page(page, true);
+    }
+    EXPECT_EQ(bpm->get_resident_pages(hot_fd), num_hot_pages);
+    EXPECT_EQ(bpm->get_resident_pages(cold_fd), 64 * 10 / 100);
+
+    // 取消配额后冷文件占满其余的帧，pinned的页面仍不被淘汰，访问时不读磁盘
+    bpm->set_file_policy(cold_fd, BufferPolicy());
+    for (int i = 0; i < num_cold_pages; i++) {
+        Page *page = bpm->fetch_page(PageId{cold_fd, i});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ("cold " + std::to_string(i), page->get_data());
+        bpm->unpin_page(page, false);
+    }
+    EXPECT_EQ(bpm->get_resident_pages(cold_fd), 64 - num_hot_pages);
+    size_t num_reads = disk_manager->get_num_reads(hot_fd);
+    for (int i = 0; i < num_hot_pages; i++) {
+        Page *page = bpm->fetch_page(PageId{hot_fd, i});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ("hot " + std::to_string(i), page->get_data());
+        bpm->unpin_page(page, false);
+    }
+    EXPECT_EQ(disk_manager->get_num_reads(hot_fd), num_reads);
+
+    // 改为low后热点页面作为最冷的帧交给replacer，再扫描一遍冷文件即被全部淘汰
+    bpm->set_file_policy(hot_fd, {.priority = BufferPriority::LOW});
+    for (int i = 0; i < num_cold_pages; i++) {
+        Page *page = bpm->fetch_page(PageId{cold_fd, i});
+        ASSERT_NE(nullptr, page);
+        bpm->unpin_page(page, false);
+    }
+    EXPECT_EQ(bpm->get_resident_pages(hot_fd), 0);
+    EXPECT_EQ(bpm->get_resident_pages(cold_fd), 64);
+    bpm->set_file_policy(hot_fd, BufferPolicy());
+
+    EXPECT_TRUE(bpm->delete_all_page(cold_fd));
+    EXPECT_TRUE(bpm->delete_all_page(hot_fd));
+    disk_manager->close_file(cold_fd);
+    disk_manager->destroy_file(cold_file);
+}
+
+TEST_F(BufferPoolManagerTest, ResizeTest) {
+    constexpr int num_pages = 96;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager, 4);
+    int fd = BufferPoolManagerTest::fd_;
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "%d", i);
+        bpm->unpin_page(page, true);
+    }
+    auto check_pages = [&]() {
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            Page *page = bpm->fetch_page(PageId{fd, page_no});
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::to_string(page_no), page->get_data());
+            bpm->unpin_page(page, false);
+        }
+    };
+
+    // 有页面被固定时不能调整大小
+    Page *pinned = bpm->fetch_page(PageId{fd, num_pages - 1});
+    ASSERT_NE(nullptr, pinned);
+    EXPECT_THROW(bpm->resize(32, std::chrono::milliseconds(10)), BufferPoolBusyError);
+    EXPECT_EQ(bpm->get_pool_size(), 64);
+    bpm->unpin_page(pinned, false);
+    EXPECT_THROW(bpm->resize(2), InternalError);
+
+    // 缩小时被淘汰的脏页写回磁盘，保留的页面仍在缓冲池中且数据不变
+    bpm->resize(32);
+    EXPECT_EQ(bpm->get_pool_size(), 32);
+    EXPECT_EQ(bpm->flush_all_pages(fd).pages, 32);
+    check_pages();
+
+    // 增大时保留已有的页面，再次访问不需要读盘，新增的帧可以容纳全部页面
+    size_t resident = bpm->flush_all_pages(fd).pages;
+    bpm->resize(128);
+    EXPECT_EQ(bpm->get_pool_size(), 128);
+    EXPECT_EQ(bpm->flush_all_pages(fd).pages, resident);
+    check_pages();
+    size_t num_reads = disk_manager->get_num_reads(fd);
+    check_pages();
+    EXPECT_EQ(disk_manager->get_num_reads(fd), num_reads);
+    EXPECT_TRUE(bpm->delete_all_page(fd));
+}
+
+TEST_F(BufferPoolManagerTest, AccessStrategyTest) {
+    constexpr int num_hot_pages = 32;
+    constexpr int num_bulk_pages = 100;
+    constexpr int ring_size = 8;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_hot_pages; i++) {
+        ASSERT_NE(nullptr, bpm->new_page(&page_id));
+        bpm->unpin_page(page_id, true);
+    }
+
+    // 批量写入和顺序读取的页面只在环中的ring_size个帧之间复用，脏页在复用时写回
+    BufferAccessStrategy strategy(ring_size * PAGE_SIZE);
+    EXPECT_EQ(strategy.get_ring_size(), ring_size);
+    for (int i = 0; i < num_bulk_pages; i++) {
+        Page *page = bpm->new_page(&page_id, &strategy);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), i + 1, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+    for (int i = 0; i < num_bulk_pages; i++) {
+        Page *page = bpm->fetch_page(PageId{fd, num_hot_pages + i}, &strategy);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(page->get_data()[0], static_cast<char>(i + 1));
+        EXPECT_EQ(page->get_data()[PAGE_SIZE - 1], static_cast<char>(i + 1));
+        bpm->unpin_page(PageId{fd, num_hot_pages + i}, false);
+    }
+
+    // 热点页面都还在缓冲池中
+    size_t num_reads = disk_manager->get_num_reads(fd);
+    for (int page_no = 0; page_no < num_hot_pages; page_no++) {
+        ASSERT_NE(nullptr, bpm->fetch_page(PageId{fd, page_no}));
+        bpm->unpin_page(PageId{fd, page_no}, false);
+    }
+    EXPECT_EQ(disk_manager->get_num_reads(fd), num_reads);
+    EXPECT_EQ(bpm->flush_all_pages(fd).pages, num_hot_pages + ring_size);
+}
+
+TEST_F(BufferPoolManagerTest, BackgroundWriterTest) {
+    constexpr int pool_size = 64;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager, 1);
+    int fd = BufferPoolManagerTest::fd_;
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    // 页号越大的页面LSN越小，后台写回应优先写回页号大的页面
+    for (int i = 0; i < pool_size; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        page->set_page_lsn(pool_size - i);
+        bpm->unpin_page(page_id, true);
+    }
+
+    // 干净帧低于一半时开始写回，直到干净帧达到3/4，每轮最多写回32个页面
+    bpm->set_bgwriter_low_watermark(50);
+    bpm->set_bgwriter_high_watermark(75);
+    bpm->set_bgwriter_max_pages(32);
+    size_t num_writes = disk_manager->get_num_writes(fd);
+    // 先写日志：每批页面写回之前，日志先刷新到这批页面中最大的lsn
+    lsn_t flushed_lsn = INVALID_LSN;
+    size_t writes_at_flush = 0;
+    bpm->set_log_flusher([&](lsn_t lsn) {
+        flushed_lsn = lsn;
+        writes_at_flush = disk_manager->get_num_writes(fd);
+    });
+    EXPECT_EQ(bpm->bg_write_round(), 32);
+    EXPECT_EQ(flushed_lsn, 32);
+    EXPECT_EQ(writes_at_flush, num_writes);
+    EXPECT_EQ(bpm->bg_write_round(), 16);
+    EXPECT_EQ(flushed_lsn, 48);
+    bpm->set_log_flusher(nullptr);
+    EXPECT_EQ(bpm->bg_write_round(), 0);
+    EXPECT_EQ(bpm->get_bgwriter_pages_written(), 48);
+    EXPECT_GT(disk_manager->get_num_writes(fd), num_writes);
+    for (int page_no = 0; page_no < pool_size; page_no++) {
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(page->is_dirty(), page_no < pool_size / 4);
+        bpm->unpin_page(PageId{fd, page_no}, false);
+    }
+
+    // 后台线程被淘汰脏页的前台线程唤醒，写回剩余的脏页
+    bpm->set_bgwriter_low_watermark(100);
+    bpm->set_bgwriter_high_watermark(100);
+    bpm->set_bgwriter_delay(10000);
+    bpm->start_bg_writer();
+    for (int i = 0; i < 100 && bpm->get_bgwriter_pages_written() < pool_size; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ASSERT_NE(nullptr, bpm->new_page(&page_id));
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->stop_bg_writer();
+    EXPECT_GE(bpm->get_bgwriter_pages_written(), pool_size);
+    EXPECT_TRUE(bpm->delete_all_page(fd));
+}
+
+TEST_F(BufferPoolManagerTest, ReadAheadTest) {
+    constexpr int num_pages = 40;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), i + 1, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->flush_all_pages(fd);
+    ASSERT_TRUE(bpm->delete_all_page(fd));
+
+    // 顺序扫描时合并预读之后的页面，读请求数远少于页面数
+    size_t num_reads = disk_manager->get_num_reads(fd);
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        bpm->read_ahead(fd, page_no);
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(page->get_data()[PAGE_SIZE - 1], static_cast<char>(page_no + 1));
+        bpm->unpin_page(PageId{fd, page_no}, false);
+    }
+    EXPECT_EQ(bpm->get_prefetched_pages(), num_pages - 2);
+    EXPECT_LT(disk_manager->get_num_reads(fd) - num_reads, num_pages / 4);
+    ASSERT_TRUE(bpm->delete_all_page(fd));
+
+    // 超出文件末尾的页面和已在缓冲池中的页面不预读
+    ASSERT_NE(nullptr, bpm->fetch_page(PageId{fd, 0}));
+    EXPECT_EQ(bpm->prefetch_pages(fd, {0, 1, num_pages - 1, num_pages, num_pages + 1}), 2);
+    bpm->unpin_page(PageId{fd, 0}, false);
+    EXPECT_TRUE(bpm->delete_all_page(fd));
+
+    // 随机访问不触发预读
+    bpm->read_ahead(fd, 10);
+    bpm->read_ahead(fd, 5);
+    bpm->read_ahead(fd, 20);
+    EXPECT_EQ(bpm->get_prefetched_pages(), num_pages);
+}
+
+TEST_F(BufferPoolManagerTest, WarmupTest) {
+    constexpr int num_pages = 40;
+    constexpr int num_resident = 10;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), i + 1, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->flush_all_pages(fd);
+    for (int page_no = num_resident; page_no < num_pages; page_no++) {
+        ASSERT_TRUE(bpm->delete_page(PageId{fd, page_no}));
+    }
+
+    // 转储驻留页面列表，未打开的文件和超出文件末尾的页面在预热时被忽略
+    char cwd[PATH_MAX];
+    ASSERT_NE(nullptr, getcwd(cwd, sizeof(cwd)));
+    std::string dump_path = std::string(cwd) + "/" + BUFFER_POOL_DUMP_NAME;
+    bpm->set_warmup_dump_path(dump_path);
+    EXPECT_EQ(bpm->dump_resident_pages(), num_resident);
+    std::ofstream(dump_path, std::ios::app) << "no_such_file 1\n" << TEST_FILE_NAME << " " << num_pages << "\n";
+    bpm.reset();
+
+    // 新的缓冲池预热之后，访问转储的页面不再读磁盘
+    bpm = std::make_unique<BufferPoolManager>(64, disk_manager);
+    bpm->set_warmup_dump_path(dump_path);
+    bpm->start_warmup();
+    while (bpm->get_warmup_stats().active) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto stats = bpm->get_warmup_stats();
+    EXPECT_EQ(stats.total, num_resident);
+    EXPECT_EQ(stats.processed, num_resident);
+    EXPECT_EQ(stats.loaded, num_resident);
+    size_t num_reads = disk_manager->get_num_reads(fd);
+    for (int page_no = 0; page_no < num_resident; page_no++) {
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(page->get_data()[PAGE_SIZE - 1], static_cast<char>(page_no + 1));
+        bpm->unpin_page(page, false);
+    }
+    EXPECT_EQ(disk_manager->get_num_reads(fd), num_reads);
+    bpm->stop_warmup();
+
+    // 预热只使用空闲帧：缓冲池中已驻留其他页面时只读入空闲帧能容纳的页面，已驻留的页面不被淘汰
+    constexpr int pool_size = 16;
+    bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager);
+    for (int page_no = num_pages - num_resident; page_no < num_pages; page_no++) {
+        bpm->unpin_page(bpm->fetch_page(PageId{fd, page_no}), false);
+    }
+    bpm->set_warmup_dump_path(dump_path);
+    bpm->start_warmup();
+    while (bpm->get_warmup_stats().active) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stats = bpm->get_warmup_stats();
+    EXPECT_EQ(stats.loaded, pool_size - num_resident);
+    num_reads = disk_manager->get_num_reads(fd);
+    for (int page_no = num_pages - num_resident; page_no < num_pages; page_no++) {
+        bpm->unpin_page(bpm->fetch_page(PageId{fd, page_no}), false);
+    }
+    EXPECT_EQ(disk_manager->get_num_reads(fd), num_reads);
+}
+
 /** 注意：每个测试点只测试了单个文件！
  * 对于每个测试点，先创建和进入目录TEST_DB_NAME
  * 然后在此目录下创建和打开文件TEST_FILE_NAME_CCUR，记录其文件描述符fd */
@@ -425,6 +1001,601 @@ TEST_F(BufferPoolManagerConcurrencyTest, ConcurrencyTest) {
     }  // end loop run=[0,num_runs)
 }
 
+TEST_F(BufferPoolManagerConcurrencyTest, MissPathTest) {
+    constexpr int num_pages = 64;
+    constexpr int num_threads = 8;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager);
+
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 0, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+
+    // 缓冲池远小于页面数，几乎每次访问都要写回脏的victim并读入目标页，多个线程可能同时访问同一个正在读入的页面
+    std::vector<int> num_hits(num_threads, 0);
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, &num_hits, fd, tid]() {
+            std::mt19937 rng(tid);
+            for (int i = 0; i < 500; i++) {
+                int page_no = rng() % num_pages;
+                Page *page = bpm->fetch_page(PageId{fd, page_no});
+                if (page == nullptr) {
+                    continue;  // 所有帧都被其他线程固定
+                }
+                page->WLock();
+                int *counter = reinterpret_cast<int *>(page->get_data() + tid * sizeof(int));
+                *counter += 1;
+                page->WUnLock();
+                num_hits[tid]++;
+                if (i % 50 == 0) {
+                    page->RLock();
+                    EXPECT_TRUE(bpm->flush_page(PageId{fd, page_no}));
+                    page->RUnLock();
+                }
+                EXPECT_TRUE(bpm->unpin_page(PageId{fd, page_no}, true));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // 每个线程的计数之和等于其成功访问的次数，即缺页读入不会读到写回之前的旧数据
+    bpm->flush_all_page();
+    std::vector<int> totals(num_threads, 0);
+    char buf[MAX_PAGE_SIZE];
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+        for (int tid = 0; tid < num_threads; tid++) {
+            totals[tid] += reinterpret_cast<int *>(buf)[tid];
+        }
+    }
+    EXPECT_EQ(totals, num_hits);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, FlushAllTest) {
+    constexpr int num_pages = 32;
+    constexpr int num_threads = 4;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager);
+
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 0, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+
+    // 刷新在latch之外写回标记的帧，其他线程同时修改这些页面，写回期间的修改在取消固定时重新标记为脏页
+    std::atomic<bool> done{false};
+    std::thread flusher([&bpm, &done, fd]() {
+        for (int i = 0; !done; i++) {
+            if (i % 2 == 0) {
+                bpm->flush_all_page();
+            } else {
+                bpm->flush_all_pages(fd);
+            }
+        }
+    });
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, fd, tid]() {
+            std::mt19937 rng(tid);
+            for (int i = 0; i < 2000; i++) {
+                int page_no = rng() % num_pages;
+                Page *page = bpm->fetch_page(PageId{fd, page_no});
+                ASSERT_NE(nullptr, page);
+                page->WLock();
+                reinterpret_cast<int *>(page->get_data())[tid] += 1;
+                page->WUnLock();
+                EXPECT_TRUE(bpm->unpin_page(PageId{fd, page_no}, true));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    done = true;
+    flusher.join();
+
+    // 刷新结束后没有帧仍在写回，最后一次刷新写回全部修改
+    bpm->flush_all_page();
+    EXPECT_TRUE(bpm->delete_all_page(fd));
+    std::vector<int> totals(num_threads, 0);
+    char buf[MAX_PAGE_SIZE];
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+        for (int tid = 0; tid < num_threads; tid++) {
+            totals[tid] += reinterpret_cast<int *>(buf)[tid];
+        }
+    }
+    EXPECT_EQ(totals, std::vector<int>(num_threads, 2000));
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, FlushBarrierTest) {
+    constexpr int num_pages = 8;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager);
+
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        memset(page->get_data(), 0, PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+
+    // 另一个线程不断刷新时，flush_all_pages/flush_all_page返回前会等待已经开始的写回，调用前的修改一定已在磁盘上
+    std::atomic<bool> done{false};
+    std::thread flusher([&bpm, &done]() {
+        while (!done) {
+            bpm->flush_all_page();
+        }
+    });
+    char buf[MAX_PAGE_SIZE];
+    for (int i = 1; i <= 2000; i++) {
+        int page_no = i % num_pages;
+        Page *page = bpm->fetch_page(PageId{fd, page_no});
+        ASSERT_NE(nullptr, page);
+        page->WLock();
+        reinterpret_cast<int *>(page->get_data())[0] = i;
+        page->WUnLock();
+        bpm->unpin_page(PageId{fd, page_no}, true);
+        if (i % 2 == 0) {
+            bpm->flush_all_pages(fd);
+        } else {
+            bpm->flush_all_page();
+        }
+        disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+        ASSERT_EQ(reinterpret_cast<int *>(buf)[0], i);
+    }
+    done = true;
+    flusher.join();
+    EXPECT_TRUE(bpm->delete_all_page(fd));
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, ShardTest) {
+    constexpr int num_shards = 4;
+    constexpr int num_pages = 64;
+    constexpr int num_threads = 8;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(num_shards * num_pages, disk_manager, num_shards);
+    EXPECT_EQ(bpm->get_num_shards(), num_shards);
+
+    // 小缓冲池默认只有一个分片
+    EXPECT_EQ(BufferPoolManager(10, disk_manager).get_num_shards(), 1);
+
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(page_id.page_no, i);
+        snprintf(page->get_data(), PAGE_SIZE, "%d", i);
+        bpm->unpin_page(page_id, true);
+    }
+
+    // 各线程并发地读取分布在不同分片中的页面
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, fd, tid]() {
+            std::mt19937 rng(tid);
+            for (int i = 0; i < 2000; i++) {
+                int page_no = rng() % num_pages;
+                Page *page = bpm->fetch_page(PageId{fd, page_no});
+                ASSERT_NE(nullptr, page);
+                EXPECT_EQ(std::to_string(page_no), page->get_data());
+                EXPECT_TRUE(bpm->unpin_page(PageId{fd, page_no}, false));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // 跨分片的写回和删除覆盖所有页面
+    EXPECT_EQ(bpm->flush_all_page().pages, num_pages);
+    EXPECT_EQ(bpm->flush_all_pages(fd).pages, num_pages);
+    EXPECT_TRUE(bpm->delete_all_page(fd));
+    EXPECT_EQ(bpm->flush_all_pages(fd).pages, 0);
+    char buf[MAX_PAGE_SIZE];
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+        EXPECT_EQ(std::to_string(page_no), buf);
+    }
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, LatchFreeUnpinTest) {
+    constexpr int num_frames = 32;
+    constexpr int num_hot_pages = 8;
+    constexpr int num_pages = 128;
+    constexpr int num_threads = 8;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(num_frames, disk_manager);
+
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "%d", i);
+        EXPECT_TRUE(bpm->unpin_page(page, true));
+        // pin_count_已经为0时不再减少
+        EXPECT_FALSE(bpm->unpin_page(page, false));
+    }
+
+    // 一半线程反复访问少数热点页面（命中路径），另一半线程访问其余页面，不断淘汰未固定的帧，
+    // 取消固定不持有latch，被淘汰的帧不能是仍被固定的帧
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, fd, tid]() {
+            std::mt19937 rng(tid);
+            for (int i = 0; i < 2000; i++) {
+                int page_no = tid % 2 == 0 ? static_cast<int>(rng() % num_hot_pages)
+                                           : num_hot_pages + static_cast<int>(rng() % (num_pages - num_hot_pages));
+                Page *page = bpm->fetch_page(PageId{fd, page_no});
+                if (page == nullptr) {
+                    continue;  // 所有帧都被其他线程固定
+                }
+                EXPECT_EQ(page->get_page_id().page_no, page_no);
+                EXPECT_EQ(std::to_string(page_no), page->get_data());
+                EXPECT_TRUE(bpm->unpin_page(page, false));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // 所有固定都已释放，全部页面都可以删除
+    EXPECT_TRUE(bpm->delete_all_page(fd));
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, ResizeTest) {
+    constexpr int num_pages = 256;
+    constexpr int num_threads = 4;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager, 4);
+
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "%d", i);
+        bpm->unpin_page(page, true);
+    }
+
+    // 各线程持续读写页面，同时反复增大和缩小缓冲池，调整只在所有页面都取消固定的间隙中进行
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, &stop, fd, tid]() {
+            std::mt19937 rng(tid);
+            while (!stop) {
+                int page_no = rng() % num_pages;
+                Page *page = bpm->fetch_page(PageId{fd, page_no});
+                if (page == nullptr) {
+                    continue;
+                }
+                EXPECT_EQ(std::to_string(page_no), page->get_data());
+                EXPECT_TRUE(bpm->unpin_page(page, rng() % 2 == 0));
+            }
+        });
+    }
+    for (size_t pool_size : {128, 32, 256, 16, 64}) {
+        bpm->resize(pool_size);
+        EXPECT_EQ(bpm->get_pool_size(), pool_size);
+    }
+    stop = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_TRUE(bpm->delete_all_page(fd));
+    char buf[MAX_PAGE_SIZE];
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+        EXPECT_EQ(std::to_string(page_no), buf);
+    }
+}
+
+TEST(DiskManagerTest, PositionalIOTest) {
+    const std::string filename = "positional_io.txt";
+    constexpr int num_threads = 8;
+    constexpr int pages_per_thread = 16;
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    disk_manager->create_file(filename);
+    int fd = disk_manager->open_file(filename);
+
+    // 多个线程共享同一个fd，各自写入并读回互不重叠的页面
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([fd, tid]() {
+            char write_buf[MAX_PAGE_SIZE];
+            char read_buf[MAX_PAGE_SIZE];
+            for (int i = 0; i < pages_per_thread; i++) {
+                int page_no = i * num_threads + tid;
+                memset(write_buf, page_no & 0xff, PAGE_SIZE);
+                disk_manager->write_page(fd, page_no, write_buf, PAGE_SIZE);
+                disk_manager->read_page(fd, page_no, read_buf, PAGE_SIZE);
+                EXPECT_EQ(memcmp(write_buf, read_buf, PAGE_SIZE), 0);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // 用一次preadv读回连续的多个页面
+    constexpr int num_pages = num_threads * pages_per_thread;
+    std::vector<char> bufs(num_pages * PAGE_SIZE);
+    std::vector<struct iovec> iov(num_pages);
+    for (int i = 0; i < num_pages; i++) {
+        iov[i] = {.iov_base = bufs.data() + i * PAGE_SIZE, .iov_len = static_cast<size_t>(PAGE_SIZE)};
+    }
+    disk_manager->read_pages(fd, 0, iov.data(), num_pages);
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        EXPECT_EQ(bufs[page_no * PAGE_SIZE], static_cast<char>(page_no & 0xff));
+        EXPECT_EQ(bufs[(page_no + 1) * PAGE_SIZE - 1], static_cast<char>(page_no & 0xff));
+    }
+
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+}
+
+TEST(DiskManagerTest, AsyncIOTest) {
+    const std::string filename = "async_io.txt";
+    constexpr int num_pages = 256;
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    disk_manager->create_file(filename);
+    int fd = disk_manager->open_file(filename);
+
+    // 两种引擎的结果应当一致，io_uring不可用时两轮都使用同步引擎
+    for (IoEngineType type : {IoEngineType::SYNC, IoEngineType::IO_URING}) {
+        disk_manager->set_io_engine(type);
+        std::vector<char> write_bufs(num_pages * PAGE_SIZE);
+        std::vector<char> read_bufs(num_pages * PAGE_SIZE);
+        std::vector<std::future<void>> pending;
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            memset(write_bufs.data() + page_no * PAGE_SIZE, (page_no + static_cast<int>(type)) & 0xff, PAGE_SIZE);
+            pending.push_back(disk_manager->async_write_page(fd, page_no, write_bufs.data() + page_no * PAGE_SIZE,
+                                                             PAGE_SIZE));
+        }
+        for (auto &io : pending) {
+            io.get();
+        }
+        pending.clear();
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            pending.push_back(
+                disk_manager->async_read_page(fd, page_no, read_bufs.data() + page_no * PAGE_SIZE, PAGE_SIZE));
+        }
+        for (auto &io : pending) {
+            io.get();
+        }
+        EXPECT_EQ(memcmp(write_bufs.data(), read_bufs.data(), write_bufs.size()), 0);
+    }
+    // 读取不存在的页面会得到短读，future中应携带异常
+    char buf[MAX_PAGE_SIZE];
+    EXPECT_THROW(disk_manager->async_read_page(fd, num_pages + 1, buf, PAGE_SIZE).get(), InternalError);
+
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+}
+
+TEST(DiskManagerTest, DirectIOTest) {
+    const std::string filename = "direct_io.txt";
+    auto direct_disk_manager = std::make_unique<DiskManager>();
+    direct_disk_manager->set_direct_io(true);
+    if (direct_disk_manager->is_file(filename)) {
+        direct_disk_manager->destroy_file(filename);
+    }
+    direct_disk_manager->create_file(filename);
+    int fd = direct_disk_manager->open_file(filename);
+
+    // 帧内存按PAGE_SIZE对齐，可以直接用于O_DIRECT读写
+    Page *page = &buffer_pool_manager->pages_[1];
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(page->get_data()) % PAGE_SIZE, 0);
+
+    // 对齐的整页写入
+    std::unique_ptr<char, decltype(&std::free)> aligned(static_cast<char *>(std::aligned_alloc(PAGE_SIZE, PAGE_SIZE)),
+                                                        &std::free);
+    memset(aligned.get(), 0x33, PAGE_SIZE);
+    direct_disk_manager->write_page(fd, 1, aligned.get(), PAGE_SIZE);
+
+    // 模拟RmFileHandle写文件头：缓冲区和长度都不对齐，且文件此时比一个页面短
+    RmFileHdr hdr = {.record_size = 13, .num_pages = 2, .num_records_per_page = 7, .first_free_page_no = 1,
+                     .bitmap_size = 1};
+    direct_disk_manager->write_page(fd, 0, reinterpret_cast<char *>(&hdr), sizeof(hdr));
+    hdr.num_pages = 3;
+    direct_disk_manager->write_page(fd, 0, reinterpret_cast<char *>(&hdr), sizeof(hdr));
+
+    RmFileHdr read_hdr;
+    direct_disk_manager->read_page(fd, 0, reinterpret_cast<char *>(&read_hdr), sizeof(read_hdr));
+    EXPECT_EQ(memcmp(&hdr, &read_hdr, sizeof(hdr)), 0);
+
+    // 文件头的read-modify-write不能破坏后面的页面，不对齐的缓冲区也能读出整页
+    std::vector<char> unaligned(PAGE_SIZE + 1);
+    direct_disk_manager->read_page(fd, 1, unaligned.data() + 1, PAGE_SIZE);
+    EXPECT_EQ(memcmp(unaligned.data() + 1, aligned.get(), PAGE_SIZE), 0);
+    memset(aligned.get(), 0, PAGE_SIZE);
+    direct_disk_manager->async_read_page(fd, 1, aligned.get(), PAGE_SIZE).get();
+    EXPECT_EQ(memcmp(unaligned.data() + 1, aligned.get(), PAGE_SIZE), 0);
+
+    direct_disk_manager->close_file(fd);
+    direct_disk_manager->destroy_file(filename);
+}
+
+TEST(DiskManagerTest, FreePageMapTest) {
+    const std::string filename = "free_page_map.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    disk_manager->create_file(filename);
+    int fd = disk_manager->open_file(filename);
+    disk_manager->set_fd2pageno(fd, 10);
+
+    // 释放的页面优先被重新分配，且从小到大分配
+    disk_manager->deallocate_page(fd, 7);
+    disk_manager->deallocate_page(fd, 3);
+    disk_manager->deallocate_page(fd, 5);
+    EXPECT_FALSE(disk_manager->is_file(filename + DiskManager::FREE_PAGE_MAP_SUFFIX));
+    EXPECT_EQ(disk_manager->allocate_page(fd), 3);
+    EXPECT_EQ(disk_manager->get_free_page_count(fd), 2);
+
+    // 空闲页表在关闭文件时写入磁盘，重新打开后继续使用
+    disk_manager->close_file(fd);
+    EXPECT_TRUE(disk_manager->is_file(filename + DiskManager::FREE_PAGE_MAP_SUFFIX));
+    fd = disk_manager->open_file(filename);
+    disk_manager->set_fd2pageno(fd, 10);
+    // 重用第一个页面时删除磁盘上的空闲页表，崩溃后剩余的空闲页面丢失，但不会被重复分配
+    EXPECT_EQ(disk_manager->allocate_page(fd), 5);
+    EXPECT_FALSE(disk_manager->is_file(filename + DiskManager::FREE_PAGE_MAP_SUFFIX));
+    EXPECT_EQ(disk_manager->allocate_page(fd), 7);
+    EXPECT_EQ(disk_manager->allocate_page(fd), 10);
+
+    disk_manager->deallocate_page(fd, 1);
+    disk_manager->close_file(fd);
+    EXPECT_TRUE(disk_manager->is_file(filename + DiskManager::FREE_PAGE_MAP_SUFFIX));
+    disk_manager->destroy_file(filename);
+    EXPECT_FALSE(disk_manager->is_file(filename + DiskManager::FREE_PAGE_MAP_SUFFIX));
+}
+
+TEST(DiskManagerTest, FileExtendTest) {
+    const std::string filename = "file_extend.txt";
+    const size_t extend_size = 16 * PAGE_SIZE;
+    auto extend_disk_manager = std::make_unique<DiskManager>();
+    extend_disk_manager->set_extend_size(extend_size);
+    if (extend_disk_manager->is_file(filename)) {
+        extend_disk_manager->destroy_file(filename);
+    }
+    extend_disk_manager->create_file(filename);
+    int fd = extend_disk_manager->open_file(filename);
+
+    // 第一次分配页面时按extend_size预分配，逻辑末尾只前进一个页面
+    EXPECT_EQ(extend_disk_manager->allocate_page(fd), 0);
+    EXPECT_EQ(extend_disk_manager->get_fd2pageno(fd), 1);
+    EXPECT_EQ(extend_disk_manager->get_file_extent(fd), extend_size);
+    EXPECT_EQ(extend_disk_manager->get_file_size(filename), extend_size);
+
+    // 预分配空间内的页面不扩展文件，且未写过的页面可以读出全0
+    for (int i = 1; i < 16; i++) {
+        EXPECT_EQ(extend_disk_manager->allocate_page(fd), i);
+    }
+    EXPECT_EQ(extend_disk_manager->get_file_size(filename), extend_size);
+    char buf[MAX_PAGE_SIZE];
+    extend_disk_manager->read_page(fd, 15, buf, PAGE_SIZE);
+    EXPECT_EQ(std::count(buf, buf + PAGE_SIZE, 0), PAGE_SIZE);
+
+    EXPECT_EQ(extend_disk_manager->allocate_page(fd), 16);
+    EXPECT_EQ(extend_disk_manager->get_file_size(filename), 2 * extend_size);
+
+    extend_disk_manager->close_file(fd);
+    extend_disk_manager->destroy_file(filename);
+}
+
+TEST(DiskManagerTest, TablespaceTest) {
+    // 表空间建在当前目录下，在独立的目录中测试
+    const std::string dir = "tablespace_test";
+    if (disk_manager->is_dir(dir)) {
+        disk_manager->destroy_dir(dir);
+    }
+    disk_manager->create_dir(dir);
+    ASSERT_EQ(chdir(dir.c_str()), 0);
+    {
+        auto ts_disk_manager = std::make_unique<DiskManager>();
+        ts_disk_manager->set_tablespace_mode(true);
+        constexpr int num_files = 4;
+        constexpr int num_pages = 300;  // 跨越多个区
+        std::vector<int> fds;
+        for (int i = 0; i < num_files; i++) {
+            std::string filename = "table" + std::to_string(i);
+            ts_disk_manager->create_file(filename);
+            EXPECT_TRUE(ts_disk_manager->is_file(filename));
+            int fd = ts_disk_manager->open_file(filename);
+            EXPECT_TRUE(DiskManager::is_virtual_fd(fd));
+            fds.push_back(fd);
+        }
+        // 各个文件交替写入，区在段文件中交错分配
+        std::vector<char> buf(PAGE_SIZE * 2);
+        for (int page_no = 0; page_no < num_pages; page_no++) {
+            for (int i = 0; i < num_files; i++) {
+                EXPECT_EQ(ts_disk_manager->allocate_page(fds[i]), page_no);
+                memset(buf.data(), i * 16 + page_no % 16, PAGE_SIZE);
+                ts_disk_manager->write_page(fds[i], page_no, buf.data(), PAGE_SIZE);
+            }
+        }
+        // 跨区的多页读取被拆分为多段
+        size_t page_size = PAGE_SIZE;
+        struct iovec iov[2] = {{buf.data(), page_size}, {buf.data() + PAGE_SIZE, page_size}};
+        page_id_t boundary = Tablespace::EXTENT_SIZE / PAGE_SIZE - 1;
+        ts_disk_manager->read_pages(fds[1], boundary, iov, 2);
+        EXPECT_EQ(buf[0], 16 + boundary % 16);
+        EXPECT_EQ(buf[PAGE_SIZE], 16 + (boundary + 1) % 16);
+        ts_disk_manager->async_read_pages(fds[2], boundary, iov, 2).get();
+        EXPECT_EQ(buf[0], 32 + boundary % 16);
+        EXPECT_EQ(buf[PAGE_SIZE], 32 + (boundary + 1) % 16);
+        // 读取尚未分配的区时报错
+        EXPECT_THROW(ts_disk_manager->read_page(fds[0], num_pages * 16, buf.data(), PAGE_SIZE), InternalError);
+
+        ts_disk_manager->deallocate_page(fds[3], 5);
+        for (int fd : fds) {
+            ts_disk_manager->close_file(fd);
+        }
+        // 删除的文件释放的区被之后创建的文件重用，不增加段文件的大小
+        off_t segment_size = disk_manager->get_file_size(TABLESPACE_SEGMENT_PREFIX + "0");
+        ts_disk_manager->destroy_file("table0");
+        EXPECT_FALSE(ts_disk_manager->is_file("table0"));
+        ts_disk_manager->create_file("table4");
+        int fd = ts_disk_manager->open_file("table4");
+        ts_disk_manager->allocate_page(fd);
+        ts_disk_manager->read_page(fd, 0, buf.data(), PAGE_SIZE);
+        EXPECT_EQ(std::count(buf.data(), buf.data() + PAGE_SIZE, 0), PAGE_SIZE);
+        ts_disk_manager->close_file(fd);
+        EXPECT_EQ(disk_manager->get_file_size(TABLESPACE_SEGMENT_PREFIX + "0"), segment_size);
+        EXPECT_EQ(ts_disk_manager->get_tablespace()->get_num_segments(), 1);
+    }
+    {
+        // 重新打开表空间，文件内容和空闲页表都被保留
+        auto ts_disk_manager = std::make_unique<DiskManager>();
+        ts_disk_manager->set_tablespace_mode(true);
+        EXPECT_FALSE(ts_disk_manager->is_file("table0"));
+        int fd = ts_disk_manager->open_file("table3");
+        char buf[MAX_PAGE_SIZE];
+        ts_disk_manager->read_page(fd, 17, buf, PAGE_SIZE);
+        EXPECT_EQ(buf[0], 48 + 1);
+        EXPECT_EQ(ts_disk_manager->allocate_page(fd), 5);
+        ts_disk_manager->close_file(fd);
+    }
+    ASSERT_EQ(chdir(".."), 0);
+    disk_manager->destroy_dir(dir);
+
+    // 表空间模式和O_DIRECT保存在db.meta中，旧版本的db.meta按独立文件模式和普通I/O打开
+    std::stringstream ss;
+    ss << DbMeta("db", DEFAULT_PAGE_SIZE, true, true);
+    DbMeta db_meta;
+    ss >> db_meta;
+    EXPECT_TRUE(db_meta.is_tablespace());
+    EXPECT_TRUE(db_meta.is_direct_io());
+    std::stringstream old_ss("db\n0\n4096\n0\n");
+    DbMeta old_db_meta;
+    old_ss >> old_db_meta;
+    EXPECT_FALSE(old_db_meta.is_tablespace());
+    EXPECT_FALSE(old_db_meta.is_direct_io());
+}
+
 // TODO: fix detected memory leaks found by Google Test
 TEST(StorageTest, SimpleTest) {
     srand((unsigned)time(nullptr));
@@ -465,7 +1636,7 @@ TEST(StorageTest, SimpleTest) {
 
     /** Test buffer_pool_manager*/
     int num_pages = 0;
-    char init_buf[PAGE_SIZE];
+    char init_buf[MAX_PAGE_SIZE];
     for (auto &fh : mock) {
         int fd = fh.first;
         for (page_id_t i = 0; i < MAX_PAGES; i++) {
@@ -567,6 +1738,303 @@ TEST(StorageTest, SimpleTest) {
     }
 }
 
+TEST(BitmapTest, WordScanTest) {
+    std::mt19937 rng(42);
+    // 覆盖不足一个字、跨字以及走AVX2路径的大小，密度从全0到全1
+    for (int max_n : {1, 7, 63, 64, 65, 200, 511, 512, 1000, 4000}) {
+        for (int density : {0, 1, 50, 99, 100}) {
+            std::vector<char> bm(Bitmap::num_bytes(max_n), 0);
+            std::vector<int> expected;
+            for (int i = 0; i < max_n; i++) {
+                if ((int)(rng() % 100) < density) {
+                    Bitmap::set(bm.data(), i);
+                    expected.push_back(i);
+                }
+            }
+            EXPECT_EQ(Bitmap::count(bm.data(), max_n), (int)expected.size());
+            std::vector<int> positions;
+            Bitmap::set_positions(bm.data(), max_n, positions);
+            EXPECT_EQ(positions, expected);
+            for (int curr = -1; curr < max_n; curr += 1 + (int)(rng() % 17)) {
+                for (bool bit : {true, false}) {
+                    int ref = curr + 1;
+                    while (ref < max_n && Bitmap::is_set(bm.data(), ref) != bit) {
+                        ref++;
+                    }
+                    EXPECT_EQ(Bitmap::next_bit(bit, bm.data(), max_n, curr), ref) << max_n << " " << curr << " " << bit;
+                }
+            }
+        }
+    }
+}
+
+TEST(RmScanTest, PageBatchTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(64, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "rm_scan_batch";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, sizeof(int));
+    auto file_handle = rm_manager->open_file(filename);
+    // 页面1、3、4存放记录，页面2为空页面
+    for (int i = 0; i < 4; i++) {
+        auto page_handle = file_handle->create_new_page_handle();
+        buffer_pool_manager->unpin_page(page_handle.page, true);
+    }
+    std::vector<std::pair<int, std::vector<int>>> expected = {{1, {0, 3, 5}}, {3, {1}}, {4, {0, 1, 2}}};
+    for (auto &[page_no, slots] : expected) {
+        for (int slot_no : slots) {
+            int val = page_no * 100 + slot_no;
+            file_handle->insert_record(Rid{page_no, slot_no}, reinterpret_cast<char *>(&val));
+        }
+    }
+
+    // 按页面批量扫描，每个页面一次取出全部记录
+    std::vector<std::pair<int, std::vector<int>>> batches;
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next_page()) {
+        for (int slot_no : scan.slots()) {
+            EXPECT_EQ(*reinterpret_cast<const int *>(scan.get_record(slot_no)), scan.page_no() * 100 + slot_no);
+        }
+        batches.emplace_back(scan.page_no(), scan.slots());
+    }
+    EXPECT_EQ(batches, expected);
+
+    // 逐条扫描基于同样的页面批次，结果不变
+    std::vector<std::pair<int, int>> rids;
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+        rids.emplace_back(scan.rid().page_no, scan.rid().slot_no);
+    }
+    std::vector<std::pair<int, int>> expected_rids = {{1, 0}, {1, 3}, {1, 5}, {3, 1}, {4, 0}, {4, 1}, {4, 2}};
+    EXPECT_EQ(rids, expected_rids);
+
+    // 扫描结束后不再持有任何页面
+    EXPECT_TRUE(buffer_pool_manager->delete_all_page(file_handle->GetFd()));
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RmFileHandleTest, FreeEmptyPageTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(64, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    Transaction txn(0);
+    Context context(lock_manager.get(), nullptr, &txn);
+
+    std::string filename = "rm_free_page";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, sizeof(int));
+    auto file_handle = rm_manager->open_file(filename);
+    int fd = file_handle->GetFd();
+    int per_page = file_handle->get_file_hdr().num_records_per_page;
+    // 页面1、2、3插满，页面4只有一条记录
+    std::vector<Rid> rids;
+    for (int i = 0; i < 3 * per_page + 1; i++) {
+        rids.push_back(file_handle->insert_record(reinterpret_cast<char *>(&i), &context));
+    }
+    EXPECT_EQ(file_handle->get_file_hdr().num_pages, 5);
+
+    // 删空的页面从空闲页面链表中摘下，交给空闲页表
+    for (int i = 0; i < 2 * per_page; i++) {
+        file_handle->delete_record(rids[i], &context);
+    }
+    EXPECT_EQ(disk_manager->get_free_page_count(fd), 2);
+    EXPECT_EQ(file_handle->get_file_hdr().first_free_page_no, 4);
+
+    // 仍被pin住的页面删空后留在链表头部
+    auto pinned = file_handle->fetch_page_handle(3);
+    for (int i = 2 * per_page; i < 3 * per_page; i++) {
+        file_handle->delete_record(rids[i], &context);
+    }
+    buffer_pool_manager->unpin_page(pinned.page, false);
+    EXPECT_EQ(disk_manager->get_free_page_count(fd), 2);
+    EXPECT_EQ(file_handle->get_file_hdr().first_free_page_no, 3);
+
+    // 扫描只返回剩下的记录，释放的页面读出为空页面
+    EXPECT_TRUE(buffer_pool_manager->delete_all_page(fd));
+    std::vector<Rid> remaining;
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+        remaining.push_back(scan.rid());
+    }
+    EXPECT_EQ(remaining, std::vector<Rid>{rids.back()});
+
+    // 之后的插入先用完链表中的页面，再重用释放的页面，文件不增长
+    for (int i = 0; i < 4 * per_page - 1; i++) {
+        Rid rid = file_handle->insert_record(reinterpret_cast<char *>(&i), &context);
+        EXPECT_NE(rid.page_no, 5);
+    }
+    EXPECT_EQ(disk_manager->get_free_page_count(fd), 0);
+    EXPECT_EQ(file_handle->get_file_hdr().num_pages, 5);
+
+    EXPECT_TRUE(buffer_pool_manager->delete_all_page(fd));
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordRefTest, PinReuseTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(64, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    auto lock_manager = std::make_unique<LockManager>();
+    Transaction txn(0);
+    Context context(lock_manager.get(), nullptr, &txn);
+
+    std::string filename = "record_ref";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, sizeof(int));
+    auto file_handle = rm_manager->open_file(filename);
+    int fd = file_handle->GetFd();
+    for (int i = 0; i < 2; i++) {
+        auto page_handle = file_handle->create_new_page_handle();
+        buffer_pool_manager->unpin_page(page_handle.page, true);
+    }
+    for (int page_no = 1; page_no <= 2; page_no++) {
+        for (int slot_no = 0; slot_no < 3; slot_no++) {
+            int val = page_no * 100 + slot_no;
+            file_handle->insert_record(Rid{page_no, slot_no}, reinterpret_cast<char *>(&val));
+        }
+    }
+
+    // 同一页面上的记录沿用第一次fetch的pin，页面只被固定一次
+    RecordRef ref;
+    file_handle->get_record_ref(Rid{1, 0}, &context, ref);
+    Page *page = ref.page();
+    ASSERT_NE(page, nullptr);
+    EXPECT_EQ(*reinterpret_cast<const int *>(ref.data()), 100);
+    for (int slot_no = 1; slot_no < 3; slot_no++) {
+        file_handle->get_record_ref(Rid{1, slot_no}, &context, ref);
+        EXPECT_EQ(ref.page(), page);
+        EXPECT_EQ(*reinterpret_cast<const int *>(ref.data()), 100 + slot_no);
+    }
+    EXPECT_FALSE(buffer_pool_manager->delete_page(PageId{fd, 1}));
+
+    // 换到另一页面时释放原页面的pin
+    file_handle->get_record_ref(Rid{2, 1}, &context, ref);
+    EXPECT_EQ(*reinterpret_cast<const int *>(ref.data()), 201);
+    EXPECT_TRUE(buffer_pool_manager->delete_page(PageId{fd, 1}));
+    EXPECT_FALSE(buffer_pool_manager->delete_page(PageId{fd, 2}));
+
+    // 移动后由新的RecordRef持有pin，复制出的记录与页面无关
+    RecordRef moved = std::move(ref);
+    EXPECT_FALSE(ref.valid());
+    auto record = moved.to_record();
+    moved.reset();
+    EXPECT_FALSE(moved.valid());
+    EXPECT_TRUE(buffer_pool_manager->delete_page(PageId{fd, 2}));
+    EXPECT_EQ(*reinterpret_cast<const int *>(record->data), 201);
+
+    EXPECT_TRUE(buffer_pool_manager->delete_all_page(fd));
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RmScanTest, SlottedPageTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(64, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // 记录为int加一个200字节的VARCHAR
+    std::string filename = "rm_slotted";
+    const int record_size = sizeof(int) + 200;
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, record_size, {RmVarCol{.offset = sizeof(int), .len = 200}});
+    auto file_handle = rm_manager->open_file(filename);
+    ASSERT_TRUE(file_handle->is_slotted());
+
+    auto make_record = [&](int id, int str_len) {
+        std::string rec(record_size, '\0');
+        memcpy(rec.data(), &id, sizeof(int));
+        for (int i = 0; i < str_len; i++) {
+            rec[sizeof(int) + i] = 'a' + (id + i) % 26;
+        }
+        return rec;
+    };
+    std::map<std::pair<int, int>, std::string> mock;
+    std::vector<Rid> rids;
+    for (int i = 0; i < 500; i++) {
+        std::string rec = make_record(i, i % 20);
+        Rid rid = file_handle->insert_record(rec.data(), nullptr);
+        mock[{rid.page_no, rid.slot_no}] = rec;
+        rids.push_back(rid);
+    }
+    // 短记录按实际长度存放，远少于定长格式需要的页面数
+    int fixed_pages = 500 / ((PAGE_SIZE - 20) * 8 / (record_size * 8 + 1)) + 1;
+    EXPECT_LT(file_handle->get_file_hdr().num_pages, fixed_pages / 3);
+
+    // 变长后在原页面放不下的记录迁移到其他页面，rid不变
+    for (int i = 0; i < 500; i += 3) {
+        std::string rec = make_record(i + 1000, 200);
+        file_handle->update_record(rids[i], rec.data(), nullptr);
+        mock[{rids[i].page_no, rids[i].slot_no}] = rec;
+    }
+    // 删除一部分记录，再在原位置插回其中一半（事务回滚的方式）
+    for (int i = 1; i < 500; i += 4) {
+        file_handle->delete_record(rids[i], nullptr);
+        EXPECT_FALSE(file_handle->is_record(rids[i]));
+        if (i % 8 == 1) {
+            mock.erase({rids[i].page_no, rids[i].slot_no});
+        } else {
+            std::string rec = make_record(i + 2000, 150);
+            file_handle->insert_record(rids[i], rec.data());
+            mock[{rids[i].page_no, rids[i].slot_no}] = rec;
+        }
+    }
+    // 已迁移的记录再次变短
+    for (int i = 0; i < 500; i += 6) {
+        std::string rec = make_record(i + 3000, 1);
+        file_handle->update_record(rids[i], rec.data(), nullptr);
+        mock[{rids[i].page_no, rids[i].slot_no}] = rec;
+    }
+
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    ASSERT_TRUE(file_handle->is_slotted());
+    std::map<std::pair<int, int>, std::string> scanned;
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next_page()) {
+        for (int slot_no : scan.slots()) {
+            scanned[{scan.page_no(), slot_no}] = std::string(scan.get_record(slot_no), record_size);
+        }
+    }
+    EXPECT_EQ(scanned.size(), mock.size());
+    EXPECT_TRUE(scanned == mock);
+    for (auto &[rid, _] : mock) {
+        EXPECT_TRUE(file_handle->is_record(Rid{rid.first, rid.second}));
+    }
+
+    EXPECT_TRUE(buffer_pool_manager->delete_all_page(file_handle->GetFd()));
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+
+    // VARCHAR标记保存在db.meta中，旧版本的db.meta中的字段按CHAR读取
+    TabMeta tab(filename);
+    tab.cols.push_back(ColMeta{.tab_name = filename, .name = "id", .type = TYPE_INT, .len = sizeof(int),
+                               .offset = 0, .index = false});
+    tab.cols.push_back(ColMeta{.tab_name = filename, .name = "str", .type = TYPE_STRING, .len = 200,
+                               .offset = sizeof(int), .index = false, .is_varchar = true});
+    std::stringstream ss;
+    ss << tab;
+    TabMeta loaded_tab;
+    ss >> loaded_tab;
+    ASSERT_EQ(loaded_tab.cols.size(), 2);
+    EXPECT_FALSE(loaded_tab.cols[0].is_varchar);
+    EXPECT_TRUE(loaded_tab.cols[1].is_varchar);
+    std::stringstream old_ss(filename + "\n1\n" + filename + " str 3 200 4 0\n0\n");
+    TabMeta old_tab;
+    old_ss >> old_tab;
+    ASSERT_EQ(old_tab.cols.size(), 1);
+    EXPECT_FALSE(old_tab.cols[0].is_varchar);
+    EXPECT_TRUE(old_tab.indexes.empty());
+}
+
 TEST(RecordManagerTest, SimpleTest) {
     srand((unsigned)time(nullptr));
 
@@ -612,7 +2080,7 @@ TEST(RecordManagerTest, SimpleTest) {
     rm_manager->create_file(filename, record_size);
     auto file_handle = rm_manager->open_file(filename);
 
-    char write_buf[PAGE_SIZE];
+    char write_buf[MAX_PAGE_SIZE];
     size_t add_cnt = 0;
     size_t upd_cnt = 0;
     size_t del_cnt = 0;